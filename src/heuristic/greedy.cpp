@@ -0,0 +1,293 @@
+#include "greedy.hpp"
+
+#define PRECISION 1e-6      // Tolerance used when comparing costs
+#define RCL_ALPHA 0.3       // Relative score tolerance defining the restricted candidate list
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Runs the heuristic. */
+bool Greedy::run(const int nbWorkers, const int nbIterations, const unsigned int seed)
+{
+    std::cout << "Running greedy start heuristic..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (nbWorkers <= 1){
+        runWorker(0, nbIterations, seed);
+    }
+    else{
+        std::vector<std::thread> workers;
+        for (int w = 0; w < nbWorkers; w++){
+            workers.push_back(std::thread(&Greedy::runWorker, this, w, nbIterations, seed));
+        }
+        for (unsigned int w = 0; w < workers.size(); w++){
+            workers[w].join();
+        }
+    }
+
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (found){
+        std::cout << "\t Greedy start found a solution of cost " << best.getCost() << " in " << time << " seconds." << std::endl;
+    }
+    else{
+        std::cout << "\t Greedy start could not find a feasible solution (" << time << " seconds)." << std::endl;
+    }
+    return found;
+}
+
+/* Performs the constructions and local searches of a single worker. */
+void Greedy::runWorker(const int worker, const int nbIterations, const unsigned int seed)
+{
+    Random rng(seed, worker);
+    Placement placement(data);
+    for (int it = 0; it < nbIterations; it++){
+        const bool RANDOMIZED = (worker > 0 || it > 0);
+        if (construct(placement, rng, RANDOMIZED)){
+            localSearch(placement, rng);
+            update(placement);
+        }
+    }
+}
+
+/* Builds a placement from scratch. */
+bool Greedy::construct(Placement& placement, Random& rng, const bool randomized) const
+{
+    placement.clear();
+
+    /* Demands requiring more capacity are placed first, unless the order is randomized. */
+    std::vector<int> order(data.getNbDemands());
+    std::iota(order.begin(), order.end(), 0);
+    if (randomized){
+        std::shuffle(order.begin(), order.end(), rng);
+    }
+    else{
+        std::vector<double> load(data.getNbDemands(), 0.0);
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                load[k] += placement.getRequiredCapacity(k, i);
+            }
+        }
+        order = getSortedIndexes_Desc(load);
+    }
+
+    bool feasible = true;
+    for (unsigned int j = 0; j < order.size() && feasible; j++){
+        feasible = constructDemand(placement, order[j], rng, randomized);
+    }
+    return feasible;
+}
+
+/* Assigns nodes to demand k until its availability requirement is met. */
+bool Greedy::constructDemand(Placement& placement, const int k, Random& rng, const bool randomized) const
+{
+    const int NB_SECTIONS = data.getDemand(k).getNbVNFs();
+    const double TARGET = std::log(data.getDemand(k).getAvailability()) / NB_SECTIONS;
+
+    while (!placement.isFeasible(k)){
+        /* Select the section furthest from its log-availability target. */
+        int section = -1;
+        double worstGap = DBL_MAX;
+        for (int i = 0; i < NB_SECTIONS; i++){
+            const double AVAIL = placement.getSectionAvailability(k, i);
+            const double GAP = (AVAIL > 0.0 ? std::log(AVAIL) : -DBL_MAX) - TARGET;
+            if (GAP < worstGap){
+                worstGap = GAP;
+                section = i;
+            }
+        }
+
+        /* Candidates are ranked by additional cost per unit of log-unavailability removed. */
+        std::vector<double> score;
+        std::vector<int> candidates;
+        for (int v = 0; v < data.getNbNodes(); v++){
+            if (!placement.canAssign(k, section, v)) continue;
+            const double GAIN = -std::log(std::max(1.0 - data.getNode(v).getAvailability(), 1e-300));
+            score.push_back((placement.getAdditionalCost(k, section, v) + PRECISION) / GAIN);
+            candidates.push_back(v);
+        }
+        if (candidates.empty()){
+            return false;
+        }
+
+        std::vector<int> rank = getSortedIndexes_Asc(score);
+        int selected = candidates[rank[0]];
+        if (randomized){
+            int rclSize = 1;
+            while (rclSize < (int)rank.size() && score[rank[rclSize]] <= score[rank[0]] * (1.0 + RCL_ALPHA)){
+                rclSize++;
+            }
+            std::uniform_int_distribution<int> pick(0, rclSize-1);
+            selected = candidates[rank[pick(rng)]];
+        }
+        placement.assign(k, section, selected);
+    }
+    return true;
+}
+
+/* Applies move, swap and merge neighborhoods until no improvement is found. */
+void Greedy::localSearch(Placement& placement, Random& rng) const
+{
+    bool improved = true;
+    while (improved){
+        improved = merge(placement, rng);
+        if (!improved) improved = move(placement, rng);
+        if (!improved) improved = swap(placement, rng);
+    }
+}
+
+/* Move: reassigns a section from one node to another, or drops a redundant assignment. */
+bool Greedy::move(Placement& placement, Random& rng) const
+{
+    std::vector< std::vector<int> > assignments;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (placement.isAssigned(k, i, v)) assignments.push_back({k, i, v});
+            }
+        }
+    }
+    std::shuffle(assignments.begin(), assignments.end(), rng);
+    std::vector<int> nodes(data.getNbNodes());
+    std::iota(nodes.begin(), nodes.end(), 0);
+
+    for (unsigned int a = 0; a < assignments.size(); a++){
+        const int k = assignments[a][0];
+        const int i = assignments[a][1];
+        const int v = assignments[a][2];
+
+        /* Drop the assignment if it is not needed. */
+        placement.unassign(k, i, v);
+        if (placement.isFeasible(k)){
+            return true;
+        }
+        placement.assign(k, i, v);
+
+        const double COST = placement.getCost();
+        std::shuffle(nodes.begin(), nodes.end(), rng);
+        for (unsigned int n = 0; n < nodes.size(); n++){
+            const int w = nodes[n];
+            if (!placement.canAssign(k, i, w)) continue;
+            placement.unassign(k, i, v);
+            placement.assign(k, i, w);
+            if (placement.getCost() < COST - PRECISION && placement.isFeasible(k)){
+                return true;
+            }
+            placement.unassign(k, i, w);
+            placement.assign(k, i, v);
+        }
+    }
+    return false;
+}
+
+/* Swap: exchanges the nodes of two assignments from different sections. */
+bool Greedy::swap(Placement& placement, Random& rng) const
+{
+    std::vector< std::vector<int> > assignments;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (placement.isAssigned(k, i, v)) assignments.push_back({k, i, v});
+            }
+        }
+    }
+    std::shuffle(assignments.begin(), assignments.end(), rng);
+
+    const double COST = placement.getCost();
+    for (unsigned int a = 0; a < assignments.size(); a++){
+        const int k1 = assignments[a][0];
+        const int i1 = assignments[a][1];
+        const int v1 = assignments[a][2];
+        for (unsigned int b = a+1; b < assignments.size(); b++){
+            const int k2 = assignments[b][0];
+            const int i2 = assignments[b][1];
+            const int v2 = assignments[b][2];
+            if (v1 == v2 || (k1 == k2 && i1 == i2)) continue;
+            if (placement.isAssigned(k1, i1, v2) || placement.isAssigned(k2, i2, v1)) continue;
+
+            placement.unassign(k1, i1, v1);
+            placement.unassign(k2, i2, v2);
+            const bool SWAPPED = (placement.assign(k1, i1, v2) && placement.assign(k2, i2, v1));
+            if (SWAPPED && placement.getCost() < COST - PRECISION && placement.isFeasible(k1) && placement.isFeasible(k2)){
+                return true;
+            }
+            placement.unassign(k1, i1, v2);
+            placement.unassign(k2, i2, v1);
+            placement.assign(k1, i1, v1);
+            placement.assign(k2, i2, v2);
+        }
+    }
+    return false;
+}
+
+/* Merge: relocates every section using a VNF instance to other instances of the same VNF, closing it. */
+bool Greedy::merge(Placement& placement, Random& rng) const
+{
+    std::vector< std::pair<int,int> > instances;
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            if (placement.isPlaced(v, f)) instances.push_back(std::make_pair(v, f));
+        }
+    }
+    std::shuffle(instances.begin(), instances.end(), rng);
+
+    for (unsigned int j = 0; j < instances.size(); j++){
+        const int v = instances[j].first;
+        const int f = instances[j].second;
+        Placement backup(placement);
+
+        /* Remove every section using the instance, grouped by demand. */
+        std::map<int, std::vector<int> > users;
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                if (data.getDemand(k).getVNF_i(i) == f && placement.isAssigned(k, i, v)){
+                    users[k].push_back(i);
+                    placement.unassign(k, i, v);
+                }
+            }
+        }
+
+        /* Reassign them to the most available nodes already hosting the vnf, least available section first. */
+        bool relocated = true;
+        for (std::map<int, std::vector<int> >::const_iterator it = users.begin(); it != users.end() && relocated; ++it){
+            const int k = it->first;
+            while (relocated && !placement.isFeasible(k)){
+                int section = -1;
+                int selected = -1;
+                for (unsigned int u = 0; u < it->second.size(); u++){
+                    const int i = it->second[u];
+                    if (section != -1 && placement.getSectionAvailability(k, i) >= placement.getSectionAvailability(k, section)) continue;
+                    int best = -1;
+                    for (int w = 0; w < data.getNbNodes(); w++){
+                        if (w == v || !placement.isPlaced(w, f) || !placement.canAssign(k, i, w)) continue;
+                        if (best == -1 || data.getNode(w).getAvailability() > data.getNode(best).getAvailability()){
+                            best = w;
+                        }
+                    }
+                    if (best != -1){
+                        section = i;
+                        selected = best;
+                    }
+                }
+                relocated = (selected != -1 && placement.assign(k, section, selected));
+            }
+        }
+
+        if (relocated && placement.getCost() < backup.getCost() - PRECISION){
+            return true;
+        }
+        placement = backup;
+    }
+    return false;
+}
+
+/* Stores a placement if it is feasible and cheaper than the best one. */
+void Greedy::update(const Placement& placement)
+{
+    if (!placement.isFeasible()) return;
+    std::lock_guard<std::mutex> lock(best_flag);
+    if (!found || placement.getCost() < best.getCost() - PRECISION){
+        best = placement;
+        found = true;
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef __greedy__hpp
+#define __greedy__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <thread>
+#include <mutex>
+#include <random>
+#include <chrono>
+#include <map>
+
+/*** Own Libraries ***/
+#include "placement.hpp"
+#include "../tools/others.hpp"
+#include "../tools/random.hpp"
+
+
+/************************************************************************************
+ * This class implements a multi-start construction heuristic for the resilient
+ * VNF placement problem. Each worker thread repeatedly builds a randomized
+ * greedy placement, driven by log-availability targets, and improves it by
+ * local search (move, swap and merge of VNF instances). The best placement
+ * found by all workers is kept. It does not depend on any MIP solver.
+ ************************************************************************************/
+class Greedy {
+
+private:
+    const Data&     data;           /**< Data read in data.hpp **/
+    Placement       best;           /**< The best placement found. **/
+    bool            found;          /**< True if a feasible placement was found. **/
+    std::mutex      best_flag;      /**< A mutex protecting the best placement. **/
+    double          time;           /**< Time spent by the heuristic. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param data_ The instance data. **/
+    Greedy(const Data& data_) : data(data_), best(data_), found(false), time(0.0) {}
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the best placement found. **/
+    const Placement&    getBest()   const { return best; }
+    /** Returns true if a feasible placement was found. **/
+    const bool&         hasFound()  const { return found; }
+    /** Returns the time spent by the heuristic in seconds. **/
+    const double&       getTime()   const { return time; }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Runs the heuristic. @param nbWorkers The number of threads. @param nbIterations The number of constructions performed by each thread. @param seed The run seed; each worker draws from its own stream. Returns true if a feasible placement was found. **/
+    bool run(const int nbWorkers, const int nbIterations, const unsigned int seed);
+
+    /** Assigns nodes to demand k until its availability requirement is met, always extending the section furthest from its log-availability target. **/
+    bool constructDemand(Placement& placement, const int k, Random& rng, const bool randomized) const;
+
+    /** Applies move, swap and merge neighborhoods until no improvement is found. **/
+    void localSearch(Placement& placement, Random& rng) const;
+
+private:
+    /** Performs the constructions and local searches of a single worker. **/
+    void runWorker(const int worker, const int nbIterations, const unsigned int seed);
+
+    /** Builds a placement from scratch. The first construction of worker 0 is deterministic; the others pick among the best candidates at random. Returns true if every demand is feasible. **/
+    bool construct(Placement& placement, Random& rng, const bool randomized) const;
+
+    /** Move: reassigns a section from one node to another. Returns true if the placement was improved. **/
+    bool move(Placement& placement, Random& rng) const;
+
+    /** Swap: exchanges the nodes of two assignments from different sections. Returns true if the placement was improved. **/
+    bool swap(Placement& placement, Random& rng) const;
+
+    /** Merge: relocates every section using a VNF instance to other instances of the same VNF, closing it. Returns true if the placement was improved. **/
+    bool merge(Placement& placement, Random& rng) const;
+
+    /** Stores a placement if it is feasible and cheaper than the best one. **/
+    void update(const Placement& placement);
+};
+
+#endif
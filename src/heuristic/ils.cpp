@@ -0,0 +1,191 @@
+#include "ils.hpp"
+
+#define PRECISION       1e-6    // Tolerance used when comparing costs
+#define DESTROY_RATIO   0.1     // Fraction of the demands rebuilt by a perturbation
+#define RESTART         50      // Number of iterations without improvement before a worker restarts from the best placement
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Runs the greedy heuristic, then the iterated local search from its best placement. */
+bool IteratedLocalSearch::run()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                Running iterated local search.                 -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+        std::cout << "WARNING: The heuristic does not model routing. Latency constraints are ignored." << std::endl;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (!greedy.run(data.getInput().getGreedyStartWorkers(), data.getInput().getGreedyStartIterations(), data.getInput().getRandomSeed())){
+        time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return false;
+    }
+    update(greedy.getBest());
+
+    const int NB_WORKERS = std::max(1, data.getInput().getIlsWorkers());
+    const double TIME_LIMIT = data.getInput().getTimeLimit() - greedy.getTime();
+    if (NB_WORKERS == 1){
+        runWorker(0, data.getInput().getIlsIterations(), TIME_LIMIT);
+    }
+    else{
+        std::vector<std::thread> workers;
+        for (int w = 0; w < NB_WORKERS; w++){
+            workers.push_back(std::thread(&IteratedLocalSearch::runWorker, this, w, data.getInput().getIlsIterations(), TIME_LIMIT));
+        }
+        for (unsigned int w = 0; w < workers.size(); w++){
+            workers[w].join();
+        }
+    }
+
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\t Iterated local search found a solution of cost " << best.getCost() << " in " << time << " seconds." << std::endl;
+    return found;
+}
+
+/* Performs the iterations of a single worker. */
+void IteratedLocalSearch::runWorker(const int worker, const int nbWorkerIterations, const double timeLimit)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    /* Streams 0 to greedy_start_workers-1 are used by the greedy heuristic. */
+    Random rng(data.getInput().getRandomSeed(), data.getInput().getGreedyStartWorkers() + worker);
+    Placement current(data);
+    Placement candidate(data);
+    {
+        std::lock_guard<std::mutex> lock(best_flag);
+        current = best;
+    }
+
+    int nbStalls = 0;
+    int it = 0;
+    for (; it < nbWorkerIterations; it++){
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > timeLimit) break;
+        candidate = current;
+        if (!perturb(candidate, rng)) continue;
+        greedy.localSearch(candidate, rng);
+        if (!candidate.isFeasible()) continue;
+
+        /* Moves to placements that are not worse; restarts from the best one when stalled. */
+        if (candidate.getCost() <= current.getCost() + PRECISION){
+            nbStalls = (candidate.getCost() < current.getCost() - PRECISION ? 0 : nbStalls + 1);
+            current = candidate;
+            update(current);
+        }
+        else{
+            nbStalls++;
+        }
+        if (nbStalls >= RESTART){
+            std::lock_guard<std::mutex> lock(best_flag);
+            current = best;
+            nbStalls = 0;
+        }
+    }
+    std::lock_guard<std::mutex> lock(best_flag);
+    nbIterations += it;
+}
+
+/* Destroys and rebuilds the assignment of a few random demands. */
+bool IteratedLocalSearch::perturb(Placement& placement, Random& rng) const
+{
+    std::vector<int> order(data.getNbDemands());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    const int NB_DESTROYED = std::max(1, (int)std::ceil(DESTROY_RATIO * data.getNbDemands()));
+    order.resize(std::min(NB_DESTROYED, data.getNbDemands()));
+
+    for (unsigned int j = 0; j < order.size(); j++){
+        placement.clear(order[j]);
+    }
+    for (unsigned int j = 0; j < order.size(); j++){
+        if (!greedy.constructDemand(placement, order[j], rng, true)){
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Stores a placement if it is feasible and cheaper than the best one. */
+bool IteratedLocalSearch::update(const Placement& placement)
+{
+    if (!placement.isFeasible()) return false;
+    std::lock_guard<std::mutex> lock(best_flag);
+    if (!found || placement.getCost() < best.getCost() - PRECISION){
+        best = placement;
+        found = true;
+        return true;
+    }
+    return false;
+}
+
+/****************************************************************************************/
+/*									Solution Query  									*/
+/****************************************************************************************/
+
+/* Displays the obtained results. */
+void IteratedLocalSearch::printResult()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                 Printing best solution found.                 -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    if (found){
+        best.print();
+    }
+    else{
+        std::cout << "No feasible placement was found." << std::endl;
+    }
+    std::cout << std::endl << "Printing optimization informations..."                   << std::endl;
+    std::cout << "\t Objective value:           " << (found ? best.getCost() : 0.0)     << std::endl;
+    std::cout << "\t Greedy time:               " << greedy.getTime()                   << std::endl;
+    std::cout << "\t Iterations:                " << nbIterations                       << std::endl;
+    std::cout << "\t Total time:                " << time << std::endl                  << std::endl;
+}
+
+/* Outputs the obtained results, in the same format as Model::output. */
+void IteratedLocalSearch::output()
+{
+    /* The heuristic gives no lower bound. */
+    int nbViolations = 0;
+    double maxViolation = 0.0;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        const double VIOLATION = data.getDemand(k).getAvailability() - best.getChainAvailability(k);
+        if (VIOLATION > 1e-12){
+            nbViolations++;
+            maxViolation = std::max(maxViolation, VIOLATION);
+        }
+    }
+    Results results(data, "heuristic");
+    results.add("relax_type",       std::string("HEURISTIC"),               true);
+    results.add("time",             time,                                   true);
+    results.add("objective",        (found ? best.getCost() : 0.0),         true);
+    results.add("best_bound",       0.0,                                    true);
+    results.add("gap",              100.0,                                  true);
+    results.add("nodes",            0,                                      true);
+    results.add("nodes_left",       0,                                      true);
+    results.add("lazy_constraints", 0,                                      true);
+    results.add("user_cuts",        0,                                      true);
+    results.add("callback_time",    0.0,                                    true);
+    results.add("nb_avail_violations", (found ? nbViolations : data.getNbDemands()), true);
+    results.add("max_avail_violation", maxViolation,                        true);
+    results.add("build_time",       0.0);
+    results.add("iterations",       nbIterations);
+    results.add("columns",          0);
+    results.add("cuts_per_family",  std::map<std::string, int>());
+    results.add("lifted_cuts",      0);
+    results.add("exact_rejections", 0);
+    results.write();
+}
+
+/* Writes the best placement found to the solution file. */
+void IteratedLocalSearch::exportSolution()
+{
+    const std::string solution_file = data.getInput().getSolutionFile();
+    if (solution_file.empty() || !found){
+        return;
+    }
+    std::cout << "Writting solution to file..." << std::endl;
+    best.write(solution_file);
+}
@@ -0,0 +1,80 @@
+#ifndef __ils__hpp
+#define __ils__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <fstream>
+
+/*** Own Libraries ***/
+#include "greedy.hpp"
+#include "../tools/results.hpp"
+
+
+/************************************************************************************
+ * This class implements an iterated local search for the resilient VNF
+ * placement problem. It starts from the placement of the greedy heuristic;
+ * each worker thread then repeatedly destroys the assignment of a few random
+ * demands, rebuilds them with the randomized greedy construction and applies
+ * the local search of the greedy heuristic. Availability is always evaluated
+ * exactly. Together with the greedy heuristic, it gives a solver path which
+ * does not depend on CPLEX (solver=heuristic).
+ ************************************************************************************/
+class IteratedLocalSearch {
+
+private:
+    const Data&     data;           /**< Data read in data.hpp **/
+    Greedy          greedy;         /**< Provides the construction and the local search. **/
+    Placement       best;           /**< The best placement found. **/
+    bool            found;          /**< True if a feasible placement was found. **/
+    std::mutex      best_flag;      /**< A mutex protecting the best placement. **/
+    int             nbIterations;   /**< Number of iterations performed by all workers. **/
+    double          time;           /**< Time spent by the heuristic. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param data_ The instance data. **/
+    IteratedLocalSearch(const Data& data_) : data(data_), greedy(data_), best(data_), found(false), nbIterations(0), time(0.0) {}
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the best placement found. **/
+    const Placement&    getBest()   const { return best; }
+    /** Returns true if a feasible placement was found. **/
+    const bool&         hasFound()  const { return found; }
+    /** Returns the time spent by the heuristic in seconds. **/
+    const double&       getTime()   const { return time; }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Runs the greedy heuristic, then the iterated local search from its best placement until the iteration or time limit is reached. Returns true if a feasible placement was found. **/
+    bool run();
+
+	/****************************************************************************************/
+	/*									Solution Query  									*/
+	/****************************************************************************************/
+    /** Displays the obtained results. **/
+    void printResult();
+    /** Outputs the obtained results, in the same format as Model::output. **/
+    void output();
+    /** Writes the best placement found to the solution file. **/
+    void exportSolution();
+
+private:
+    /** Performs the iterations of a single worker. @param worker The worker id. @param nbWorkerIterations The number of iterations of the worker. @param timeLimit The time limit in seconds. **/
+    void runWorker(const int worker, const int nbWorkerIterations, const double timeLimit);
+
+    /** Destroys and rebuilds the assignment of a few random demands. Returns false if a demand could not be rebuilt. **/
+    bool perturb(Placement& placement, Random& rng) const;
+
+    /** Stores a placement if it is feasible and cheaper than the best one. Returns true if it was stored. **/
+    bool update(const Placement& placement);
+};
+
+#endif
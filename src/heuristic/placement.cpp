@@ -0,0 +1,309 @@
+#include "placement.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/** Constructor. Builds an empty placement. **/
+Placement::Placement(const Data& data_) : data(data_), cost(0.0)
+{
+    y.resize(data.getNbNodes(), std::vector<int>(data.getNbVnfs(), 0));
+    usage.resize(data.getNbNodes(), std::vector<int>(data.getNbVnfs(), 0));
+    x.resize(data.getNbDemands());
+    for (int k = 0; k < data.getNbDemands(); k++){
+        x[k].resize(data.getDemand(k).getNbVNFs(), std::vector<int>(data.getNbNodes(), 0));
+    }
+    remainingCapacity.resize(data.getNbNodes());
+    for (int v = 0; v < data.getNbNodes(); v++){
+        remainingCapacity[v] = data.getNode(v).getCapacity();
+    }
+    modified.resize(data.getNbDemands(), true);
+}
+
+/** Copy assignment. **/
+Placement& Placement::operator=(const Placement& other)
+{
+    y                   = other.y;
+    x                   = other.x;
+    usage               = other.usage;
+    remainingCapacity   = other.remainingCapacity;
+    modified            = other.modified;
+    cost                = other.cost;
+    return *this;
+}
+
+/****************************************************************************************/
+/*										Getters 										*/
+/****************************************************************************************/
+
+/* Returns the capacity consumed by the i-th vnf of demand k. */
+const double Placement::getRequiredCapacity(const int k, const int i) const
+{
+    const int f = data.getDemand(k).getVNF_i(i);
+    return data.getDemand(k).getBandwidth() * data.getVnf(f).getConsumption();
+}
+
+/* Returns the additional cost of assigning the i-th vnf of demand k to node v. */
+const double Placement::getAdditionalCost(const int k, const int i, const int v) const
+{
+    const int f = data.getDemand(k).getVNF_i(i);
+    if (y[v][f] == 1) return 0.0;
+    return data.getPlacementCost(data.getNode(v), data.getVnf(f));
+}
+
+/* Returns true if the i-th vnf of demand k can be assigned to node v without violating its capacity. */
+const bool Placement::canAssign(const int k, const int i, const int v) const
+{
+    return (x[k][i][v] == 0 && getRequiredCapacity(k, i) <= remainingCapacity[v] + 1e-6);
+}
+
+/* Returns the availability of the i-th section of demand k. */
+const double Placement::getSectionAvailability(const int k, const int i) const
+{
+    double failure_prob = 1.0;
+    for (int v = 0; v < data.getNbNodes(); v++){
+        if (x[k][i][v] == 1){
+            failure_prob *= (1.0 - data.getNode(v).getAvailability());
+        }
+    }
+    return (1.0 - failure_prob);
+}
+
+/* Returns the availability of demand k and its least available section. */
+const double Placement::getChainAvailability(const int k, int& leastAvailableSection) const
+{
+    double availability     = 1.0;
+    double minSectionAvail  = 2.0;
+    leastAvailableSection   = -1;
+    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+        double section_avail = getSectionAvailability(k, i);
+        if (section_avail < minSectionAvail){
+            minSectionAvail = section_avail;
+            leastAvailableSection = i;
+        }
+        availability *= section_avail;
+    }
+    return availability;
+}
+
+/* Returns the availability of demand k. */
+const double Placement::getChainAvailability(const int k) const
+{
+    int least = -1;
+    return getChainAvailability(k, least);
+}
+
+/* Returns the number of nodes assigned to the i-th section of demand k. */
+const int Placement::getNbAssigned(const int k, const int i) const
+{
+    return (int)std::count(x[k][i].begin(), x[k][i].end(), 1);
+}
+
+/* Returns true if every section of demand k is assigned and its availability requirement is met. */
+const bool Placement::isFeasible(const int k) const
+{
+    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+        if (getNbAssigned(k, i) == 0) return false;
+    }
+    return (getChainAvailability(k) >= data.getDemand(k).getAvailability());
+}
+
+/* Returns true if every demand is feasible. */
+const bool Placement::isFeasible() const
+{
+    for (int k = 0; k < data.getNbDemands(); k++){
+        if (!isFeasible(k)) return false;
+    }
+    return true;
+}
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Assigns the i-th vnf of demand k to node v, placing the vnf if needed. */
+bool Placement::assign(const int k, const int i, const int v)
+{
+    if (!canAssign(k, i, v)) return false;
+    const int f = data.getDemand(k).getVNF_i(i);
+    x[k][i][v] = 1;
+    remainingCapacity[v] -= getRequiredCapacity(k, i);
+    if (y[v][f] == 0){
+        y[v][f] = 1;
+        cost += data.getPlacementCost(data.getNode(v), data.getVnf(f));
+    }
+    usage[v][f]++;
+    return true;
+}
+
+/* Removes the assignment of the i-th vnf of demand k from node v. */
+void Placement::unassign(const int k, const int i, const int v)
+{
+    if (x[k][i][v] == 0) return;
+    const int f = data.getDemand(k).getVNF_i(i);
+    x[k][i][v] = 0;
+    remainingCapacity[v] += getRequiredCapacity(k, i);
+    usage[v][f]--;
+    if (usage[v][f] == 0){
+        y[v][f] = 0;
+        cost -= data.getPlacementCost(data.getNode(v), data.getVnf(f));
+    }
+}
+
+/* Removes every assignment of demand k. */
+void Placement::clear(const int k)
+{
+    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+        for (int v = 0; v < data.getNbNodes(); v++){
+            unassign(k, i, v);
+        }
+    }
+    modified[k] = true;
+}
+
+/* Removes every assignment. */
+void Placement::clear()
+{
+    for (int k = 0; k < data.getNbDemands(); k++){
+        clear(k);
+    }
+}
+
+/* Greedily assigns new nodes to demand k until its availability requirement is met. */
+bool Placement::complete(const int k)
+{
+    const double PRECISION = 1e-6;
+    const double REQ_AVAIL = data.getDemand(k).getAvailability();
+    int i = -1;
+    while (getChainAvailability(k, i) < REQ_AVAIL){
+        /* Choose the cheapest node for the least available section, then the most available one, then the less loaded one. */
+        int selectedNode = -1;
+        for (int v = 0; v < data.getNbNodes(); v++){
+            if (!canAssign(k, i, v)) continue;
+            if (selectedNode == -1){
+                selectedNode = v;
+                continue;
+            }
+            const double COST       = getAdditionalCost(k, i, v);
+            const double BEST_COST  = getAdditionalCost(k, i, selectedNode);
+            if (COST < BEST_COST - PRECISION){
+                selectedNode = v;
+            }
+            else if (COST <= BEST_COST + PRECISION){
+                const double AVAIL      = data.getNode(v).getAvailability();
+                const double BEST_AVAIL = data.getNode(selectedNode).getAvailability();
+                if (AVAIL > BEST_AVAIL + PRECISION || (AVAIL >= BEST_AVAIL - PRECISION && remainingCapacity[v] > remainingCapacity[selectedNode])){
+                    selectedNode = v;
+                }
+            }
+        }
+        if (selectedNode == -1) return false;
+        assign(k, i, selectedNode);
+        modified[k] = true;
+    }
+    return true;
+}
+
+/* Completes every demand. */
+bool Placement::repair()
+{
+    bool feasible = true;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        if (!complete(k)){
+            feasible = false;
+        }
+    }
+    return feasible;
+}
+
+/****************************************************************************************/
+/*									    Input/Output									*/
+/****************************************************************************************/
+
+/* Reads a placement written by method write. */
+int Placement::read(const std::string filename)
+{
+    std::cout << "\t Reading " << filename << " ..."  << std::endl;
+    Reader reader(filename);
+    std::vector<std::vector<std::string> > dataList = reader.getData();
+
+    clear();
+    std::vector<bool> found(data.getNbDemands(), false);
+    std::vector<bool> dropped(data.getNbDemands(), false);
+    int nbRead = 0;
+    int nbDropped = 0;
+    for (unsigned int l = 0; l < dataList.size(); l++){
+        /* Only assignment lines are used: placements are derived from them. */
+        if (dataList[l].size() != 5 || dataList[l][0] != "x"){
+            continue;
+        }
+        const int k = data.getIdFromDemandName(dataList[l][1]);
+        if (k == -1){
+            nbDropped++;
+            continue;
+        }
+        found[k] = true;
+        /* The section index has at most as many digits as the number of sections. */
+        const std::string& SECTION = dataList[l][2];
+        if (SECTION.empty() || SECTION.size() > std::to_string(data.getDemand(k).getNbVNFs()).size() || SECTION.find_first_not_of("0123456789") != std::string::npos){
+            std::cout << "WARNING: Invalid section index '" << SECTION << "' for demand " << dataList[l][1] << " in " << filename << ". Line is skipped." << std::endl;
+            dropped[k] = true;
+            nbDropped++;
+            continue;
+        }
+        const int i = std::stoi(SECTION);
+        bool valid = (i >= 0 && i < data.getDemand(k).getNbVNFs());
+        valid = valid && data.hasVnf(dataList[l][3]) && data.hasNode(dataList[l][4]);
+        valid = valid && (data.getIdFromVnfName(dataList[l][3]) == data.getDemand(k).getVNF_i(i));
+        if (valid && assign(k, i, data.getIdFromNodeName(dataList[l][4]))){
+            nbRead++;
+        }
+        else{
+            dropped[k] = true;
+            nbDropped++;
+        }
+    }
+    for (int k = 0; k < data.getNbDemands(); k++){
+        modified[k] = (!found[k] || dropped[k]);
+    }
+    std::cout << "\t " << nbRead << " assignments read, " << nbDropped << " dropped." << std::endl;
+    return nbRead;
+}
+
+/* Writes the placement. */
+void Placement::write(const std::string filename) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write solution file '" << filename << "'." << std::endl;
+        return;
+    }
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            if (y[v][f] == 1){
+                file << "y;" << data.getNode(v).getName() << ";" << data.getVnf(f).getName() << std::endl;
+            }
+        }
+    }
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            const int f = data.getDemand(k).getVNF_i(i);
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (x[k][i][v] == 1){
+                    file << "x;" << data.getDemand(k).getName() << ";" << i << ";" << data.getVnf(f).getName() << ";" << data.getNode(v).getName() << std::endl;
+                }
+            }
+        }
+    }
+    file.close();
+}
+
+/* Displays a summary of the placement. */
+void Placement::print() const
+{
+    int nbFeasible = 0;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        if (isFeasible(k)) nbFeasible++;
+    }
+    std::cout << "\t Placement cost: " << cost << ", feasible demands: " << nbFeasible << "/" << data.getNbDemands() << std::endl;
+}
@@ -0,0 +1,106 @@
+#ifndef __placement__hpp
+#define __placement__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <iomanip>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class stores a VNF placement and assignment solution independently of
+ * any MIP solver. It keeps track of the remaining capacity of each node and of
+ * the placement cost, and can be read from (or written to) a file in which
+ * demands, nodes and vnfs are identified by their names.
+ ************************************************************************************/
+class Placement {
+
+private:
+    const Data&                                     data;               /**< Data read in data.hpp **/
+    std::vector< std::vector<int> >                 y;                  /**< VNF placement. y[v][f] **/
+    std::vector< std::vector< std::vector<int> > >  x;                  /**< VNF assignment. x[k][i][v] **/
+    std::vector< std::vector<int> >                 usage;              /**< Number of sections using each placement. usage[v][f] **/
+    std::vector<double>                             remainingCapacity;  /**< Remaining capacity of each node. **/
+    std::vector<bool>                               modified;           /**< States whether the assignment of each demand was changed after being read. **/
+    double                                          cost;               /**< The placement cost. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Builds an empty placement. @param data_ The instance data. **/
+    Placement(const Data& data_);
+
+    /** Copy assignment. @note Both placements must refer to the same data. **/
+    Placement& operator=(const Placement& other);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the placement cost. **/
+    const double&   getCost                 ()                          const { return cost; }
+    /** Returns true if vnf f is placed on node v. **/
+    const bool      isPlaced                (const int v, const int f)  const { return (y[v][f] == 1); }
+    /** Returns true if the i-th vnf of demand k is assigned to node v. **/
+    const bool      isAssigned              (const int k, const int i, const int v) const { return (x[k][i][v] == 1); }
+    /** Returns the remaining capacity of node v. **/
+    const double&   getRemainingCapacity    (const int v)               const { return remainingCapacity[v]; }
+    /** Returns true if the assignment of demand k was changed after being read from file. **/
+    const bool      isModified              (const int k)               const { return modified[k]; }
+
+    /** Returns the capacity consumed by the i-th vnf of demand k. **/
+    const double    getRequiredCapacity     (const int k, const int i)  const;
+    /** Returns the additional cost of assigning the i-th vnf of demand k to node v. **/
+    const double    getAdditionalCost       (const int k, const int i, const int v) const;
+    /** Returns true if the i-th vnf of demand k can be assigned to node v without violating its capacity. **/
+    const bool      canAssign               (const int k, const int i, const int v) const;
+
+    /** Returns the availability of the i-th section of demand k. **/
+    const double    getSectionAvailability  (const int k, const int i)  const;
+    /** Returns the availability of demand k. @param leastAvailableSection Stores the index of the least available section. **/
+    const double    getChainAvailability    (const int k, int& leastAvailableSection) const;
+    /** Returns the availability of demand k. **/
+    const double    getChainAvailability    (const int k)               const;
+    /** Returns the number of nodes assigned to the i-th section of demand k. **/
+    const int       getNbAssigned           (const int k, const int i)  const;
+
+    /** Returns true if every section of demand k is assigned and its availability requirement is met. **/
+    const bool      isFeasible              (const int k)               const;
+    /** Returns true if every demand is feasible. **/
+    const bool      isFeasible              ()                          const;
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Assigns the i-th vnf of demand k to node v, placing the vnf if needed. Returns false if node capacity is not enough. **/
+    bool assign     (const int k, const int i, const int v);
+    /** Removes the assignment of the i-th vnf of demand k from node v. The vnf is removed from the node if no other section uses it. **/
+    void unassign   (const int k, const int i, const int v);
+    /** Removes every assignment of demand k. **/
+    void clear      (const int k);
+    /** Removes every assignment. **/
+    void clear      ();
+
+    /** Greedily assigns new nodes to demand k until its availability requirement is met. Returns false if it cannot be done. **/
+    bool complete   (const int k);
+    /** Completes every demand. Returns true if the resulting placement is feasible. **/
+    bool repair     ();
+
+	/****************************************************************************************/
+	/*									    Input/Output									*/
+	/****************************************************************************************/
+    /** Reads a placement written by method write. Assignments of unknown demands, nodes or vnfs, or which would violate node capacities, are dropped. Returns the number of assignments read. @param filename The file to be read. **/
+    int  read   (const std::string filename);
+    /** Writes the placement. Each line is either 'y;node;vnf' or 'x;demand;section;vnf;node'. @param filename The file to be written. **/
+    void write  (const std::string filename) const;
+
+    /** Displays a summary of the placement. **/
+    void print  () const;
+};
+
+#endif
@@ -5,12 +5,13 @@
 /****************************************************************************************/
 
 /** Constructor. **/
-Data::Data(const std::string &parameter_file) : params(parameter_file)
+Data::Data(const std::string &parameter_file) : params(parameter_file), profiler(params.isProfile())
 {
 	std::cout << std::endl;
     std::cout << "=================================================================" << std::endl;
     std::cout << "-                Building input data structures.                -" << std::endl;
     std::cout << "=================================================================" << std::endl;
+	Profiler::Phase phase(profiler, "Data");
 	readNodeFile(params.getNodeFile());
 	readLinkFile(params.getLinkFile());
 	readVnfFile(params.getVnfFile());
@@ -22,6 +23,20 @@ Data::Data(const std::string &parameter_file) : params(parameter_file)
 	
 }
 
+/** Constructor reusing the instance read by another Data. **/
+Data::Data(const Input &params_, const Data &instance) : params(params_), profiler(params_.isProfile()), tabNodes(instance.tabNodes), tabLinks(instance.tabLinks),
+			tabVnfs(instance.tabVnfs), tabDemands(instance.tabDemands), hashNode(instance.hashNode), hashVnf(instance.hashVnf),
+			hashDemand(instance.hashDemand)
+{
+	{
+		Profiler::Phase phase(profiler, "Data");
+		buildGraph();
+		buildNodeRank();
+	}
+	/* The files were read once, by the shared instance: its reading phases are reported along with ours. */
+	profiler.merge(instance.profiler);
+}
+
 /****************************************************************************************/
 /*										Getters 										*/
 /****************************************************************************************/
@@ -33,11 +48,8 @@ int Data::getIdFromNodeName(const std::string name) const
         return search->second;
     } 
 	else {
-        std::cerr << "ERROR: Could not find a node with name '"<< name << "'... Abort." << std::endl;
-		exit(EXIT_FAILURE);
+		throw std::runtime_error("ERROR: Could not find a node with name '" + name + "'... Abort.");
     }
-	int invalid = -1;
-	return invalid;
 }
 /* Returns the id from the vnf with the given name. */
 int Data::getIdFromVnfName(const std::string name) const
@@ -48,9 +60,16 @@ int Data::getIdFromVnfName(const std::string name) const
 		}
     }
     
-	std::cerr << "ERROR: Could not find a vnf with name '"<< name << "'... Abort." << std::endl;
-	exit(EXIT_FAILURE);
-    
+	throw std::runtime_error("ERROR: Could not find a vnf with name '" + name + "'... Abort.");
+}
+
+/* Returns the id from the demand with the given name. */
+int Data::getIdFromDemandName(const std::string name) const
+{
+	auto search = hashDemand.find(name);
+    if (search != hashDemand.end()) {
+        return search->second;
+    } 
 	return -1;
 }
 
@@ -81,9 +100,9 @@ const double Data::getChainAvailability (const std::vector<double>& sectionAvail
 /* Reads the node file and fills the set of nodes. */
 void Data::readNodeFile(const std::string filename)
 {
+	Profiler::Phase phase(profiler, "readNodeFile");
     if (filename.empty()){
-		std::cerr << "ERROR: A node file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
+		throw std::runtime_error("ERROR: A node file MUST be declared in the parameters file.");
 	}
     std::cout << "\t Reading " << filename << " ..."  << std::endl;
 	Reader reader(filename);
@@ -108,9 +127,9 @@ void Data::readNodeFile(const std::string filename)
 /* Reads the link file and fills the set of links. */
 void Data::readLinkFile(const std::string filename)
 {
+	Profiler::Phase phase(profiler, "readLinkFile");
     if (filename.empty()){
-		std::cerr << "ERROR: A link file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
+		throw std::runtime_error("ERROR: A link file MUST be declared in the parameters file.");
 	}
     std::cout << "\t Reading " << filename << " ..."  << std::endl;
 	Reader reader(filename);
@@ -134,9 +153,9 @@ void Data::readLinkFile(const std::string filename)
 /* Reads the vnf file and fills the set of vnfs. */
 void Data::readVnfFile(const std::string filename)
 {
+	Profiler::Phase phase(profiler, "readVnfFile");
     if (filename.empty()){
-		std::cerr << "ERROR: A vnf file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
+		throw std::runtime_error("ERROR: A vnf file MUST be declared in the parameters file.");
 	}
     std::cout << "\t Reading " << filename << " ..."  << std::endl;
 	Reader reader(filename);
@@ -156,9 +175,9 @@ void Data::readVnfFile(const std::string filename)
 /** Reads the demand file and fills the set of demands. @param filename The demand file to be read. **/
 void Data::readDemandFile(const std::string filename)
 {
+	Profiler::Phase phase(profiler, "readDemandFile");
     if (filename.empty()){
-		std::cerr << "ERROR: A demand file MUST be declared in the parameters file.\n";
-		exit(EXIT_FAILURE);
+		throw std::runtime_error("ERROR: A demand file MUST be declared in the parameters file.");
 	}
     std::cout << "\t Reading " << filename << " ..."  << std::endl;
 	Reader reader(filename);
@@ -175,6 +194,7 @@ void Data::readDemandFile(const std::string filename)
 		double band = atof(dataList[i][4].c_str());
 		double availability = atof(dataList[i][5].c_str());
 		this->tabDemands.push_back(Demand(demandId, demandName, source, target, latency, band, availability));
+		hashDemand.insert({demandName, demandId});
 		std::vector<std::string> list = split(dataList[i][6], ",");
 		for (unsigned int j = 0; j < list.size(); j++){
 			if (!list[j].empty()){
@@ -190,6 +210,7 @@ void Data::readDemandFile(const std::string filename)
 /* Builds the availability ranking of nodes. */
 void Data::buildNodeRank()
 {
+	Profiler::Phase phase(profiler, "buildNodeRank");
 	availNodeRank.resize(tabNodes.size());
 	for (unsigned int i = 0; i < availNodeRank.size(); i++){
 		availNodeRank[i] = i;
@@ -211,12 +232,18 @@ void Data::buildNodeRank()
 		availNodeRank[min] = availNodeRank[i];  
 		availNodeRank[i] = temp;  
     }  
+
+	nodeRankPosition.assign(tabNodes.size(), -1);
+	for (unsigned int i = 0; i < availNodeRank.size(); i++){
+		nodeRankPosition[availNodeRank[i]] = i;
+	}
 	//printNodeRank();
 }
 
 /* Builds the network graph from data stored in tabNodes and tabLinks. */
 void Data::buildGraph()
 {
+	Profiler::Phase phase(profiler, "buildGraph");
 	
 	std::cout << "\t Creating graph..." << std::endl;
 	/* Dymanic allocation of graph */
@@ -258,10 +285,8 @@ void Data::buildGraph()
 /* Returns the node position on availability ranking. */
 const int Data::getNodeRankPosition (int id) const
 {
-	for (unsigned int i = 0; i < availNodeRank.size(); i++){
-		if (availNodeRank[i] == id)	return i;
-	}
-	return -1;
+	if (id < 0 || id >= (int)nodeRankPosition.size()) return -1;
+	return nodeRankPosition[id];
 }
 
 /* Returns the minimum number of nodes with availability at most B required to ensure a given availability level. */
@@ -304,6 +329,38 @@ const double Data::getParallelAvailability(const std::vector<int>& nodes) const
 	return (val);
 }
 
+/* Returns the shortest delay from (or to) a given node to every node. */
+const std::vector<double> Data::getShortestDelays(const int source, const bool reverse) const
+{
+	std::vector<double> delay(getNbNodes(), DBL_MAX);
+	std::vector< std::vector< std::pair<int, double> > > adjacency(getNbNodes());
+	for (unsigned int a = 0; a < getLinks().size(); a++){
+		const Link& link = getLink(a);
+		if (link.getSource() < 0 || link.getSource() >= getNbNodes() || link.getTarget() < 0 || link.getTarget() >= getNbNodes()) continue;
+		if (reverse) adjacency[link.getTarget()].push_back(std::make_pair(link.getSource(), link.getDelay()));
+		else         adjacency[link.getSource()].push_back(std::make_pair(link.getTarget(), link.getDelay()));
+	}
+
+	typedef std::pair<double, int> Label;
+	std::priority_queue<Label, std::vector<Label>, std::greater<Label> > queue;
+	delay[source] = 0.0;
+	queue.push(std::make_pair(0.0, source));
+	while (!queue.empty()){
+		const Label label = queue.top();
+		queue.pop();
+		if (label.first > delay[label.second]) continue;
+		for (unsigned int j = 0; j < adjacency[label.second].size(); j++){
+			const int next = adjacency[label.second][j].first;
+			const double DELAY = label.first + adjacency[label.second][j].second;
+			if (DELAY < delay[next]){
+				delay[next] = DELAY;
+				queue.push(std::make_pair(DELAY, next));
+			}
+		}
+	}
+	return delay;
+}
+
 /* Returns a vector containing the ids of the n most available nodes. */
 const std::vector<int> Data::getNMostAvailableNodes(int n) const
 {
@@ -467,6 +524,7 @@ Data::~Data()
     this->tabLinks.clear();
     this->tabNodes.clear();
 	this->hashNode.clear();
+	this->hashDemand.clear();
 	this->tabDemands.clear();
 	this->tabVnfs.clear();
 	delete nodeId;
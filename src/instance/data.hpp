@@ -10,6 +10,8 @@
 #include <float.h>
 #include <unordered_map>
 #include <algorithm>
+#include <queue>
+#include <functional>
 #include <cmath>
 
 /*** LEMON Libraries ***/     
@@ -22,6 +24,7 @@
 #include "../network/link.hpp"
 #include "../network/vnf.hpp"
 #include "../tools/reader.hpp"
+#include "../tools/profiler.hpp"
 
 
 /****************************************************************************************/
@@ -51,6 +54,7 @@ class Data {
 
 private:
 	Input 				params;						/**< Input parameters. **/
+	mutable Profiler	profiler;					/**< Time and memory spent by each phase of the run. **/
     std::vector<Node> 	tabNodes;         			/**< Set of nodes. **/
 	std::vector<Link> 	tabLinks;					/**< Set of links. **/
 	std::vector<VNF> 	tabVnfs;					/**< Set of VNFs. **/
@@ -64,8 +68,10 @@ private:
 
 	std::unordered_map<std::string, int> hashNode; 	/**< A map for locating node id's from its name. **/
 	std::unordered_map<std::string, int> hashVnf; 	/**< A map for locating vnf id's from its name. **/
+	std::unordered_map<std::string, int> hashDemand;/**< A map for locating demand id's from its name. **/
 
 	std::vector<int>	availNodeRank;				/**< A vector containing the ids of nodes in decreasing order of availability. **/
+	std::vector<int>	nodeRankPosition;			/**< The position of each node in availNodeRank. **/
 	
 public:
 
@@ -76,6 +82,13 @@ public:
 	/** Constructor initializes the object with the information of an Input. @param parameter_file The parameters file.**/
 	Data(const std::string &parameter_file);
 
+	/** Constructor reusing the network, vnfs and demands already read by another Data. The graph is rebuilt so that both objects may be used concurrently. @param params_ The input parameters. @param instance A Data read from the same instance files. **/
+	Data(const Input &params_, const Data &instance);
+
+	/** Data owns its graph and cannot be copied. **/
+	Data(const Data&) = delete;
+	Data& operator=(const Data&) = delete;
+
 
 
 	/****************************************************************************************/
@@ -83,6 +96,7 @@ public:
 	/****************************************************************************************/
 
 	const Input& 			 	getInput 		 () const { return params; }		/**< Returns a reference to the data's Input. */
+	Profiler& 			 		getProfiler 	 () const { return profiler; }		/**< Returns the profiler recording the phases of the run. */
 	const Graph& 			 	getGraph     	 () const { return *graph; }		/**< Returns a reference to the data's Graph. */
 	const NodeMap& 			 	getNodeIds   	 () const { return *nodeId; }		/**< Returns a reference to the map storing the nodes' ids. */
 	const NodeMap& 			 	getLemonNodeIds  () const { return *lemonNodeId; }	/**< Returns a reference to the map storing the nodes' lemon ids. */
@@ -113,6 +127,15 @@ public:
 	/** Returns the id from the vnf with the given name. @param name The vnf name. **/
 	int	 	   getIdFromVnfName(const std::string name) const;
 
+	/** Returns true if there is a node with the given name. @param name The node name. **/
+	bool 	   hasNode(const std::string name) const { return (hashNode.find(name) != hashNode.end()); }
+
+	/** Returns true if there is a vnf with the given name. @param name The vnf name. **/
+	bool 	   hasVnf(const std::string name) const { return (hashVnf.find(name) != hashVnf.end()); }
+
+	/** Returns the id from the demand with the given name. @param name The demand name. @note Returns -1 if there is no such demand. **/
+	int	 	   getIdFromDemandName(const std::string name) const;
+
     /** Returns the probability that a set of nodes fail simoustaneously. @param nodes The set of nodes to fail. **/
     const double getFailureProb(const std::vector<int>& nodes) const;
     
@@ -131,6 +154,9 @@ public:
 	/** Returns the availability obtained from the placement of a set of nodes in parallel. @param nodes The set of nodes**/
 	const double getParallelAvailability (const std::vector<int>& nodes) const;
 
+	/** Returns the shortest delay from a given node to every node, or to the given node from every node if reverse is true. @param source The node id. @param reverse True if delays to the node are required. @note Unreachable nodes get DBL_MAX. **/
+	const std::vector<double> getShortestDelays(const int source, const bool reverse = false) const;
+
 	/** Returns a vector containing the ids of the n most available nodes. @param n The number of nodes to be returned. **/
 	const std::vector<int> getNMostAvailableNodes(int n) const;
 	
@@ -18,20 +18,53 @@ Input::Input(const std::string filename) : parameters_file(filename){
 
     disaggregated_vnf_placement = (Disaggregated_VNF_Placement_Constraints)std::stoi(getParameterValue("disaggregated_VNF_Placement="));
     strong_node_capacity        = (Strong_Node_Capacity_Constraints)std::stoi(getParameterValue("strong_node_capacity="));
+    availability_cuts           = (Availability_Usercuts)getIntParameterValue("availability_cuts=", 0);
     node_cover                  = (Node_Cover_Cuts)std::stoi(getParameterValue("node_cover="));
     chain_cover                 = (Chain_Cover_Cuts)std::stoi(getParameterValue("chain_cover="));
     vnf_lower_bound             = (VNF_Lower_Bound_Cuts)std::stoi(getParameterValue("vnf_lower_bound="));
     section_failure_cuts        = (Section_Failure_Cuts)std::stoi(getParameterValue("section_failure="));
     routing_activation          = (Routing)std::stoi(getParameterValue("routing="));
     approx_type                 = (Approximation_Type)std::stoi(getParameterValue("availability_approx="));
+    pwl_encoding                = (Pwl_Encoding)getIntParameterValue("pwl_encoding=", 0);
+    symmetry_breaking           = (Symmetry_Breaking)getIntParameterValue("symmetry_breaking=", 0);
+    solver                      = getSolverParameterValue("solver=");
     lazy                        = (Lazy_Constraints)std::stoi(getParameterValue("lazy="));
     heuristic_activation        = (Heuristic)std::stoi(getParameterValue("heuristic="));
 
     linear_relaxation           = std::stoi(getParameterValue("linearRelaxation="));
     time_limit                  = std::stoi(getParameterValue("timeLimit="));
     nb_breakpoints              = std::stoi(getParameterValue("nb_breakpoints="));
+    nb_lifting_variants         = getIntParameterValue("lifting_variants=", 1);
+    greedy_start                = getIntParameterValue("greedy_start=", 0);
+    greedy_start_workers        = getIntParameterValue("greedy_start_workers=", 1);
+    greedy_start_iterations     = getIntParameterValue("greedy_start_iterations=", 10);
+    random_seed                 = getIntParameterValue("random_seed=", 20102019);
+    adaptive_breakpoints        = getIntParameterValue("adaptive_breakpoints=", 0);
+    exact_check                 = getIntParameterValue("exact_check=", 0);
+    presolve                    = getIntParameterValue("presolve=", 0);
+    benders                     = getIntParameterValue("benders=", 0);
+    benders_workers             = getIntParameterValue("benders_workers=", 1);
+    colgen_max_iterations       = getIntParameterValue("colgen_max_iterations=", 100);
+    pricing_grid                = getIntParameterValue("pricing_grid=", 200);
+    lagrangian_max_iterations   = getIntParameterValue("lagrangian_max_iterations=", 200);
+    lagrangian_workers          = getIntParameterValue("lagrangian_workers=", 1);
+    ils_workers                 = getIntParameterValue("ils_workers=", 1);
+    ils_iterations              = getIntParameterValue("ils_iterations=", 1000);
+    adaptive_tolerance          = getDoubleParameterValue("adaptive_tolerance=", 1e-6);
+    adaptive_max_iterations     = getIntParameterValue("adaptive_max_iterations=", 10);
+    threads                     = getIntParameterValue("threads=", 1);
+    backend                     = getParameterValue("backend=");
+    if (backend.empty()){
+        backend = "cplex";
+    }
 
     output_file                 = getParameterValue("outputFile=");
+    output_format               = (Output_Format)getIntParameterValue("output_format=", 0);
+    profile                     = getIntParameterValue("profile=", 0);
+    cut_cache_file              = getParameterValue("cutCacheFile=");
+    warm_start_file             = getParameterValue("warmStartFile=");
+    solution_file               = getParameterValue("solutionFile=");
+    separation_profile_file     = getParameterValue("separationProfileFile=");
 
     print();
 }
@@ -57,13 +90,41 @@ std::string Input::getParameterValue(std::string pattern){
         param_file.close();
     }
     else {
-        std::cerr << "ERROR: Unable to open parameters file '" << parameters_file << "'." << std::endl; 
-        exit(EXIT_FAILURE);
+        throw std::runtime_error("ERROR: Unable to open parameters file '" + parameters_file + "'.");
     }
     std::cout << "WARNING: Did not found field '" << pattern << "' inside parameters file." << std::endl; 
     return value;
 }
 
+/* Returns the integer pattern value in the parameters file. */
+int Input::getIntParameterValue(const std::string pattern, const int defaultValue){
+    std::string value = getParameterValue(pattern);
+    if (value.empty()){
+        return defaultValue;
+    }
+    return std::stoi(value);
+}
+
+/* Returns the real pattern value in the parameters file. */
+double Input::getDoubleParameterValue(const std::string pattern, const double defaultValue){
+    std::string value = getParameterValue(pattern);
+    if (value.empty()){
+        return defaultValue;
+    }
+    return std::stod(value);
+}
+
+/* Returns the solver in the parameters file. */
+Input::Solver Input::getSolverParameterValue(const std::string pattern){
+    std::string value = getParameterValue(pattern);
+    if (value.empty() || value == "mip")    return SOLVER_MIP;
+    if (value == "colgen")                  return SOLVER_COLGEN;
+    if (value == "lagrangian")              return SOLVER_LAGRANGIAN;
+    if (value == "heuristic")               return SOLVER_HEURISTIC;
+    if (value == "compact")                 return SOLVER_COMPACT;
+    return (Solver)std::stoi(value);
+}
+
 /** Print the info stored in the parameter file. */
 void Input::print(){
     std::cout << "\t Node File:                     " << node_file    << std::endl;
@@ -71,17 +132,36 @@ void Input::print(){
     std::cout << "\t Service Chain Function File:   " << demand_file  << std::endl;
     std::cout << "\t Virtual Network Function File: " << vnf_file     << std::endl;
     std::cout << "\t Output File:                   " << output_file  << std::endl;
+    std::cout << "\t Output Format:                 " << output_format << std::endl;
+    std::cout << "\t Profile:                       " << profile << std::endl;
+    std::cout << "\t Cut Cache File:                " << cut_cache_file << std::endl;
+    std::cout << "\t Warm Start File:               " << warm_start_file << std::endl;
+    std::cout << "\t Solution File:                 " << solution_file << std::endl;
+    std::cout << "\t Separation Profile File:       " << separation_profile_file << std::endl;
     std::cout << "\t Linear Relaxation:             ";
     if (linear_relaxation)  std::cout << "TRUE" << std::endl;
     else                    std::cout << "FALSE" << std::endl;
     
     std::cout << "\t Time Limit:                    " << time_limit   << " seconds"   << std::endl;
+    std::cout << "\t Random Seed:                   " << random_seed  << std::endl;
     std::cout << std::endl;
 
     std::cout << "\t Lazy Constraints:        " << lazy                         << std::endl;
     std::cout << "\t Heuristics:              " << heuristic_activation         << std::endl;
     std::cout << "\t Disaggregated placement: " << disaggregated_vnf_placement  << std::endl;
     std::cout << "\t Strong capacity:         " << strong_node_capacity         << std::endl;
+    std::cout << "\t Availability cuts:       " << availability_cuts            << std::endl;
     std::cout << "\t Node cover:              " << node_cover                   << std::endl;
     std::cout << "\t Chain cover:             " << chain_cover                  << std::endl;
+    std::cout << "\t Lifting variants:        " << nb_lifting_variants          << std::endl;
+    std::cout << "\t Greedy start:            " << greedy_start                 << std::endl;
+    std::cout << "\t Adaptive breakpoints:    " << adaptive_breakpoints         << std::endl;
+    std::cout << "\t PWL encoding:            " << pwl_encoding                 << std::endl;
+    std::cout << "\t Exact check:             " << exact_check                  << std::endl;
+    std::cout << "\t Symmetry breaking:       " << symmetry_breaking            << std::endl;
+    std::cout << "\t Presolve:                " << presolve                     << std::endl;
+    std::cout << "\t Benders:                 " << benders                      << std::endl;
+    std::cout << "\t Solver:                  " << solver                       << std::endl;
+    std::cout << "\t Backend:                 " << backend                      << std::endl;
+    std::cout << "\t Threads:                 " << threads                      << std::endl;
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <stdexcept>
 
 
 /*****************************************************************************************
@@ -59,7 +60,28 @@ public:
 	enum Approximation_Type {
 		APPROXIMATION_TYPE_RESTRICTION  = -1,
 		APPROXIMATION_TYPE_NONE			= 0,  		
-		APPROXIMATION_TYPE_RELAXATION   = 1 	        
+		APPROXIMATION_TYPE_RELAXATION   = 1,
+		APPROXIMATION_TYPE_OUTER        = 2 	/**< Tangent cuts on log(secAvail) and log(secUnavail) separated on demand. **/
+	};
+	/** States how piecewise linear approximations are encoded.**/
+	enum Pwl_Encoding {
+		PWL_ENCODING_CPLEX          = 0,    /**< IloPiecewiseLinear, encoded by CPLEX. **/
+		PWL_ENCODING_SOS2           = 1,    /**< Convex combination of vertices with an SOS2 constraint. **/
+		PWL_ENCODING_LOGARITHMIC    = 2     /**< Convex combination of vertices with a logarithmic number of binaries (Vielma-Nemhauser). **/
+	};
+	/** States which symmetries are broken by ordering constraints.**/
+	enum Symmetry_Breaking {
+		SYMMETRY_BREAKING_OFF       = 0,    /**< No ordering constraint. **/
+		SYMMETRY_BREAKING_DEMANDS   = 1,    /**< Equivalent demands are ordered. **/
+		SYMMETRY_BREAKING_SECTIONS  = 2     /**< Equivalent demands and interchangeable sections are ordered. **/
+	};
+	/** States which solver is used.**/
+	enum Solver {
+		SOLVER_MIP      = 0,    /**< The compact MIP formulation solved by branch-and-cut. **/
+		SOLVER_COLGEN   = 1,    /**< Column generation over per-SFC placement patterns. **/
+		SOLVER_LAGRANGIAN = 2,  /**< Lagrangian relaxation of node capacities and linking constraints. **/
+		SOLVER_HEURISTIC  = 3,  /**< Greedy construction and iterated local search, without CPLEX. **/
+		SOLVER_COMPACT    = 4   /**< The placement formulation solved through the MIP backend given by backend=. **/
 	};
 	/** States wheter lazy constraints are activated.**/
 	enum Lazy_Constraints {
@@ -71,6 +93,12 @@ public:
 		HEURISTIC_OFF = 0,  		
 		HEURISTIC_ON  = 1 	        
 	};
+	/** States how results are written to the output file.**/
+	enum Output_Format {
+		OUTPUT_FORMAT_LEGACY    = 0,    /**< Semicolon row without header. **/
+		OUTPUT_FORMAT_CSV       = 1,    /**< Comma separated values, with a header written when the file is created. **/
+		OUTPUT_FORMAT_JSONL     = 2     /**< One JSON object per line. **/
+	};
 
 private:
     /***** Input file paths *****/
@@ -90,6 +118,9 @@ private:
     Section_Failure_Cuts					section_failure_cuts; 			/**< Refers to the activation of section failure cuts. **/
     Routing									routing_activation; 			/**< Refers to the activation of routing decisions. **/
 	Approximation_Type                      approx_type;                    /**< Refers to the type of approximation used for modeling availability constraints. **/
+	Pwl_Encoding                            pwl_encoding;                   /**< Refers to the encoding of piecewise linear approximations. **/
+	Symmetry_Breaking                       symmetry_breaking;              /**< Refers to the symmetries broken by ordering constraints. **/
+	Solver                                  solver;                         /**< Refers to the solver used. **/
 	Lazy_Constraints 						lazy; 							/**< Refers to the activation of lazy constraints. **/
 	Heuristic								heuristic_activation;			/**< Refers to the activation of heuristics. **/
 
@@ -97,10 +128,36 @@ private:
     bool                linear_relaxation;
     int                 time_limit;
     int                 nb_breakpoints;
+    int                 nb_lifting_variants;
+    int                 greedy_start;
+    int                 greedy_start_workers;
+    int                 greedy_start_iterations;
+    int                 random_seed;
+    int                 adaptive_breakpoints;
+    int                 exact_check;
+    int                 presolve;
+    int                 benders;
+    int                 benders_workers;
+    int                 colgen_max_iterations;
+    int                 pricing_grid;
+    int                 lagrangian_max_iterations;
+    int                 lagrangian_workers;
+    int                 ils_workers;
+    int                 ils_iterations;
+    double              adaptive_tolerance;
+    int                 adaptive_max_iterations;
+    std::string         backend;
+    int                 threads;
 
 
     /***** Output file paths *****/
     std::string         output_file;
+    Output_Format       output_format;
+    int                 profile;
+    std::string         cut_cache_file;
+    std::string         warm_start_file;
+    std::string         solution_file;
+    std::string         separation_profile_file;
     
 public:
 	/****************************************************************************************/
@@ -149,6 +206,11 @@ public:
     const Routing &                    				getRoutingActivation()         	const { return routing_activation; }
 	/** Returns the type of availability approximation to be used. **/ 
     const Approximation_Type &                      getApproximationType()         	const { return approx_type; }
+	/** Returns the encoding of piecewise linear approximations. **/ 
+    const Pwl_Encoding &                            getPwlEncoding()                const { return pwl_encoding; }
+	/** Returns which symmetries are broken by ordering constraints. **/
+    const Symmetry_Breaking &                       getSymmetryBreaking()           const { return symmetry_breaking; }
+    const Solver &                                  getSolver()                     const { return solver; }
 	/** Returns whether lazy constraints are activated **/ 
     const Lazy_Constraints &                      	getLazy()         				const { return lazy; }
 	/** Returns whether heuristics are used. **/ 
@@ -164,15 +226,102 @@ public:
     /** Returns the number of breakpoints to be used in the log approximation. */
     const int&         getNbBreakpoints() const { return this->nb_breakpoints; }
 
+    /** Returns the number of lifted variants generated for each violated availability constraint. */
+    const int&         getNbLiftingVariants() const { return this->nb_lifting_variants; }
+
+    /** Returns true if the greedy start heuristic is to be run before the optimization. */
+    const bool         isGreedyStart()    const { return (this->greedy_start == 1); }
+
+    /** Returns the number of threads used by the greedy start heuristic. */
+    const int&         getGreedyStartWorkers() const { return this->greedy_start_workers; }
+
+    /** Returns the number of constructions performed by each thread of the greedy start heuristic. */
+    const int&         getGreedyStartIterations() const { return this->greedy_start_iterations; }
+
+    /** Returns true if every candidate solution is to be checked against the exact chain availability, whatever the approximation used. */
+    const bool         isExactCheck()     const { return (this->exact_check == 1); }
+
+    /** Returns true if the data presolve is to be run before the model is built. */
+    const bool         isPresolve()       const { return (this->presolve == 1); }
+
+    /** Returns true if routing is to be checked by Benders subproblems instead of being modeled. @note Only used when routing is activated. */
+    const bool         isBenders()        const { return (this->benders == 1 && this->routing_activation == ROUTING_ON); }
+
+    /** Returns the number of threads solving the Benders subproblems. */
+    const int&         getBendersWorkers() const { return this->benders_workers; }
+
+    /** Returns the maximum number of column generation iterations. */
+    const int&         getColgenMaxIterations() const { return this->colgen_max_iterations; }
+
+    /** Returns the number of units into which the log(SLA) budget is divided by the column generation pricing. */
+    const int&         getPricingGrid()   const { return this->pricing_grid; }
+
+    /** Returns the maximum number of subgradient iterations of the Lagrangian relaxation. */
+    const int&         getLagrangianMaxIterations() const { return this->lagrangian_max_iterations; }
+
+    /** Returns the number of threads solving the Lagrangian subproblems. */
+    const int&         getLagrangianWorkers() const { return this->lagrangian_workers; }
+
+    /** Returns the number of threads of the iterated local search. */
+    const int&         getIlsWorkers()    const { return this->ils_workers; }
+
+    /** Returns the number of iterations performed by each thread of the iterated local search. */
+    const int&         getIlsIterations() const { return this->ils_iterations; }
+
+    /** Returns the number of threads the MIP solver may use. The branch-and-cut of Model always uses one thread. */
+    const int&         getThreads()       const { return this->threads; }
+
+    /** Returns the name of the MIP solver used by the compact solver (cplex or highs). */
+    const std::string& getBackend()       const { return this->backend; }
+
+    /** Returns true if breakpoints are to be refined iteratively until availability violation falls below the tolerance. */
+    const bool         isAdaptiveBreakpoints() const { return (this->adaptive_breakpoints == 1); }
+
+    /** Returns the maximum availability violation accepted by the adaptive breakpoint refinement. */
+    const double&      getAdaptiveTolerance()  const { return this->adaptive_tolerance; }
+
+    /** Returns the maximum number of solves performed by the adaptive breakpoint refinement. */
+    const int&         getAdaptiveMaxIterations() const { return this->adaptive_max_iterations; }
+
+    /** Returns the seed from which every random number generator is initialized. */
+    const int&         getRandomSeed()    const { return this->random_seed; }
+
     /** Returns the output file. */
     const std::string& getOutputFile()     const { return this->output_file; }
 
+    /** Returns the format in which results are written to the output file. */
+    const Output_Format& getOutputFormat() const { return this->output_format; }
+
+    /** Returns true if the time and memory of each phase are to be recorded and reported. */
+    const bool         isProfile()        const { return (this->profile == 1); }
+
+    /** Returns the cut cache file, from which cuts are preloaded and to which generated cuts are saved. */
+    const std::string& getCutCacheFile()   const { return this->cut_cache_file; }
+
+    /** Returns the warm start file, from which a solution is read and given to the solver as a MIP start. */
+    const std::string& getWarmStartFile()  const { return this->warm_start_file; }
+
+    /** Returns the solution file, to which the best solution found is written. */
+    const std::string& getSolutionFile()   const { return this->solution_file; }
+
+    /** Returns the file to which the per-routine separation profile is written. Routines are only measured if it is set. */
+    const std::string& getSeparationProfileFile() const { return this->separation_profile_file; }
+
 	/****************************************************************************************/
 	/*				    					Methods	    									*/
 	/****************************************************************************************/
     /** Returns the pattern value in the parameters file. */
     std::string getParameterValue(const std::string pattern);
 
+    /** Returns the integer pattern value in the parameters file. @param pattern The pattern to look for. @param defaultValue The value returned if the field is empty or missing. */
+    int getIntParameterValue(const std::string pattern, const int defaultValue);
+
+    /** Returns the real pattern value in the parameters file. @param pattern The pattern to look for. @param defaultValue The value returned if the field is empty or missing. */
+    double getDoubleParameterValue(const std::string pattern, const double defaultValue);
+
+    /** Returns the solver in the parameters file, given either by its name (mip, colgen, lagrangian, heuristic, compact) or by its number. @param pattern The pattern to look for. */
+    Solver getSolverParameterValue(const std::string pattern);
+
 	/****************************************************************************************/
 	/*				    					Display	    									*/
 	/****************************************************************************************/
@@ -0,0 +1,190 @@
+#include "presolve.hpp"
+
+#define PRECISION 1e-9      // Tolerance used when comparing capacities and delays
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Every variable is kept until run is called. */
+Presolve::Presolve(const Data& data_) : data(data_), nbCapacityFixings(0), nbLatencyFixings(0), 
+                                        nbDominatedFixings(0), nbPlacementFixings(0), nbTightenedSections(0), infeasible(false)
+{
+    assignable.resize(data.getNbDemands());
+    minNbNodes.resize(data.getNbDemands());
+    for (int k = 0; k < data.getNbDemands(); k++){
+        assignable[k].resize(data.getDemand(k).getNbVNFs(), std::vector<bool>(data.getNbNodes(), true));
+        int minNb = data.getMinNbNodes(data.getDemand(k).getAvailability());
+        if (minNb == -1){
+            std::cout << "WARNING: Demand " << data.getDemand(k).getName() << " cannot reach the availability required." << std::endl;
+            infeasible = true;
+            minNb = data.getNbNodes();
+        }
+        minNbNodes[k].resize(data.getDemand(k).getNbVNFs(), minNb);
+    }
+    placeable.resize(data.getNbNodes(), std::vector<bool>(data.getNbVnfs(), true));
+}
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Computes the fixings and the minimum number of nodes of each section. */
+void Presolve::run()
+{
+    std::cout << "Running presolve... " << std::endl;
+    fixByCapacity();
+    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+        fixByLatency();
+    }
+    fixDominated();
+    fixPlacements();
+    computeMinNbNodes();
+    print();
+}
+
+/* Fixes the assignments to nodes without enough capacity to process the section. */
+void Presolve::fixByCapacity()
+{
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            const double LOAD = data.getDemand(k).getBandwidth() * data.getVnf(data.getDemand(k).getVNF_i(i)).getConsumption();
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (assignable[k][i][v] && LOAD > data.getNode(v).getCapacity() + PRECISION){
+                    assignable[k][i][v] = false;
+                    nbCapacityFixings++;
+                }
+            }
+        }
+    }
+}
+
+/* Fixes the assignments to nodes that cannot be visited within the maximum latency of the demand. */
+void Presolve::fixByLatency()
+{
+    /* Every assigned node is linked to every node of the next section, so the chain goes through each of them. */
+    std::map<int, std::vector<double> > fromSource;
+    std::map<int, std::vector<double> > toTarget;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        const int SOURCE = data.getDemand(k).getSource();
+        const int TARGET = data.getDemand(k).getTarget();
+        if (fromSource.find(SOURCE) == fromSource.end()) fromSource[SOURCE] = data.getShortestDelays(SOURCE, false);
+        if (toTarget.find(TARGET) == toTarget.end())     toTarget[TARGET]   = data.getShortestDelays(TARGET, true);
+        for (int v = 0; v < data.getNbNodes(); v++){
+            const double DELAY = fromSource[SOURCE][v] + toTarget[TARGET][v];
+            if (DELAY <= data.getDemand(k).getMaxLatency() + PRECISION) continue;
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                if (assignable[k][i][v]){
+                    assignable[k][i][v] = false;
+                    nbLatencyFixings++;
+                }
+            }
+        }
+    }
+}
+
+/* Fixes the assignments to nodes with null availability. */
+void Presolve::fixDominated()
+{
+    for (int v = 0; v < data.getNbNodes(); v++){
+        if (data.getNode(v).getAvailability() > 0.0) continue;
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                if (assignable[k][i][v]){
+                    assignable[k][i][v] = false;
+                    nbDominatedFixings++;
+                }
+            }
+        }
+    }
+}
+
+/* Fixes the placements that cannot be used by any section. */
+void Presolve::fixPlacements()
+{
+    for (int v = 0; v < data.getNbNodes(); v++){
+        std::vector<bool> used(data.getNbVnfs(), false);
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                if (assignable[k][i][v]) used[data.getDemand(k).getVNF_i(i)] = true;
+            }
+        }
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            if (placeable[v][f] && !used[f]){
+                placeable[v][f] = false;
+                nbPlacementFixings++;
+            }
+        }
+    }
+}
+
+/* Computes the minimum number of nodes of each section from the remaining nodes. */
+void Presolve::computeMinNbNodes()
+{
+    for (int k = 0; k < data.getNbDemands(); k++){
+        const int NB_SECTIONS = data.getDemand(k).getNbVNFs();
+        std::vector<double> maxAvail(NB_SECTIONS);
+        for (int i = 0; i < NB_SECTIONS; i++){
+            maxAvail[i] = getMaxSectionAvailability(k, i);
+        }
+        for (int i = 0; i < NB_SECTIONS; i++){
+            /* The other sections bring at most their maximum availability to the chain. */
+            double others = 1.0;
+            for (int j = 0; j < NB_SECTIONS; j++){
+                if (j != i) others *= maxAvail[j];
+            }
+            const double TARGET = (others > 0.0 ? data.getDemand(k).getAvailability() / others : 2.0);
+
+            /* Most available remaining nodes first. */
+            double failProb = 1.0;
+            int nb = 0;
+            for (unsigned int r = 0; r < data.getAvailNodeRank().size() && 1.0 - failProb < TARGET - PRECISION; r++){
+                const int v = data.getAvailNodeRank()[r];
+                if (!assignable[k][i][v]) continue;
+                failProb *= (1.0 - data.getNode(v).getAvailability());
+                nb++;
+            }
+            /* Every remaining node was taken: the bound stays valid, but the instance is infeasible. */
+            if (1.0 - failProb < TARGET - PRECISION){
+                std::cout << "WARNING: Section " << i << " of demand " << data.getDemand(k).getName() << " cannot reach the availability required." << std::endl;
+                infeasible = true;
+            }
+            else if (nb > minNbNodes[k][i]){
+                nbTightenedSections++;
+            }
+            minNbNodes[k][i] = nb;
+        }
+    }
+}
+
+/* Returns the availability of a section using every node it can be assigned to. */
+double Presolve::getMaxSectionAvailability(const int k, const int i) const
+{
+    std::vector<int> nodes;
+    for (int v = 0; v < data.getNbNodes(); v++){
+        if (assignable[k][i][v]) nodes.push_back(v);
+    }
+    return data.getParallelAvailability(nodes);
+}
+
+/****************************************************************************************/
+/*										Display 										*/
+/****************************************************************************************/
+
+/* Displays the reductions performed. */
+void Presolve::print() const
+{
+    int nbUnusedNodes = 0;
+    for (int v = 0; v < data.getNbNodes(); v++){
+        bool unused = true;
+        for (int f = 0; f < data.getNbVnfs() && unused; f++){
+            unused = !placeable[v][f];
+        }
+        if (unused) nbUnusedNodes++;
+    }
+    std::cout << "\t > Presolve removed " << getNbAssignmentFixings() << " assignment variables (capacity: " << nbCapacityFixings
+              << ", latency: " << nbLatencyFixings << ", dominated: " << nbDominatedFixings << ") and "
+              << nbPlacementFixings << " placement variables." << std::endl;
+    std::cout << "\t > " << nbUnusedNodes << " nodes cannot host any vnf; " << nbTightenedSections 
+              << " sections require more nodes than the availability bound." << std::endl;
+}
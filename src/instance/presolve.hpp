@@ -0,0 +1,97 @@
+#ifndef __presolve__hpp
+#define __presolve__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cfloat>
+#include <map>
+
+/*** Own Libraries ***/
+#include "data.hpp"
+
+
+/************************************************************************************
+ * This class implements a domain-specific presolve on the instance data. It
+ * computes which assignments x[k][i][v] and placements y[v][f] can be fixed to
+ * zero before the model is built:
+ *  - capacity: node v cannot process one unit of bandwidth*consumption;
+ *  - latency (routing only): the shortest path from the source to the target
+ *    through node v is longer than the maximum latency of the demand;
+ *  - dominated nodes: nodes with null availability bring no availability to any
+ *    section and only consume capacity;
+ *  - placements: y[v][f] is fixed when no section requiring f can use node v.
+ * It also computes, for each section, the minimum number of nodes to be assigned
+ * given the remaining nodes and the best availability reachable by the other
+ * sections of the chain. If a section cannot reach the availability required,
+ * the instance is reported as infeasible.
+ ************************************************************************************/
+class Presolve {
+
+private:
+    const Data&                                         data;               /**< Data read in data.hpp **/
+    std::vector< std::vector< std::vector<bool> > >     assignable;         /**< True if x[k][i][v] is kept. assignable[k][i][v] **/
+    std::vector< std::vector<bool> >                    placeable;          /**< True if y[v][f] is kept. placeable[v][f] **/
+    std::vector< std::vector<int> >                     minNbNodes;         /**< Minimum number of nodes assigned to each section. minNbNodes[k][i] **/
+    int                                                 nbCapacityFixings;  /**< Number of assignments fixed by capacity. **/
+    int                                                 nbLatencyFixings;   /**< Number of assignments fixed by latency. **/
+    int                                                 nbDominatedFixings; /**< Number of assignments fixed on dominated nodes. **/
+    int                                                 nbPlacementFixings; /**< Number of placements fixed. **/
+    int                                                 nbTightenedSections;/**< Number of sections whose minimum number of nodes was increased. **/
+    bool                                                infeasible;         /**< True if some section cannot reach the availability required. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Every variable is kept until run is called. @param data_ The instance data. **/
+    Presolve(const Data& data_);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns true if node v can be assigned to section i of demand k. **/
+    const bool  isAssignable            (const int k, const int i, const int v) const { return assignable[k][i][v]; }
+    /** Returns true if vnf f can be placed on node v. **/
+    const bool  isPlaceable             (const int v, const int f)              const { return placeable[v][f]; }
+    /** Returns the minimum number of nodes to be assigned to section i of demand k. @note If the section cannot reach the availability required, returns the number of nodes it can be assigned to and the instance is infeasible. **/
+    const int   getMinNbNodes           (const int k, const int i)              const { return minNbNodes[k][i]; }
+    /** Returns true if some section cannot reach the availability required, whatever the nodes assigned to it. **/
+    const bool  isInfeasible            ()                                      const { return infeasible; }
+    /** Returns the number of assignments fixed to zero. **/
+    const int   getNbAssignmentFixings  ()                                      const { return nbCapacityFixings + nbLatencyFixings + nbDominatedFixings; }
+    /** Returns the number of placements fixed to zero. **/
+    const int   getNbPlacementFixings   ()                                      const { return nbPlacementFixings; }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Computes the fixings and the minimum number of nodes of each section. **/
+    void run();
+
+private:
+    /** Fixes the assignments to nodes without enough capacity to process the section. **/
+    void fixByCapacity();
+    /** Fixes the assignments to nodes that cannot be visited within the maximum latency of the demand. **/
+    void fixByLatency();
+    /** Fixes the assignments to nodes with null availability. **/
+    void fixDominated();
+    /** Fixes the placements that cannot be used by any section. **/
+    void fixPlacements();
+    /** Computes the minimum number of nodes of each section from the remaining nodes. **/
+    void computeMinNbNodes();
+
+    /** Returns the availability of a section using every node it can be assigned to. **/
+    double getMaxSectionAvailability(const int k, const int i) const;
+
+public:
+	/****************************************************************************************/
+	/*										Display											*/
+	/****************************************************************************************/
+    /** Displays the reductions performed. **/
+    void print() const;
+};
+
+#endif
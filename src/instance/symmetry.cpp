@@ -0,0 +1,90 @@
+#include "symmetry.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Detects the symmetries of the instance. */
+Symmetry::Symmetry(const Data& data_) : data(data_)
+{
+    const bool ROUTING = (data.getInput().getRoutingActivation() == Input::ROUTING_ON);
+
+    /* Demands are grouped by their (bandwidth, availability, vnfs, source, target, latency) signature. */
+    typedef std::tuple<double, double, std::vector<int>, int, int, double> Signature;
+    std::map<Signature, std::vector<int> > groups;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        const Demand& demand = data.getDemand(k);
+        Signature signature(demand.getBandwidth(), demand.getAvailability(), demand.getListOfVNFs(),
+                            ROUTING ? demand.getSource() : -1, ROUTING ? demand.getTarget() : -1, ROUTING ? demand.getMaxLatency() : 0.0);
+        groups[signature].push_back(k);
+    }
+    for (std::map<Signature, std::vector<int> >::iterator it = groups.begin(); it != groups.end(); ++it){
+        if (it->second.size() > 1){
+            demandOrbits.push_back(it->second);
+        }
+    }
+
+    /* Without routing, the order of sections does not matter: sections with the same vnf are interchangeable. */
+    sectionOrbits.resize(data.getNbDemands());
+    if (!ROUTING){
+        for (int k = 0; k < data.getNbDemands(); k++){
+            std::map<int, std::vector<int> > sections;
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                sections[data.getDemand(k).getVNF_i(i)].push_back(i);
+            }
+            for (std::map<int, std::vector<int> >::iterator it = sections.begin(); it != sections.end(); ++it){
+                if (it->second.size() > 1){
+                    sectionOrbits[k].push_back(it->second);
+                }
+            }
+        }
+    }
+}
+
+/****************************************************************************************/
+/*										Getters 										*/
+/****************************************************************************************/
+
+/* Returns the total number of orbits of interchangeable sections. */
+const int Symmetry::getNbSectionOrbits() const
+{
+    int nbOrbits = 0;
+    for (unsigned int k = 0; k < sectionOrbits.size(); k++){
+        nbOrbits += (int)sectionOrbits[k].size();
+    }
+    return nbOrbits;
+}
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Returns the permutation that sorts the members of each orbit by increasing value. */
+std::vector<int> Symmetry::sortOrbits(const std::vector< std::vector<int> >& orbits, const std::vector<double>& value)
+{
+    std::vector<int> permutation(value.size());
+    std::iota(permutation.begin(), permutation.end(), 0);
+    for (unsigned int o = 0; o < orbits.size(); o++){
+        std::vector<int> members = orbits[o];
+        std::stable_sort(members.begin(), members.end(), [&value](int a, int b) { return value[a] < value[b]; });
+        for (unsigned int p = 0; p < members.size(); p++){
+            permutation[orbits[o][p]] = members[p];
+        }
+    }
+    return permutation;
+}
+
+/****************************************************************************************/
+/*										Display 										*/
+/****************************************************************************************/
+
+/* Displays the orbits detected. */
+void Symmetry::print() const
+{
+    int nbDemands = 0;
+    for (unsigned int o = 0; o < demandOrbits.size(); o++){
+        nbDemands += (int)demandOrbits[o].size();
+    }
+    std::cout << "\t > Symmetry detection: " << getNbDemandOrbits() << " orbits of equivalent demands (" << nbDemands << " demands), "
+              << getNbSectionOrbits() << " orbits of interchangeable sections." << std::endl;
+}
@@ -0,0 +1,68 @@
+#ifndef __symmetry__hpp
+#define __symmetry__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <tuple>
+#include <numeric>
+#include <algorithm>
+
+/*** Own Libraries ***/
+#include "data.hpp"
+
+
+/************************************************************************************
+ * This class detects the symmetries of an instance. Two demands are equivalent
+ * if they require the same bandwidth, availability and sequence of VNFs (and,
+ * when routing is activated, the same source, target and latency): swapping
+ * their assignments gives a solution with the same cost. When routing is not
+ * activated, the sections of a demand that require the same VNF are also
+ * interchangeable. Each set of equivalent demands (or sections) is an orbit.
+ ************************************************************************************/
+class Symmetry {
+
+private:
+    const Data&                                         data;           /**< Data read in data.hpp **/
+    std::vector< std::vector<int> >                     demandOrbits;   /**< Orbits of equivalent demands with at least two demands. **/
+    std::vector< std::vector< std::vector<int> > >      sectionOrbits;  /**< Orbits of interchangeable sections of each demand with at least two sections. sectionOrbits[k] **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Detects the symmetries of the instance. @param data_ The instance data. **/
+    Symmetry(const Data& data_);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the orbits of equivalent demands. **/
+    const std::vector< std::vector<int> >&  getDemandOrbits     ()              const { return demandOrbits; }
+    /** Returns the orbits of interchangeable sections of demand k. **/
+    const std::vector< std::vector<int> >&  getSectionOrbits    (const int k)   const { return sectionOrbits[k]; }
+    /** Returns the number of orbits of equivalent demands. **/
+    const int                               getNbDemandOrbits   ()              const { return (int)demandOrbits.size(); }
+    /** Returns the total number of orbits of interchangeable sections. **/
+    const int                               getNbSectionOrbits  ()              const;
+
+    /** Returns the weight of node v in the ordering function g = sum(weight(v) * x[v]) used to break symmetries. **/
+    static double                           getWeight           (const int v)         { return (double)(v + 1); }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Returns the permutation that sorts the members of each orbit by increasing value: position p of the result gives the element whose solution should be moved to p. Elements outside orbits are not moved. @param orbits The orbits. @param value The value of the ordering function for each element. **/
+    static std::vector<int> sortOrbits(const std::vector< std::vector<int> >& orbits, const std::vector<double>& value);
+
+	/****************************************************************************************/
+	/*										Display											*/
+	/****************************************************************************************/
+    /** Displays the orbits detected. **/
+    void print() const;
+};
+
+#endif
@@ -1,37 +1,176 @@
+#ifndef NO_CPLEX
 #include <ilcplex/ilocplex.h>
 ILOSTLBEGIN
+#endif
+
+#include <memory>
 
 #include "tools/others.hpp"
 #include "instance/data.hpp"
+#include "solver/lagrangian.hpp"
+#include "heuristic/ils.hpp"
+#include "solver/compact.hpp"
+#include "tools/batch.hpp"
+#include "tools/benchmark.hpp"
+#include "tools/generator.hpp"
+#ifndef NO_CPLEX
 #include "solver/model.hpp"
-// TODO Check Leo's makefile
-int main(int argc, char *argv[]) {
-    greetingMessage();
-    std::string parameterFile = getParameter(argc, argv);
+#include "solver/colgen.hpp"
+#endif
+/** Runs the solver given in the parameters. Returns 0 on success. **/
+int solve(const Data& data) {
+    /* Solvers which do not depend on CPLEX */
+    if (data.getInput().getSolver() == Input::SOLVER_HEURISTIC){
+        try
+        {
+            IteratedLocalSearch ils(data);
+            ils.run();
+            ils.printResult();
+            ils.output();
+            ils.exportSolution();
+            if (!ils.hasFound()){
+                std::cerr << "ERROR: The heuristic did not find any feasible placement." << std::endl;
+                return 1;
+            }
+        }
+        catch (const std::exception& e) { std::cerr << "Exception caught: " << e.what() << std::endl; return 1; }
+        catch (...) { std::cerr << "Unknown exception caught!" << std::endl; return 1; }
+        return 0;
+    }
+    if (data.getInput().getSolver() == Input::SOLVER_LAGRANGIAN){
+        try
+        {
+            Lagrangian lagrangian(data);
+            lagrangian.run();
+            lagrangian.printResult();
+            lagrangian.output();
+            lagrangian.exportSolution();
+            if (lagrangian.isInfeasible()){
+                std::cerr << "ERROR: The instance is infeasible." << std::endl;
+                return 1;
+            }
+        }
+        catch (const std::exception& e) { std::cerr << "Exception caught: " << e.what() << std::endl; return 1; }
+        catch (...) { std::cerr << "Unknown exception caught!" << std::endl; return 1; }
+        return 0;
+    }
+    if (data.getInput().getSolver() == Input::SOLVER_COMPACT){
+        /* The backend is released on every path, after the model built on it. */
+        try
+        {
+            std::unique_ptr<Backend> backend(Backend::create(data.getInput().getBackend()));
+            if (!backend){
+                std::cerr << "ERROR: The backend " << data.getInput().getBackend() << " was not compiled in this executable." << std::endl;
+                return 1;
+            }
+            CompactModel compact(data, *backend);
+            compact.run();
+            compact.printResult();
+            compact.output();
+            compact.exportSolution();
+        }
+#ifndef NO_CPLEX
+        catch (const IloException& e) { std::cerr << "Exception caught: " << e << std::endl; return 1; }
+#endif
+        catch (const std::exception& e) { std::cerr << "Exception caught: " << e.what() << std::endl; return 1; }
+        catch (...) { std::cerr << "Unknown exception caught!" << std::endl; return 1; }
+        return 0;
+    }
 
-    /* Set input data */
-    Data data(parameterFile);
-    data.print();
+#ifdef NO_CPLEX
+    std::cerr << "ERROR: This executable was built without CPLEX. Use solver=heuristic, solver=lagrangian or solver=compact with backend=highs." << std::endl;
+    return 1;
+#else
+    /* Each solve owns its environment, so that batch jobs can run concurrently. */
     IloEnv env;
-	
+
     try
     {
-        /* Model construct */
-        Model model(env, data);
+        if (data.getInput().getSolver() == Input::SOLVER_COLGEN){
+            ColumnGeneration colgen(env, data);
+            colgen.run();
+            colgen.printResult();
+            colgen.output();
+            colgen.exportSolution();
+        }
+        else{
+            /* Model construct */
+            Model model(env, data);
 
-        /* Model run */
-        model.run();
+            /* Model run */
+            model.run();
 
-        /* Print results */
-        model.printResult();
-        model.output();
+            /* Print results */
+            model.printResult();
+            model.output();
+            model.exportSolution();
+        }
     }
     catch (const IloException& e) { env.end(); std::cerr << "Exception caught: " << e << std::endl; return 1; }
+    catch (const std::exception& e) { env.end(); std::cerr << "Exception caught: " << e.what() << std::endl; return 1; }
     catch (...) { env.end(); std::cerr << "Unknown exception caught!" << std::endl; return 1; }
-    
+
 
     /*** Finalization ***/
     env.end();
-    endingMessage();
     return 0;
+#endif
+}
+
+// TODO Check Leo's makefile
+int main(int argc, char *argv[]) {
+    greetingMessage();
+
+    /* Batch mode: ./exec --batch <manifest or glob> [jobs] */
+    if (argc >= 3 && std::string(argv[1]) == "--batch"){
+        Batch batch(argv[2], (argc > 3 ? std::stoi(argv[3]) : 1));
+        const int status = batch.run(solve);
+        batch.printResult();
+        if (status == 0){
+            endingMessage();
+        }
+        return status;
+    }
+
+    /* Benchmark mode: ./exec --benchmark <matrix> [jobs] */
+    if (argc >= 3 && std::string(argv[1]) == "--benchmark"){
+        Benchmark benchmark(argv[2]);
+        const int NB_FAILED = benchmark.run(solve, (argc > 3 ? std::stoi(argv[3]) : 1));
+        const int NB_REGRESSIONS = benchmark.compare();
+        if (NB_FAILED == 0 && NB_REGRESSIONS == 0){
+            endingMessage();
+            return 0;
+        }
+        std::cerr << "ERROR: " << NB_FAILED << " failed runs and " << NB_REGRESSIONS << " regressions." << std::endl;
+        return 1;
+    }
+
+    /* Generator mode: ./exec --generate <specification> */
+    if (argc >= 3 && std::string(argv[1]) == "--generate"){
+        Generator generator(argv[2]);
+        const int NB_FAILED = generator.run();
+        if (NB_FAILED == 0){
+            endingMessage();
+            return 0;
+        }
+        std::cerr << "ERROR: " << NB_FAILED << " instances could not be written." << std::endl;
+        return 1;
+    }
+
+    std::string parameterFile = getParameter(argc, argv);
+
+    try
+    {
+        /* Set input data */
+        Data data(parameterFile);
+        data.print();
+
+        const int status = solve(data);
+        data.getProfiler().print();
+        if (status == 0){
+            endingMessage();
+        }
+        return status;
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; return 1; }
 }
@@ -0,0 +1,137 @@
+#include "harness.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+/****************************************************************************************/
+/*										State											*/
+/****************************************************************************************/
+
+/* Constructor. */
+Microbench::State::State(const std::vector<long>& args_, const long maxIterations_) :
+                            args(args_), maxIterations(maxIterations_), iterations(0), itemsProcessed(0),
+                            running(false), elapsed(0.0)
+{
+}
+
+/* Stops the timer. */
+void Microbench::State::pauseTiming()
+{
+    if (!running) return;
+    elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    running = false;
+}
+
+/* Restarts the timer. */
+void Microbench::State::resumeTiming()
+{
+    if (running) return;
+    running = true;
+    start = std::chrono::steady_clock::now();
+}
+
+/****************************************************************************************/
+/*										Cases											*/
+/****************************************************************************************/
+
+/* Adds an argument set. */
+Microbench::Case* Microbench::Case::args(const std::vector<long>& values)
+{
+    argSets.push_back(values);
+    return this;
+}
+
+/* Adds every combination of one value per list, the last list varying fastest. */
+Microbench::Case* Microbench::Case::argsProduct(const std::vector< std::vector<long> >& lists)
+{
+    std::vector< std::vector<long> > product(1);
+    for (unsigned int l = 0; l < lists.size(); l++){
+        std::vector< std::vector<long> > extended;
+        for (unsigned int p = 0; p < product.size(); p++){
+            for (unsigned int j = 0; j < lists[l].size(); j++){
+                extended.push_back(product[p]);
+                extended.back().push_back(lists[l][j]);
+            }
+        }
+        product.swap(extended);
+    }
+    argSets.insert(argSets.end(), product.begin(), product.end());
+    return this;
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Returns the registered benchmarks. Built on first use, so that registration does not depend on the initialization order of translation units. */
+std::vector<Microbench::Case*>& Microbench::getCases()
+{
+    static std::vector<Case*> cases;
+    return cases;
+}
+
+/* Registers a benchmark. */
+Microbench::Case* Microbench::registerCase(const std::string& name, const Function function)
+{
+    getCases().push_back(new Case(name, function));
+    return getCases().back();
+}
+
+/* Runs the registered benchmarks whose name contains filter. */
+int Microbench::run(const std::string& filter, const double minTime, const bool csv)
+{
+    const long MAX_ITERATIONS = 1000000000L;
+    int nbRuns = 0;
+    if (csv){
+        std::cout << "name,iterations,real_time_ns,items_per_second" << std::endl;
+    }
+    else{
+        std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+                  << std::setw(14) << "Time (ns)" << std::setw(14) << "Iterations" << std::setw(16) << "Items/s" << std::endl;
+        std::cout << std::string(92, '-') << std::endl;
+    }
+    for (unsigned int c = 0; c < getCases().size(); c++){
+        const Case& current = *getCases()[c];
+        std::vector< std::vector<long> > argSets = current.getArgSets();
+        if (argSets.empty()){
+            argSets.push_back(std::vector<long>());
+        }
+        for (unsigned int a = 0; a < argSets.size(); a++){
+            std::ostringstream name;
+            name << current.getName();
+            for (unsigned int j = 0; j < argSets[a].size(); j++){
+                name << "/" << argSets[a][j];
+            }
+            if (name.str().find(filter) == std::string::npos) continue;
+
+            /* Grow the number of iterations until the run lasts long enough to be measured. */
+            long iterations = 1;
+            double elapsed = 0.0;
+            long items = 0;
+            while (true){
+                State state(argSets[a], iterations);
+                current.getFunction()(state);
+                elapsed = state.getElapsed();
+                items = state.getItemsProcessed();
+                if (elapsed >= minTime || iterations >= MAX_ITERATIONS) break;
+                const double FACTOR = (elapsed > 0.0 ? std::min(10.0, std::max(1.5, 1.4 * minTime / elapsed)) : 10.0);
+                iterations = std::min(MAX_ITERATIONS, (long)(iterations * FACTOR) + 1);
+            }
+
+            const double NS_PER_ITERATION = 1e9 * elapsed / iterations;
+            const double ITEMS_PER_SECOND = (items > 0 && elapsed > 0.0 ? items / elapsed : 0.0);
+            if (csv){
+                std::cout << name.str() << "," << iterations << "," << std::setprecision(6) << NS_PER_ITERATION << "," << ITEMS_PER_SECOND << std::endl;
+            }
+            else{
+                std::cout << std::left << std::setw(48) << name.str() << std::right << std::fixed << std::setprecision(1)
+                          << std::setw(14) << NS_PER_ITERATION << std::setw(14) << iterations;
+                if (items > 0) std::cout << std::setw(16) << std::scientific << std::setprecision(3) << ITEMS_PER_SECOND;
+                std::cout << std::defaultfloat << std::endl;
+            }
+            nbRuns++;
+        }
+    }
+    return nbRuns;
+}
@@ -0,0 +1,112 @@
+#ifndef __harness__hpp
+#define __harness__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+
+/************************************************************************************
+ * This class runs micro-benchmarks in the way of Google Benchmark. A benchmark
+ * is a function looping on State::keepRunning() and reading its arguments with
+ * State::range(); it is registered with MICROBENCHMARK along with the argument
+ * sets it is run on. Each run is repeated with a growing number of iterations
+ * until it lasts at least the minimum time, and the time per iteration of the
+ * last repetition is reported.
+ ************************************************************************************/
+class Microbench {
+
+public:
+    /** The state of a benchmark run: its arguments, iteration count and timer. **/
+    class State {
+    private:
+        const std::vector<long>                 args;           /**< The arguments of the run. **/
+        const long                              maxIterations;  /**< The number of iterations to be run. **/
+        long                                    iterations;     /**< The number of iterations started so far. **/
+        long                                    itemsProcessed; /**< The number of items processed by the run, if set. **/
+        bool                                    running;        /**< True while the timer runs. **/
+        std::chrono::steady_clock::time_point   start;          /**< Time at which the timer was last started. **/
+        double                                  elapsed;        /**< Time measured so far, in seconds. **/
+
+    public:
+        /** Constructor. @param args_ The arguments of the run. @param maxIterations_ The number of iterations to be run. **/
+        State(const std::vector<long>& args_, const long maxIterations_);
+
+        /** Returns true while iterations remain to be run. The timer starts at the first call and stops at the last one. **/
+        bool keepRunning() {
+            if (iterations == 0) resumeTiming();
+            if (iterations < maxIterations){
+                iterations++;
+                return true;
+            }
+            pauseTiming();
+            return false;
+        }
+
+        /** Returns the j-th argument of the run. **/
+        long range(const int j) const { return args[j]; }
+        /** Returns the number of iterations to be run. **/
+        long getMaxIterations() const { return maxIterations; }
+        /** Returns the measured time, in seconds. **/
+        double getElapsed() const { return elapsed; }
+        /** Returns the number of items processed by the run, or 0 if it was not set. **/
+        long getItemsProcessed() const { return itemsProcessed; }
+
+        /** Stops the timer, so that the work done until resumeTiming() is not measured. **/
+        void pauseTiming();
+        /** Restarts the timer. **/
+        void resumeTiming();
+        /** Sets the number of items processed by the run, from which a throughput is reported. **/
+        void setItemsProcessed(const long items) { itemsProcessed = items; }
+    };
+
+    /** A benchmark function. **/
+    typedef void (*Function)(State&);
+
+    /** A registered benchmark and the argument sets it is run on. **/
+    class Case {
+    private:
+        std::string                         name;       /**< The benchmark name. **/
+        Function                            function;   /**< The benchmark function. **/
+        std::vector< std::vector<long> >    argSets;    /**< The argument sets, one run each. **/
+
+    public:
+        /** Constructor. **/
+        Case(const std::string& name_, const Function function_) : name(name_), function(function_) {}
+
+        /** Adds an argument set. **/
+        Case* args(const std::vector<long>& values);
+        /** Adds every combination of one value per list. **/
+        Case* argsProduct(const std::vector< std::vector<long> >& lists);
+
+        const std::string& getName() const { return name; }
+        Function getFunction() const { return function; }
+        const std::vector< std::vector<long> >& getArgSets() const { return argSets; }
+    };
+
+private:
+    /** Returns the registered benchmarks. **/
+    static std::vector<Case*>& getCases();
+
+public:
+    /** Registers a benchmark. Returns the case, so that argument sets can be chained. **/
+    static Case* registerCase(const std::string& name, const Function function);
+
+    /** Keeps the compiler from discarding the computation of a value. **/
+    template <class T>
+    static void doNotOptimize(const T& value) { asm volatile("" : : "r"(&value) : "memory"); }
+
+    /** Runs the registered benchmarks whose name contains filter, each at least minTime seconds. Displays one line per run, or csv lines if csv is set. Returns the number of runs. **/
+    static int run(const std::string& filter, const double minTime, const bool csv);
+};
+
+/** Registers a benchmark function: MICROBENCHMARK(function)->args({...}). **/
+#define MICROBENCHMARK(function) static Microbench::Case* microbench_##function = Microbench::registerCase(#function, function)
+
+#endif
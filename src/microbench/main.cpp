@@ -0,0 +1,232 @@
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/*** Own Libraries ***/
+#include "harness.hpp"
+#include "synthetic.hpp"
+#include "../tools/random.hpp"
+#include "../solver/availabilitykernel.hpp"
+
+/************************************************************************************
+ * Micro-benchmarks of the availability queries of Data and of the kernels run by
+ * the callback on integer candidates. Runs are identified by their arguments:
+ * the number of nodes and, where it matters, the number of nines of the SLA
+ * (2 for 0.99 up to 6 for 0.999999). Candidates are built as the callback would
+ * read them from the CPLEX context: each section of the demand is placed on its
+ * least available node, which violates every SLA benchmarked.
+ ************************************************************************************/
+
+/** Returns the SLA of a run, from its number of nines. **/
+static double getSla(const Microbench::State& state)
+{
+    return 1.0 - std::pow(10.0, -(double)state.range(1));
+}
+
+/** Returns a candidate placing each section of the synthetic demand on its least available node. **/
+static std::vector< std::vector<double> > getCandidate(const Data& data)
+{
+    const int LEAST_AVAILABLE = data.getAvailNodeRank().back();
+    std::vector< std::vector<double> > xSol(SyntheticInstance::NB_VNFS, std::vector<double>(data.getNbNodes(), 0.0));
+    for (int i = 0; i < SyntheticInstance::NB_VNFS; i++){
+        xSol[i][LEAST_AVAILABLE] = 1.0;
+    }
+    return xSol;
+}
+
+/** Returns a random half of the nodes. **/
+static std::vector<bool> getNodeSubset(const Data& data)
+{
+    Random random(20102019);
+    std::vector<bool> subset(data.getNbNodes(), false);
+    for (int v = 0; v < data.getNbNodes(); v++){
+        subset[v] = (random.uniform() < 0.5);
+    }
+    subset[data.getAvailNodeRank().front()] = true;
+    return subset;
+}
+
+/****************************************************************************************/
+/*										Data queries									*/
+/****************************************************************************************/
+
+static void getVnfLB(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const double SLA = getSla(state);
+    while (state.keepRunning()){
+        Microbench::doNotOptimize(data.getVnfLB(SLA, SyntheticInstance::NB_VNFS));
+    }
+}
+MICROBENCHMARK(getVnfLB)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+static void getVnfLBOnSubset(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const double SLA = getSla(state);
+    const std::vector<bool> SUBSET = getNodeSubset(data);
+    while (state.keepRunning()){
+        Microbench::doNotOptimize(data.getVnfLB(SUBSET, SyntheticInstance::NB_VNFS, SLA));
+    }
+}
+MICROBENCHMARK(getVnfLBOnSubset)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+static void getMinNbNodes(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const double SLA = getSla(state);
+    while (state.keepRunning()){
+        Microbench::doNotOptimize(data.getMinNbNodes(SLA));
+    }
+}
+MICROBENCHMARK(getMinNbNodes)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+static void getNMostAvailableNodes(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const int NB = data.getMinNbNodes(getSla(state));
+    while (state.keepRunning()){
+        Microbench::doNotOptimize(data.getNMostAvailableNodes(NB));
+    }
+}
+MICROBENCHMARK(getNMostAvailableNodes)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+static void getNMostAvailableNodesOnSubset(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const int NB = data.getMinNbNodes(getSla(state));
+    const std::vector<bool> SUBSET = getNodeSubset(data);
+    while (state.keepRunning()){
+        Microbench::doNotOptimize(data.getNMostAvailableNodes(NB, SUBSET));
+    }
+}
+MICROBENCHMARK(getNMostAvailableNodesOnSubset)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+static void getParallelAvailability(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const std::vector<int> NODES = data.getNMostAvailableNodes(data.getMinNbNodes(getSla(state)));
+    while (state.keepRunning()){
+        Microbench::doNotOptimize(data.getParallelAvailability(NODES));
+    }
+}
+MICROBENCHMARK(getParallelAvailability)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+static void getNodeRankPosition(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const int NB_NODES = data.getNbNodes();
+    while (state.keepRunning()){
+        for (int v = 0; v < NB_NODES; v++){
+            Microbench::doNotOptimize(data.getNodeRankPosition(v));
+        }
+    }
+    state.setItemsProcessed(state.getMaxIterations() * NB_NODES);
+}
+MICROBENCHMARK(getNodeRankPosition)->args({50})->args({500})->args({5000});
+
+/****************************************************************************************/
+/*										Callback kernels								*/
+/****************************************************************************************/
+
+static void getAvailabilityOfSection(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const AvailabilityKernel kernel(data);
+    std::vector<double> xSection(data.getNbNodes(), 0.0);
+    const std::vector<int> NODES = data.getNMostAvailableNodes(data.getMinNbNodes(getSla(state)));
+    for (unsigned int j = 0; j < NODES.size(); j++){
+        xSection[NODES[j]] = 1.0;
+    }
+    while (state.keepRunning()){
+        Microbench::doNotOptimize(kernel.getAvailabilityOfSection(xSection));
+    }
+    state.setItemsProcessed(state.getMaxIterations() * data.getNbNodes());
+}
+MICROBENCHMARK(getAvailabilityOfSection)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+static void computeDeltaAvailability(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const AvailabilityKernel kernel(data);
+    const std::vector< std::vector<double> > CANDIDATE = getCandidate(data);
+    std::vector<double> sectionAvail(SyntheticInstance::NB_VNFS);
+    std::vector< std::vector<int> > coeff(SyntheticInstance::NB_VNFS, std::vector<int>(data.getNbNodes(), 1));
+    for (int i = 0; i < SyntheticInstance::NB_VNFS; i++){
+        sectionAvail[i] = kernel.getAvailabilityOfSection(CANDIDATE[i]);
+        for (int v = 0; v < data.getNbNodes(); v++){
+            coeff[i][v] = (CANDIDATE[i][v] >= 1.0 ? 0 : 1);
+        }
+    }
+    std::vector< std::vector<double> > deltaAvail(SyntheticInstance::NB_VNFS, std::vector<double>(data.getNbNodes(), 0.0));
+    const double SLA = getSla(state);
+    while (state.keepRunning()){
+        kernel.computeDeltaAvailability(SLA, deltaAvail, sectionAvail, coeff);
+        Microbench::doNotOptimize(deltaAvail);
+    }
+    state.setItemsProcessed(state.getMaxIterations() * SyntheticInstance::NB_VNFS * data.getNbNodes());
+}
+MICROBENCHMARK(computeDeltaAvailability)->argsProduct({{50, 500, 5000}, {2, 4, 6}});
+
+/** Lifts the violated candidate of the synthetic demand, as Callback::addLazyConstraints and CompactModel::separate do. The third argument is the lifting variant. **/
+static void lift(Microbench::State& state)
+{
+    const Data& data = SyntheticInstance::get(state.range(0));
+    const AvailabilityKernel kernel(data);
+    const double SLA = getSla(state);
+    const int VARIANT = (int)state.range(2);
+    const std::vector< std::vector<double> > CANDIDATE = getCandidate(data);
+
+    /* Sort the sections by availability and select the smallest violated subset. */
+    std::vector<AvailabilityKernel::MapAvailability> sectionAvailability = kernel.getAvailabilitiesOfSections(CANDIDATE);
+    const int nbSelectedSections = kernel.selectViolatedSections(sectionAvailability, SLA);
+
+    std::vector< std::vector<double> > xSol;
+    std::vector<AvailabilityKernel::MapAvailability> liftedAvailability;
+    long nbLifted = 0;
+    while (state.keepRunning()){
+        state.pauseTiming();
+        xSol = CANDIDATE;
+        liftedAvailability = sectionAvailability;
+        state.resumeTiming();
+        nbLifted += kernel.lift(xSol, SLA, liftedAvailability, nbSelectedSections, VARIANT);
+    }
+    Microbench::doNotOptimize(nbLifted);
+    state.setItemsProcessed(state.getMaxIterations() * nbSelectedSections * data.getNbNodes());
+}
+MICROBENCHMARK(lift)->argsProduct({{50, 500, 5000}, {2, 4, 6}, {0, 1}});
+
+/****************************************************************************************/
+/*										Main											*/
+/****************************************************************************************/
+
+/* Usage: ./exec_microbench [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>] [--benchmark_format=csv] */
+int main(int argc, char *argv[]){
+    std::string filter = "";
+    double minTime = 0.2;
+    bool csv = false;
+    for (int j = 1; j < argc; j++){
+        const std::string ARG = argv[j];
+        if (ARG.compare(0, 19, "--benchmark_filter=") == 0){
+            filter = ARG.substr(19);
+        }
+        else if (ARG.compare(0, 21, "--benchmark_min_time=") == 0){
+            minTime = std::atof(ARG.substr(21).c_str());
+        }
+        else if (ARG == "--benchmark_format=csv"){
+            csv = true;
+        }
+        else{
+            std::cerr << "Usage: " << argv[0] << " [--benchmark_filter=<substring>] [--benchmark_min_time=<seconds>] [--benchmark_format=csv]" << std::endl;
+            return 1;
+        }
+    }
+    return (Microbench::run(filter, minTime, csv) > 0 ? 0 : 1);
+}
@@ -0,0 +1,93 @@
+#include "synthetic.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "../tools/random.hpp"
+
+/* Returns the instances built so far, by number of nodes. */
+std::map< int, std::unique_ptr<Data> >& SyntheticInstance::getInstances()
+{
+    static std::map< int, std::unique_ptr<Data> > instances;
+    return instances;
+}
+
+/* Writes the instance files and the parameter file of an instance in a directory. */
+std::string SyntheticInstance::write(const std::string& directory, const int nbNodes)
+{
+    Random random(20102019, 0, nbNodes);
+
+    std::ofstream nodes((directory + "/node.csv").c_str());
+    nodes << "name;lat;long;capacity;availability;cost;" << std::endl;
+    for (int v = 0; v < nbNodes; v++){
+        nodes << "N" << v + 1 << ";" << v << ";" << v << ";1000000;" << 0.99 + 0.0099 * random.uniform() << ";" << 10 + (int)(40 * random.uniform()) << ";" << std::endl;
+    }
+
+    std::ofstream links((directory + "/link.csv").c_str());
+    links << "name;source;target;delay;bandwidth;" << std::endl;
+    for (int v = 0; v < nbNodes; v++){
+        const int NEXT = (v + 1) % nbNodes;
+        links << "L" << 2*v + 1 << ";N" << v + 1 << ";N" << NEXT + 1 << ";100;1000;" << std::endl;
+        links << "L" << 2*v + 2 << ";N" << NEXT + 1 << ";N" << v + 1 << ";100;1000;" << std::endl;
+    }
+
+    std::ofstream vnfs((directory + "/vnf.csv").c_str());
+    vnfs << "name;consumption;" << std::endl;
+    std::ostringstream chain;
+    for (int f = 0; f < NB_VNFS; f++){
+        vnfs << "vnf_" << f + 1 << ";100;" << std::endl;
+        chain << (f > 0 ? "," : "") << "vnf_" << f + 1;
+    }
+
+    std::ofstream demands((directory + "/demand.csv").c_str());
+    demands << "name;source;target;max_latency;bandwidth;availability;vnf_list" << std::endl;
+    demands << "d_1;N1;N" << nbNodes << ";1000000;1;0.999;" << chain.str() << std::endl;
+
+    const std::string PARAMETER_FILE = directory + "/parameters.txt";
+    std::ofstream parameters(PARAMETER_FILE.c_str());
+    parameters << "nodeFile=" << directory << "/node.csv" << std::endl
+               << "linkFile=" << directory << "/link.csv" << std::endl
+               << "demandFile=" << directory << "/demand.csv" << std::endl
+               << "vnfFile=" << directory << "/vnf.csv" << std::endl
+               << "linearRelaxation=0" << std::endl << "timeLimit=0" << std::endl
+               << "disaggregated_VNF_Placement=0" << std::endl << "strong_node_capacity=0" << std::endl
+               << "lazy=0" << std::endl << "heuristic=0" << std::endl << "node_cover=0" << std::endl
+               << "chain_cover=0" << std::endl << "vnf_lower_bound=0" << std::endl << "section_failure=0" << std::endl
+               << "routing=0" << std::endl << "availability_approx=0" << std::endl << "nb_breakpoints=0" << std::endl;
+    return PARAMETER_FILE;
+}
+
+/* Returns the instance with a given number of nodes, built on first use. The files are removed once read. */
+const Data& SyntheticInstance::get(const int nbNodes)
+{
+    std::map< int, std::unique_ptr<Data> >& instances = getInstances();
+    std::map< int, std::unique_ptr<Data> >::iterator it = instances.find(nbNodes);
+    if (it != instances.end()){
+        return *it->second;
+    }
+
+    char directory[] = "/tmp/microbench_XXXXXX";
+    if (mkdtemp(directory) == NULL){
+        std::cerr << "ERROR: Unable to create a directory for the synthetic instances." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    const std::string PARAMETER_FILE = write(directory, nbNodes);
+
+    /* Reading an instance displays every node: keep it out of the benchmark report. */
+    std::ostringstream sink;
+    std::streambuf* previous = std::cout.rdbuf(sink.rdbuf());
+    Data* data = new Data(PARAMETER_FILE);
+    std::cout.rdbuf(previous);
+
+    const char* FILES[] = { "node.csv", "link.csv", "vnf.csv", "demand.csv", "parameters.txt" };
+    for (unsigned int j = 0; j < sizeof(FILES) / sizeof(FILES[0]); j++){
+        std::remove((std::string(directory) + "/" + FILES[j]).c_str());
+    }
+    rmdir(directory);
+
+    instances[nbNodes].reset(data);
+    return *data;
+}
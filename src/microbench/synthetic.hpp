@@ -0,0 +1,41 @@
+#ifndef __synthetic__hpp
+#define __synthetic__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <memory>
+#include <string>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class provides the synthetic instances the micro-benchmarks run on. An
+ * instance of a given size has nodes of availability drawn uniformly in
+ * [0.99, 0.9999] from a fixed seed, a bidirected ring of links, NB_VNFS vnfs
+ * and a single demand chaining them. It is written to a temporary directory,
+ * read as any other instance and kept for the whole process.
+ ************************************************************************************/
+class SyntheticInstance {
+
+public:
+    static const int NB_VNFS = 4;   /**< Number of vnfs, and of sections of the demand. **/
+
+private:
+    /** Returns the instances built so far, by number of nodes. **/
+    static std::map< int, std::unique_ptr<Data> >& getInstances();
+
+    /** Writes the instance files and the parameter file of an instance in a directory. Returns the parameter file. **/
+    static std::string write(const std::string& directory, const int nbNodes);
+
+public:
+    /** Returns the instance with a given number of nodes, built on first use. **/
+    static const Data& get(const int nbNodes);
+};
+
+#endif
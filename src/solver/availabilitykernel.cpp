@@ -0,0 +1,142 @@
+#include "availabilitykernel.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Computes the log-unavailability of each node. */
+AvailabilityKernel::AvailabilityKernel(const Data& data_) : data(data_), nodeLogUnavail(data_.getNbNodes())
+{
+    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
+        int v = data.getNodeId(n);
+        nodeLogUnavail[v] = std::log(1.0 - data.getNode(v).getAvailability());
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Returns the availability of a section obtained from an integer solution. */
+double AvailabilityKernel::getAvailabilityOfSection(const std::vector<double>& xSection) const
+{
+    double failure_prob = 1.0;
+    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
+        int v = data.getNodeId(n);
+        if (xSection[v] >= 1 - TOLERANCE){
+            failure_prob *= (1.0 - data.getNode(v).getAvailability());
+        }
+    }
+    double availability = 1.0 - failure_prob;
+    return availability;
+}
+
+/* Returns the availabilities of the sections of a SFC demand obtained from an integer solution. */
+std::vector<AvailabilityKernel::MapAvailability> AvailabilityKernel::getAvailabilitiesOfSections(const std::vector< std::vector<double> >& xDemand) const
+{
+    std::vector<MapAvailability> sectionAvailability;
+    for (unsigned int i = 0; i < xDemand.size(); i++){
+        MapAvailability entry;
+        entry.section = i;
+        entry.availability = getAvailabilityOfSection(xDemand[i]);
+        sectionAvailability.push_back(entry);
+    }
+    return sectionAvailability;
+}
+
+/* Sorts the sections by increasing availability and returns the number of sections of the smallest prefix violating the required availability, or 0. */
+int AvailabilityKernel::selectViolatedSections(std::vector<MapAvailability>& sectionAvailability, const double availabilityRequired) const
+{
+    std::sort(sectionAvailability.begin(), sectionAvailability.end(),
+              [](const MapAvailability& a, const MapAvailability& b){ return a.availability < b.availability; });
+    double chainAvailability = 1.0;
+    int nbSelectedSections = 0;
+    while ((chainAvailability >= availabilityRequired) && (nbSelectedSections < (int)sectionAvailability.size())){
+        chainAvailability *= sectionAvailability[nbSelectedSections].availability;
+        nbSelectedSections++;
+    }
+    return (chainAvailability < availabilityRequired ? nbSelectedSections : 0);
+}
+
+/* Computes the availability increment resulted from the instalation of a new vnf. */
+void AvailabilityKernel::computeDeltaAvailability(const double CHAIN_AVAIL, std::vector< std::vector<double> >& deltaAvail, const std::vector< double >& sectionAvail, const std::vector< std::vector<int> >& coeff) const
+{
+    for (unsigned int i = 0; i < sectionAvail.size(); i++){
+        for (unsigned int v = 0; v < coeff[i].size(); v++){
+            /* If node is already placed, forbid inclusion */
+            if (coeff[i][v] == 0){
+                deltaAvail[i][v] = 10.0;
+            }
+            else{
+                double newSectionAvail = (1.0 - ((1.0 - sectionAvail[i])*(1.0 - data.getNode(v).getAvailability())));
+                double newChainAvail = (CHAIN_AVAIL / sectionAvail[i])*newSectionAvail;
+                deltaAvail[i][v] = newChainAvail - CHAIN_AVAIL;
+            }
+        }
+    }
+}
+
+/* Tries to add new vnf placements to the current solution without changing its availability violation. Candidates are evaluated in log space and visited in availability rank order. */
+int AvailabilityKernel::lift(std::vector< std::vector<double> >& xSol, const double availabilityRequired, std::vector<MapAvailability>& sectionAvailability, const int nbSections, const int variant) const
+{
+    int nbLifted = 0;
+    /* Sections with no placement would lead to log(0); bound them from below. */
+    const double MIN_AVAIL  = 1e-300;
+    const double LOG_REQ    = std::log(availabilityRequired);
+    const int    NB_NODES   = (int)data.getAvailNodeRank().size();
+    const bool   REVERSE    = (variant % 2 == 1);
+    const int    ROTATION   = (variant / 2) % nbSections;
+
+    /* Compute the log-unavailability of each section and the log-availability of the chain. */
+    std::vector<double> sectionLogUnavail(nbSections);
+    std::vector<double> sectionLogAvail(nbSections);
+    double chainLogAvail = 0.0;
+    for (int s = 0; s < nbSections; ++s){
+        const double AVAIL   = std::max(sectionAvailability[s].availability, MIN_AVAIL);
+        sectionLogUnavail[s] = std::log1p(-AVAIL);
+        sectionLogAvail[s]   = std::log(AVAIL);
+        chainLogAvail       += sectionLogAvail[s];
+    }
+
+    for (int j = 0; j < nbSections; ++j){
+        const int s = (j + ROTATION) % nbSections;
+        const int i = sectionAvailability[s].section;
+        for (int pos = 0; pos < NB_NODES; ++pos){
+            const int v = REVERSE ? data.getAvailNodeRank()[NB_NODES - 1 - pos] : data.getAvailNodeRank()[pos];
+            /* If the i-th vnf is not placed on node v */
+            if (xSol[i][v] < 1 - TOLERANCE){
+                /* Compute the availability obtained if a i-th vnf was placed on node v: only section s changes. */
+                const double NEW_LOG_UNAVAIL = sectionLogUnavail[s] + nodeLogUnavail[v];
+                const double NEW_LOG_AVAIL   = std::log1p(-std::exp(NEW_LOG_UNAVAIL));
+                const double FUTURE_LOG      = chainLogAvail - sectionLogAvail[s] + NEW_LOG_AVAIL;
+                /* If the availability would still be violated */
+                if (FUTURE_LOG < LOG_REQ){
+                    /* Place vnf */
+                    xSol[i][v] = 1;
+                    nbLifted++;
+                    chainLogAvail        = FUTURE_LOG;
+                    sectionLogUnavail[s] = NEW_LOG_UNAVAIL;
+                    sectionLogAvail[s]   = NEW_LOG_AVAIL;
+                }
+            }
+        }
+        sectionAvailability[s].availability = std::exp(sectionLogAvail[s]);
+    }
+    return nbLifted;
+}
+
+/* Returns the (section, node) assignments of the no-good inequality forbidding the placement of xSol over the selected sections. */
+std::vector< std::pair<int, int> > AvailabilityKernel::getNoGoodSupport(const std::vector< std::vector<double> >& xSol, const std::vector<MapAvailability>& sectionAvailability, const int nbSections) const
+{
+    std::vector< std::pair<int, int> > support;
+    for (int s = 0; s < nbSections; ++s){
+        const int i = sectionAvailability[s].section;
+        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
+            const int v = data.getNodeId(n);
+            if (xSol[i][v] < 1 - TOLERANCE){
+                support.push_back(std::make_pair(i, v));
+            }
+        }
+    }
+    return support;
+}
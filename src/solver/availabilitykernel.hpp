@@ -0,0 +1,70 @@
+#ifndef __availabilitykernel__hpp
+#define __availabilitykernel__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class gathers the availability computations performed on integer
+ * solutions by Callback and CompactModel: the availability of the sections, the
+ * smallest subset of sections violating the SFC availability, the availability
+ * increment of each candidate placement, the lifting of a violated placement
+ * and the support of the resulting no-good inequality. They only depend on the
+ * instance data, so that both solvers separate the same cuts and the kernels
+ * can be run and measured apart from any MIP solver.
+ ************************************************************************************/
+class AvailabilityKernel {
+
+public:
+    /** Stores the section id and its availability. Used for the separation of integer solutions. **/
+    struct MapAvailability {
+        int section;            /**< The section id.*/
+        double availability;    /**< The section availability. */
+    };
+
+private:
+    const Data&         data;               /**< Data read in data.hpp **/
+    std::vector<double> nodeLogUnavail;     /**< Stores log(1 - a(v)) for each node v, used by the lifting procedure **/
+
+    static constexpr double TOLERANCE = 1e-4;   /**< A placement is taken as set when its value is at least 1 - TOLERANCE. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Computes the log-unavailability of each node. **/
+    AvailabilityKernel(const Data& data_);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Returns the availability of a section obtained from an integer solution. @param xSection The placement of the section on each node. **/
+    double getAvailabilityOfSection(const std::vector<double>& xSection) const;
+
+    /** Returns the availabilities of the sections of a SFC demand obtained from an integer solution. @param xDemand The placement of each section of the demand on each node. **/
+    std::vector<MapAvailability> getAvailabilitiesOfSections(const std::vector< std::vector<double> >& xDemand) const;
+
+    /** Sorts the sections by increasing availability and returns the number of sections of the smallest prefix violating the required availability, or 0 if the chain is available enough. @param sectionAvailability The section availabilities, sorted on return. @param availabilityRequired The SFC required availability. **/
+    int selectViolatedSections(std::vector<MapAvailability>& sectionAvailability, const double availabilityRequired) const;
+
+    /** Computes the availability increment resulted from the instalation of a new vnf. @param CHAIN_AVAIL The chain required availability. @param deltaAvail The matrix to be computed. @param sectionAvail THe current section availabilities. @param coeff The matrix of coefficients storing the possible vnfs to be placed. **/
+    void computeDeltaAvailability(const double CHAIN_AVAIL, std::vector< std::vector<double> >& deltaAvail, const std::vector< double >& sectionAvail, const std::vector< std::vector<int> >& coeff) const;
+
+    /** Tries to add new vnf placements to the current solution without changing its availability violation. Candidates are evaluated in log space and visited in availability rank order. @param xSol The current solution for a given demand. @param availabilityRequired The SFC required availability. @param sectionAvailability The current section availabilities. @param nbSections The number of sections that can be modified. @param variant Defines the order in which candidates are visited: even variants follow the availability ranking, odd variants the reverse ranking, and the starting section is rotated by variant/2. Returns the number of placements added. **/
+    int lift(std::vector< std::vector<double> >& xSol, const double availabilityRequired, std::vector<MapAvailability>& sectionAvailability, const int nbSections, const int variant = 0) const;
+
+    /** Returns the (section, node) assignments of the no-good inequality forbidding the placement of xSol over the first nbSections sections: at least one of them must be set. @param xSol The (lifted) solution of a given demand. @param sectionAvailability The sections sorted by availability. @param nbSections The number of sections involved. **/
+    std::vector< std::pair<int, int> > getNoGoodSupport(const std::vector< std::vector<double> >& xSol, const std::vector<MapAvailability>& sectionAvailability, const int nbSections) const;
+};
+
+#endif
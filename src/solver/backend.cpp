@@ -0,0 +1,24 @@
+#include "backend.hpp"
+
+#ifndef NO_CPLEX
+#include "cplexbackend.hpp"
+#endif
+#ifdef USE_HIGHS
+#include "highsbackend.hpp"
+#endif
+
+/****************************************************************************************/
+/*										Factory											*/
+/****************************************************************************************/
+
+/* Returns a new backend given its name, or NULL if it was not compiled in. */
+Backend* Backend::create(const std::string& name)
+{
+#ifndef NO_CPLEX
+    if (name == "cplex") return new CplexBackend();
+#endif
+#ifdef USE_HIGHS
+    if (name == "highs") return new HighsBackend();
+#endif
+    return NULL;
+}
@@ -0,0 +1,118 @@
+#ifndef __backend__hpp
+#define __backend__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <string>
+#include <vector>
+
+
+/************************************************************************************
+ * This class defines the interface between a formulation and a MIP solver.
+ * Variables and rows are identified by their index of creation. Lazy
+ * constraints and user cuts are provided by a Separator, which is called on
+ * integer candidates and on fractional points through a solver-independent
+ * Context. Implementations: CplexBackend (unless built with NO_CPLEX) and
+ * HighsBackend (when built with USE_HIGHS).
+ * Only CompactModel is written against this interface. Model and Callback,
+ * with their approximation encodings and cut families, stay on Concert: a
+ * HiGHS run compares with a CompactModel run on CPLEX, not with Model.
+ ************************************************************************************/
+class Backend {
+
+public:
+    /** The type of a variable. **/
+    enum VarType {
+        VAR_CONTINUOUS  = 0,
+        VAR_BINARY      = 1,
+        VAR_INTEGER     = 2
+    };
+
+    /** The outcome of a solve. **/
+    enum Status {
+        STATUS_UNKNOWN      = 0,    /**< No solution was found within the limits. **/
+        STATUS_FEASIBLE     = 1,    /**< A solution was found, optimality is not proven. **/
+        STATUS_OPTIMAL      = 2,    /**< An optimal solution was found. **/
+        STATUS_INFEASIBLE   = 3     /**< The problem is infeasible. **/
+    };
+
+    /** A linear row lb <= sum(coefs[j]*vars[j]) <= ub. **/
+    struct Row {
+        std::vector<int>    vars;       /**< The variable indexes. **/
+        std::vector<double> coefs;      /**< The coefficients. **/
+        double              lb;         /**< The lower bound. **/
+        double              ub;         /**< The upper bound. **/
+        std::string         name;       /**< The row name. **/
+    };
+
+    /** The point a separator is called on, and the way it adds rows. **/
+    class Context {
+    public:
+        virtual ~Context() {}
+        /** Returns true if the point is an integer candidate, false if it is fractional. **/
+        virtual bool    isCandidate     () const = 0;
+        /** Returns the value of a variable at the point. **/
+        virtual double  getValue        (const int var) const = 0;
+        /** Rejects the candidate with a lazy constraint. @note Only allowed on candidates. **/
+        virtual void    addLazy         (const Row& row) = 0;
+        /** Adds a user cut. @note Only allowed on fractional points. **/
+        virtual void    addCut          (const Row& row) = 0;
+    };
+
+    /** Provides lazy constraints and user cuts. **/
+    class Separator {
+    public:
+        virtual ~Separator() {}
+        /** Separates the point of the context. **/
+        virtual void separate(Context& context) = 0;
+    };
+
+public:
+    virtual ~Backend() {}
+
+    /** Returns the value standing for an infinite bound. Bounds beyond it are infinite for every backend. **/
+    static double getInfinity() { return 1e20; }
+
+	/****************************************************************************************/
+	/*										Factory											*/
+	/****************************************************************************************/
+    /** Returns a new backend given its name (cplex or highs), or NULL if it was not compiled in. The caller owns the backend. **/
+    static Backend* create(const std::string& name);
+
+	/****************************************************************************************/
+	/*										Model											*/
+	/****************************************************************************************/
+    /** Adds a variable to be minimized in the objective. Returns its index. **/
+    virtual int     addVariable     (const double lb, const double ub, const double obj, const VarType type, const std::string& name) = 0;
+    /** Adds a row. Returns its index. **/
+    virtual int     addRow          (const Row& row) = 0;
+    /** Sets the solution the solver starts from. @param values The value of every variable, in index order. **/
+    virtual void    setMipStart     (const std::vector<double>& values) = 0;
+    /** Sets the separator. @param separator The separator, owned by the caller. @param candidates True if it must be called on integer candidates. @param relaxations True if it must be called on fractional points. **/
+    virtual void    setSeparator    (Separator* separator, const bool candidates, const bool relaxations) = 0;
+
+	/****************************************************************************************/
+	/*										Solve											*/
+	/****************************************************************************************/
+    /** Solves the model. @param timeLimit The time limit in seconds. @param threads The number of threads. **/
+    virtual Status  solve           (const double timeLimit, const int threads) = 0;
+
+	/****************************************************************************************/
+	/*									Solution Query  									*/
+	/****************************************************************************************/
+    /** Returns the value of a variable in the best solution. **/
+    virtual double  getValue        (const int var) const = 0;
+    /** Returns the value of the best solution. **/
+    virtual double  getObjValue     () const = 0;
+    /** Returns the best bound. **/
+    virtual double  getBestBound    () const = 0;
+    /** Returns the number of branch-and-bound nodes explored. **/
+    virtual long    getNbNodes      () const = 0;
+    /** Returns the backend name. **/
+    virtual std::string getName     () const = 0;
+};
+
+#endif
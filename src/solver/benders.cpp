@@ -0,0 +1,107 @@
+#include "benders.hpp"
+
+#define PRECISION 1e-9      // Tolerance used when comparing delays
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Computes the shortest delay between every pair of nodes. */
+Benders::Benders(const Data& data_, const int nbWorkers_) : data(data_), nbWorkers(std::max(nbWorkers_, 1))
+{
+    if (!data.getInput().isBenders()) return;
+    delay.resize(data.getNbNodes());
+    for (int s = 0; s < data.getNbNodes(); s++){
+        delay[s] = data.getShortestDelays(s);
+    }
+}
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Solves the routing subproblem of demand k. */
+bool Benders::solve(const int k, const std::vector< std::vector<double> >& xSol, Cut& cut) const
+{
+    const int NB_VNFS = data.getDemand(k).getNbVNFs();
+
+    /* Nodes at the tail of section i are the ones of vnf i-1 (or the source), nodes at its head are the ones of vnf i (or the target). */
+    std::vector< std::vector<int> > nodes(NB_VNFS + 2);
+    nodes[0].push_back(data.getDemand(k).getSource());
+    for (int i = 0; i < NB_VNFS; i++){
+        for (int v = 0; v < data.getNbNodes(); v++){
+            if (xSol[i][v] > 0.5) nodes[i+1].push_back(v);
+        }
+    }
+    nodes[NB_VNFS+1].push_back(data.getDemand(k).getTarget());
+
+    /* The delay of each section is realized by its worst pair. */
+    double total = 0.0;
+    std::vector< std::pair<int,int> > critical(NB_VNFS + 1, std::make_pair(-1, -1));
+    for (int i = 0; i <= NB_VNFS; i++){
+        double sectionDelay = 0.0;
+        for (unsigned int a = 0; a < nodes[i].size(); a++){
+            for (unsigned int b = 0; b < nodes[i+1].size(); b++){
+                const double DELAY = delay[nodes[i][a]][nodes[i+1][b]];
+                if (DELAY > sectionDelay){
+                    sectionDelay = DELAY;
+                    critical[i] = std::make_pair(nodes[i][a], nodes[i+1][b]);
+                }
+            }
+        }
+        total = (sectionDelay >= DBL_MAX || total >= DBL_MAX) ? DBL_MAX : total + sectionDelay;
+    }
+    if (total <= data.getDemand(k).getMaxLatency() + PRECISION){
+        return true;
+    }
+
+    /* Any assignment containing the critical nodes has at least the same delay. */
+    cut.demand = k;
+    cut.delay  = total;
+    cut.terms.clear();
+    for (int i = 0; i <= NB_VNFS; i++){
+        if (critical[i].first == -1) continue;
+        /* Section i goes from vnf i-1 to vnf i; source and target are not variables. */
+        if (i > 0)          cut.terms.push_back(std::make_pair(i-1, critical[i].first));
+        if (i < NB_VNFS)    cut.terms.push_back(std::make_pair(i, critical[i].second));
+    }
+    std::sort(cut.terms.begin(), cut.terms.end());
+    cut.terms.erase(std::unique(cut.terms.begin(), cut.terms.end()), cut.terms.end());
+    return false;
+}
+
+/* Solves the routing subproblems of every demand in parallel. */
+std::vector<Benders::Cut> Benders::solve(const std::vector< std::vector< std::vector<double> > >& xSol) const
+{
+    /* Each worker only writes the entries of its own demands. */
+    std::vector<Cut> cuts(data.getNbDemands());
+    const int NB_THREADS = std::min(nbWorkers, data.getNbDemands());
+    if (NB_THREADS <= 1){
+        solveWorker(0, 1, xSol, cuts);
+    }
+    else{
+        std::vector<std::thread> workers;
+        for (int w = 0; w < NB_THREADS; w++){
+            workers.push_back(std::thread(&Benders::solveWorker, this, w, NB_THREADS, std::cref(xSol), std::ref(cuts)));
+        }
+        for (unsigned int w = 0; w < workers.size(); w++){
+            workers[w].join();
+        }
+    }
+
+    std::vector<Cut> found;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        if (cuts[k].demand != -1) found.push_back(cuts[k]);
+    }
+    return found;
+}
+
+/* Solves the routing subproblems of the demands assigned to a worker. */
+void Benders::solveWorker(const int worker, const int nbThreads, const std::vector< std::vector< std::vector<double> > >& xSol, std::vector<Cut>& cuts) const
+{
+    for (int k = worker; k < data.getNbDemands(); k += nbThreads){
+        if (solve(k, xSol[k], cuts[k])){
+            cuts[k].demand = -1;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef __benders__hpp
+#define __benders__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <thread>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class implements the routing subproblems of the Benders decomposition.
+ * The master problem only holds placement and assignment variables; routing is
+ * checked for each demand on the integer candidates. Since every node assigned
+ * to a section is linked to every node of the next section, the delay of a
+ * section is the largest shortest-path delay between its end nodes, and the
+ * demand is routable if the sum of its section delays respects its latency.
+ * A violated latency yields a feasibility cut forbidding the critical nodes,
+ * i.e., the end nodes of the pairs realizing each section delay.
+ ************************************************************************************/
+class Benders {
+
+public:
+    /** A feasibility cut of the form sum(x[demand][section][node]) <= |terms| - 1. **/
+    struct Cut {
+        int                                 demand;     /**< The demand id. **/
+        double                              delay;      /**< The delay of the candidate for the demand. **/
+        std::vector< std::pair<int,int> >   terms;      /**< The (section, node) pairs forbidden together. **/
+    };
+
+private:
+    const Data&                             data;       /**< Data read in data.hpp **/
+    std::vector< std::vector<double> >      delay;      /**< Shortest delay between every pair of nodes. delay[s][t] **/
+    const int                               nbWorkers;  /**< Number of threads solving the subproblems. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Computes the shortest delay between every pair of nodes if the Benders mode is activated. @param data_ The instance data. @param nbWorkers_ The number of threads solving the subproblems. **/
+    Benders(const Data& data_, const int nbWorkers_);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the shortest delay from node s to node t. **/
+    const double& getDelay(const int s, const int t) const { return delay[s][t]; }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Solves the routing subproblem of demand k. Returns true if its latency is respected; otherwise fills the feasibility cut. @param k The demand id. @param xSol The assignment of demand k. xSol[i][v] @param cut The cut to be filled. **/
+    bool solve(const int k, const std::vector< std::vector<double> >& xSol, Cut& cut) const;
+
+    /** Solves the routing subproblems of every demand in parallel. Returns the feasibility cuts found. @param xSol The assignment of every demand. xSol[k][i][v] **/
+    std::vector<Cut> solve(const std::vector< std::vector< std::vector<double> > >& xSol) const;
+
+private:
+    /** Solves the routing subproblems of demands worker, worker + nbThreads, ... @note A demand whose latency is respected gets a cut with demand -1. **/
+    void solveWorker(const int worker, const int nbThreads, const std::vector< std::vector< std::vector<double> > >& xSol, std::vector<Cut>& cuts) const;
+};
+
+#endif
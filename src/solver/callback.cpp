@@ -4,20 +4,29 @@
 /*										CONSTRUCTOR										*/
 /****************************************************************************************/
 /** Callback constructor. This is called only once, before the optimization procedure is launched. **/
-Callback::Callback(const IloEnv& env_, const Data& data_, 
+Callback::Callback(const IloEnv& env_, const Data& data_, const Presolve& presolve_,
                     const IloNumVar3DMatrix& x_, const IloNumVarMatrix& y_,
-                    const IloNumVarMatrix& secAvail_, const IloNumVarMatrix& secUnavail_) :
-                    env(env_), data(data_),	
+                    const IloNumVarMatrix& secAvail_, const IloNumVarMatrix& secUnavail_,
+                    const IloNumVarMatrix& logSecAvail_, const IloNumVarMatrix& logSecUnavail_) :
+                    env(env_), data(data_), presolve(presolve_),
                     x(x_), y(y_), 
                     secAvail(secAvail_), secUnavail(secUnavail_),
-                    cutPool(env)
+                    logSecAvail(logSecAvail_), logSecUnavail(logSecUnavail_),
+                    cutPool(env), cutCache(data_), benders(data_, data_.getInput().getBendersWorkers()),
+                    kernel(data_), separationProfile(!data_.getInput().getSeparationProfileFile().empty())
 {	
 	/*** Control ***/
     thread_flag.lock();
+    Profiler::Phase phase(data.getProfiler(), "Callback");
 
 	nb_cuts_avail_heuristic = 0;
+    nbHeuristicCalls        = 0;
     nbLazyConstraints       = 0;
     nbCuts                  = 0;
+    nbLiftedCuts            = 0;
+    nbTangentCuts           = 0;
+    nbExactRejections       = 0;
+    nbBendersCuts           = 0;
 	timeAll                 = 0;
     setCutPool();
 
@@ -40,9 +49,18 @@ Callback::Callback(const IloEnv& env_, const Data& data_,
     objSol = 0.0;
     remainingCapacity.resize(NB_NODES);
 
-    // input a big hard-coded number to serve as seed
-    const int SEED = 20102019;
-    srand(SEED);
+    // cut cache related initializations
+    if (!data.getInput().getCutCacheFile().empty()){
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
+                    int v = data.getNodeId(n);
+                    varIndex[x[k][i][v].getId()] = {k, i, v};
+                }
+            }
+        }
+        loadCutCache();
+    }
 
     thread_flag.unlock();
 }
@@ -58,6 +76,7 @@ void Callback::invoke(const Context& context)
         /* When fractional solution is available */
         case Context::Id::Relaxation:
         {
+            Profiler::Phase phase(data.getProfiler(), "Callback (relaxation)", true);
             int current_number_of_cuts = getNbUserCuts();
             // look up for user cuts and add them
             addUserCuts(context);
@@ -68,9 +87,18 @@ void Callback::invoke(const Context& context)
         /* When integer solution is available */
         case Context::Id::Candidate:
         {
+            Profiler::Phase phase(data.getProfiler(), "Callback (candidate)", true);
             // if the candidate solution is considered feasible, check if all lazy constraints are satisfied
 			if (context.isCandidatePoint()) {
-	    		addLazyConstraints(context);
+                if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_OUTER){
+                    tangentSeparation(context);
+                }
+                if (data.getInput().getLazy() == Input::LAZY_ON || data.getInput().isExactCheck()){
+	    		    addLazyConstraints(context);
+                }
+                if (data.getInput().isBenders()){
+                    bendersSeparation(context);
+                }
 			}
             break;
         }
@@ -85,11 +113,25 @@ void Callback::invoke(const Context& context)
 /** Launches the matheuristic procedure based on a given fractional solution. @note Should only be called within relaxation context.**/
 void Callback::runHeuristic(const Context &context)
 {
-    if ((data.getInput().getHeuristic() == Input::HEURISTIC_OFF) || (heuristicRule(context) == false)) return;
+    if (data.getInput().getHeuristic() == Input::HEURISTIC_OFF) return;
+
+    // each call draws from its own stream, keyed by the call number and the node UID: nothing is stored per node,
+    // and repeated calls on a node do not replay the same draws. The branch-and-cut of Model runs on one thread,
+    // so that the call numbers, hence the draws, are reproducible
+    const IloInt NODE = context.getLongInfo(IloCplex::Callback::Context::Info::NodeUID);
+    thread_flag.lock();
+    const uint32_t CALL = nbHeuristicCalls++;
+    thread_flag.unlock();
+    Random rng(data.getInput().getRandomSeed(), CALL, (uint64_t)NODE);
+    if (heuristicRule(context, rng) == false) return;
     
     try{
-        runHeuristic_Phase_I(context);
+        runHeuristic_Phase_I(context, rng);
         bool isFeasible = runHeuristic_Phase_II(context);
+        // without routing variables, the heuristic solution must also respect latencies
+        if (isFeasible && data.getInput().isBenders()){
+            isFeasible = benders.solve(xSol).empty();
+        }
         if ((isFeasible) && (objSol < context.getIncumbentObjective())){
             insertHeuristicSolution(context);
         }
@@ -100,14 +142,17 @@ void Callback::runHeuristic(const Context &context)
 }
 
 /** Builds (a possibly unfeasible) integer solution **/
-void Callback::runHeuristic_Phase_I(const Context &context){
+void Callback::runHeuristic_Phase_I(const Context &context, Random &rng){
+    SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_HEURISTIC_PHASE_I, getNodeDepth(context));
+    scope.setProduced(1);
     //build placement y
+    std::vector<double> rnd(data.getNbNodes() * data.getNbVnfs());
+    rng.uniform(rnd);
     objSol = 0.0;
     for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
         int v = data.getNodeId(n);
         for (int f = 0; f < data.getNbVnfs(); f++){
-            const double RND = ((double) rand() / (RAND_MAX));
-            if (RND <= context.getRelaxationPoint(y[v][f])){
+            if (rnd[v*data.getNbVnfs() + f] <= context.getRelaxationPoint(y[v][f])){
                 ySol[v][f] = 1;
                 objSol += data.getPlacementCost(data.getNode(v), data.getVnf(f));
             }
@@ -121,13 +166,14 @@ void Callback::runHeuristic_Phase_I(const Context &context){
         int v = data.getNodeId(n);
         remainingCapacity[v] = data.getNode(v).getCapacity();
         for (int k = 0; k < data.getNbDemands(); k++){
+            rnd.resize(data.getDemand(k).getNbVNFs());
+            rng.uniform(rnd);
             for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
                 int f = data.getDemand(k).getVNF_i(i);
                 double req_capacity = data.getDemand(k).getBandwidth() * data.getVnf(f).getConsumption();
-                if (ySol[v][f] == 1 && req_capacity <= remainingCapacity[v]){
+                if (ySol[v][f] == 1 && req_capacity <= remainingCapacity[v] && presolve.isAssignable(k, i, v)){
                     // there is a chance of assigning the vnf
-                    const double RND = ((double) rand() / (RAND_MAX));
-                    if (RND <= context.getRelaxationPoint(x[k][i][v])){
+                    if (rnd[i] <= context.getRelaxationPoint(x[k][i][v])){
                         xSol[k][i][v] = 1;
                         remainingCapacity[v] -= req_capacity;
                     }
@@ -145,13 +191,14 @@ void Callback::runHeuristic_Phase_I(const Context &context){
 
 /** Launches the phase II of the matheuristic procedure. Returns true if a feasible solution was found. **/
 bool Callback::runHeuristic_Phase_II(const Context &context){
+    SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_HEURISTIC_PHASE_II, getNodeDepth(context));
     for (int k = 0; k < data.getNbDemands(); k++){
         int i = 0;
         const double REQ_AVAIL = data.getDemand(k).getAvailability();
         while (getSolutionAvail_k(k, i) < REQ_AVAIL){
             int f = data.getDemand(k).getVNF_i(i);
             //choose node to install the ith vnf of sfc k
-            int v = getNodeToInstall(f, k);
+            int v = getNodeToInstall(f, k, i);
             if (v == -1) return false;
             
             // set x[k,i,v] to 1 and y[v, f(i,k)] also if needed
@@ -163,11 +210,12 @@ bool Callback::runHeuristic_Phase_II(const Context &context){
             }
         }
     }
+    scope.setProduced(1);
     return true;
 }
 
 /** Chooses on which node VNF f should be installed for demand k **/
-int Callback::getNodeToInstall(int f, int k){
+int Callback::getNodeToInstall(int f, int k, int i){
     const double REQ_CAPACITY   = data.getDemand(k).getBandwidth() * data.getVnf(f).getConsumption();
     IloNum maxRemainingCapacity = 0.0;
     IloNum minValue             = IloInfinity;
@@ -175,7 +223,7 @@ int Callback::getNodeToInstall(int f, int k){
 
     for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
         int v = data.getNodeId(n);
-        if (REQ_CAPACITY <= remainingCapacity[v]){
+        if (REQ_CAPACITY <= remainingCapacity[v] && presolve.isAssignable(k, i, v)){
             const IloNum ADDITIONAL_COST = (data.getPlacementCost(data.getNode(v), data.getVnf(f))) * (1.0 - ySol[v][f]);
             if (ADDITIONAL_COST <= minValue + EPSILON){
                 if (ADDITIONAL_COST <= minValue - EPSILON){
@@ -258,7 +306,13 @@ void Callback::insertHeuristicSolution(const Context &context){
                 objVal += ( cost*ySol[v][f] ); 
             }
         }
-        context.postHeuristicSolution(vars, vals, objVal, IloCplex::Callback::Context::SolutionStrategy::NoCheck);
+        // under an approximation, CPLEX completes the availability variables
+        if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_NONE){
+            context.postHeuristicSolution(vars, vals, objVal, IloCplex::Callback::Context::SolutionStrategy::NoCheck);
+        }
+        else{
+            context.postHeuristicSolution(vars, vals, objVal, IloCplex::Callback::Context::SolutionStrategy::Solve);
+        }
         vals.end();
     }
     catch (...) {
@@ -268,13 +322,14 @@ void Callback::insertHeuristicSolution(const Context &context){
 }
 
 /** Checks if the heuristic should be launched. **/
-bool Callback::heuristicRule(const Context &context){
-    if (data.getInput().getApproximationType() != Input::APPROXIMATION_TYPE_NONE) return false;
+bool Callback::heuristicRule(const Context &context, Random &rng){
+    // heuristic solutions are only accepted under an approximation if candidates are checked exactly
+    if (data.getInput().getApproximationType() != Input::APPROXIMATION_TYPE_NONE && !data.getInput().isExactCheck()) return false;
     
     const double OBJ    = context.getRelaxationObjective();
     const double UB     = context.getIncumbentObjective();
     const double LIMIT  = (UB - OBJ) / UB;
-    const double RND    = ((double) rand() / (RAND_MAX));
+    const double RND    = rng.uniform();
 
     return (RND <= LIMIT);
 }
@@ -282,6 +337,7 @@ bool Callback::heuristicRule(const Context &context){
 /** Sets up the cut pool that is checked on relaxation context. On this pool only cuts appearing in a polynomial number are added. **/
 void Callback::setCutPool()
 {
+    Profiler::Phase phase(data.getProfiler(), "setCutPool");
     std::cout << "\t > Setting up pool of cuts... " << std::endl;
     if (data.getInput().getNodeCover() == Input::NODE_COVER_ON){
         addAvailabilityCoverConstraints();
@@ -354,52 +410,126 @@ void Callback::addVnfLowerBoundConstraints ()
 /** Add availability cover constraints to the cut pool. **/
 void Callback::addAvailabilityCoverConstraints(){
     std::cout << "Adding node cover cuts to the pool..." << std::endl;
+    const int NB_NODES = (int)data.getAvailNodeRank().size();
     /* For each SFC */
     for (int k = 0; k < data.getNbDemands(); k++){
-        /* Compute the coefficient c[v] for each node v. */
-        std::vector<int> c;
-        c.resize(data.getAvailNodeRank().size());
-        for (unsigned int i = 0; i < data.getAvailNodeRank().size(); i++){
-            int v = data.getAvailNodeRank()[i];
-            c[v] = data.getMinNbNodes(data.getDemand(k).getAvailability(), data.getNode(v).getAvailability());
-        }
+        /* Coefficients only depend on the SLA: rows are instantiated from the templates of its class. */
+        const std::pair<int,int>& templates = getCoverTemplates(data.getDemand(k).getAvailability());
         /* For each VNF section */
         for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-            /* For each node */
-            for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                int v = data.getNodeId(n);
-                int pos = data.getNodeRankPosition(v);
-                /* Define only the non-dominated constraints. */
-                if (pos > 0) {
-                    if (c[v] > c[data.getAvailNodeRank()[pos-1]]) {
-                        /* Define availability cover constraint for S = {j \in V : a(j) <= a(v) } */
-                        IloExpr exp(env);
-                        for (NodeIt it(data.getGraph()); it != lemon::INVALID; ++it){
-                            int node_id = data.getNodeId(it);
-                            int coeff = 0;
-                            if (data.getNodeRankPosition(node_id) < data.getNodeRankPosition(v)){
-                                coeff = std::max(c[v] - c[node_id] + 1, 1);
-                            }
-                            else{
-                                coeff = 1;
-                            }
-                            exp += coeff*x[k][i][node_id];
-                        }
-                        std::string name = "NodeCover(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(v) + ")";
-                        cutPool.add(IloRange(env, c[v], exp, IloInfinity, name.c_str()));
-                        exp.clear();
-                        exp.end();
-                    }
+            for (int t = templates.first; t < templates.first + templates.second; t++){
+                const int* coeff = &coverCoeffs[t*NB_NODES];
+                IloExpr exp(env);
+                for (int node_id = 0; node_id < NB_NODES; node_id++){
+                    exp += coeff[node_id]*x[k][i][node_id];
                 }
+                std::string name = "NodeCover(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(coverNode[t]) + ")";
+                cutPool.add(IloRange(env, coverRhs[t], exp, IloInfinity, name.c_str()));
+                exp.clear();
+                exp.end();
             }
         }
     }
 }
 
+/** Builds the availability cover templates shared by every demand with the same SLA. **/
+const std::pair<int,int>& Callback::getCoverTemplates(const double sla){
+    std::map< double, std::pair<int,int> >::iterator it = coverClasses.find(sla);
+    if (it != coverClasses.end()){
+        return it->second;
+    }
+
+    /* Compute the coefficient c[v] for each node v. */
+    const int NB_NODES = (int)data.getAvailNodeRank().size();
+    std::vector<int> c(NB_NODES);
+    for (int pos = 0; pos < NB_NODES; pos++){
+        int v = data.getAvailNodeRank()[pos];
+        c[v] = data.getMinNbNodes(sla, data.getNode(v).getAvailability());
+    }
+    std::pair<int,int> templates((int)coverRhs.size(), 0);
+    for (int v = 0; v < NB_NODES; v++){
+        int pos = data.getNodeRankPosition(v);
+        /* Define only the non-dominated constraints. */
+        if (pos > 0 && c[v] > c[data.getAvailNodeRank()[pos-1]]) {
+            /* Define availability cover constraint for S = {j \in V : a(j) <= a(v) } */
+            for (int node_id = 0; node_id < NB_NODES; node_id++){
+                if (data.getNodeRankPosition(node_id) < pos){
+                    coverCoeffs.push_back(std::max(c[v] - c[node_id] + 1, 1));
+                }
+                else{
+                    coverCoeffs.push_back(1);
+                }
+            }
+            coverRhs.push_back(c[v]);
+            coverNode.push_back(v);
+            templates.second++;
+        }
+    }
+    return coverClasses.insert(std::make_pair(sla, templates)).first->second;
+}
+
+/****************************************************************************************/
+/*										Cut Cache   									*/
+/****************************************************************************************/
+
+/** Stores a generated cut in the cut cache. **/
+void Callback::recordCut(const IloExpr& exp, const double lb, const std::string& family)
+{
+    if (data.getInput().getCutCacheFile().empty()) return;
+
+    CutCache::Cut cut;
+    cut.family = family;
+    cut.demand = -1;
+    cut.lb     = lb;
+    for (IloExpr::LinearIterator it = exp.getLinearIterator(); it.ok(); ++it){
+        auto search = varIndex.find(it.getVar().getId());
+        /* Only cuts over the assignment variables of a single demand are cached. */
+        if (search == varIndex.end()) return;
+        if (cut.demand != -1 && cut.demand != search->second[0]) return;
+        cut.demand = search->second[0];
+        CutCache::Term term;
+        term.section = search->second[1];
+        term.node    = search->second[2];
+        term.coeff   = it.getCoef();
+        cut.terms.push_back(term);
+    }
+    if (cut.demand != -1){
+        cutCache.add(cut);
+    }
+}
+
+/** Preloads the cuts stored in the cut cache file into the cut pool. **/
+void Callback::loadCutCache()
+{
+    Profiler::Phase phase(data.getProfiler(), "loadCutCache");
+    cutCache.read(data.getInput().getCutCacheFile());
+    for (unsigned int c = 0; c < cutCache.getCuts().size(); c++){
+        const CutCache::Cut& cached = cutCache.getCuts()[c];
+        IloExpr exp(env);
+        for (unsigned int t = 0; t < cached.terms.size(); t++){
+            const CutCache::Term& term = cached.terms[t];
+            exp += term.coeff * x[cached.demand][term.section][term.node];
+        }
+        std::string name = "Cached" + cached.family + "(" + std::to_string(cached.demand) + "," + std::to_string(c) + ")";
+        cutPool.add(IloRange(env, cached.lb, exp, IloInfinity, name.c_str()));
+    }
+}
+
+/** Writes the cuts generated so far (and the ones preloaded) to the cut cache file. **/
+void Callback::saveCutCache()
+{
+    if (data.getInput().getCutCacheFile().empty()) return;
+    Profiler::Phase phase(data.getProfiler(), "saveCutCache");
+    cutCache.write(data.getInput().getCutCacheFile());
+}
+
 /** Solves the separation problems for a given fractional solution. @note Should only be called within relaxation context.**/
 void Callback::addUserCuts(const Context &context)
 {
     try {    
+        if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_OUTER){
+            tangentSeparation(context);
+        }
         getFractionalSolution(context);
         /** If no cut in the cutpool is violated, `
          *  then, look for the violated cuts in the 
@@ -422,7 +552,10 @@ void Callback::addUserCuts(const Context &context)
 
 /* Checks whether the current solution satisfies all cuts in the pool and add the unsatisfied one. */
 bool Callback::checkCutPool(const Context &context){
+    SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_CUT_POOL, getNodeDepth(context));
     bool found_violated_cut = false;
+    int nbViolated = 0;
+    std::lock_guard<std::mutex> lock(pool_flag);
     for (IloInt i = 0; i < cutPool.getSize(); ++i) {
         const IloRange& cut = cutPool[i];
         const IloNum    LHS = context.getRelaxationValue(cut.getExpr());
@@ -430,15 +563,26 @@ bool Callback::checkCutPool(const Context &context){
         if ( LHS < cut.getLB() - EPS || LHS > cut.getUB() + EPS ) {
             std::cout << "Adding " << cut.getName() << std::endl;
             context.addUserCut(cut, IloCplex::UseCutForce, IloFalse);
-            incrementUsercuts();
+            /* Pool cuts are named after their family. */
+            const std::string NAME = cut.getName();
+            incrementUsercuts(NAME.substr(0, NAME.find('(')));
             found_violated_cut = true;
+            nbViolated++;
             /* Uncomment next line to add only one violated cut at a time. */
             // return true;
         }
     }
+    scope.setProduced(nbViolated);
     return found_violated_cut;
 }
 
+/* Returns the branch and bound depth of the current node. The depth is only queried when it is recorded. */
+int Callback::getNodeDepth(const Context &context) const
+{
+    if (!separationProfile.isEnabled()) return 0;
+    return (int)context.getLongInfo(IloCplex::Callback::Context::Info::NodeDepth);
+}
+
 // user cut related heuristic
 void Callback::initiateHeuristic(const int k, std::vector< std::vector<int> >& coeff, std::vector< std::vector<int> >& sectionNodes, std::vector< double >& sectionAvailability, const IloNum3DMatrix& xSol)
 {
@@ -487,6 +631,8 @@ void Callback::initiateHeuristic(const int k, std::vector< std::vector<int> >& c
 /* Solves the separation problem associated with the chain cover constraints. */
 void Callback::chainCoverSeparation(const Context &context, const IloNum3DMatrix& xSol)
 {
+    SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_CHAIN_COVER, getNodeDepth(context));
+    int nbAdded = 0;
     /* Check VNF placement availability for each demand */
     for (int k = 0; k < data.getNbDemands(); k++){
         std::vector<double> sum_over_nodes(data.getDemand(k).getNbVNFs(), 0.0);
@@ -519,17 +665,21 @@ void Callback::chainCoverSeparation(const Context &context, const IloNum3DMatrix
                 IloRange cut(env, rhs, expr, IloInfinity, name.c_str());
                 std::cout << "Adding " << cut.getName() << std::endl;
                 context.addUserCut(cut, IloCplex::UseCutForce, IloFalse);
-                incrementUsercuts();
+                incrementUsercuts("ChainCover");
+                recordCut(expr, rhs, "ChainCover");
                 expr.end();
+                nbAdded++;
                 break;
             }
         }
     }
+    scope.setProduced(nbAdded);
 }
 
 /* Solves the separation problem associated with the generalized cover constraints. */
 void Callback::generalizedCoverSeparation(const Context &context, const IloNum3DMatrix& xSol)
 {
+    SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_GENERALIZED_COVER, getNodeDepth(context));
     /* Check VNF placement availability for each demand */
     for (int k = 0; k < data.getNbDemands(); k++){
         for (NodeIt node(data.getGraph()); node != lemon::INVALID; ++node){
@@ -583,8 +733,10 @@ void Callback::generalizedCoverSeparation(const Context &context, const IloNum3D
                         IloRange cut(env, rhs, expr, IloInfinity, name.c_str());
                         std::cout << "Adding " << cut.getName() << std::endl;
                         context.addUserCut(cut, IloCplex::UseCutForce, IloFalse);
-                        incrementUsercuts();
+                        incrementUsercuts("GenCover");
+                        recordCut(expr, rhs, "GenCover");
                         expr.end();
+                        scope.setProduced(1);
                         return;
                     }
                 }
@@ -596,6 +748,8 @@ void Callback::generalizedCoverSeparation(const Context &context, const IloNum3D
 /* Greedly solves the separation problem associated with the availability constraints. */
 void Callback::heuristicSeparationOfAvailibilityConstraints(const Context &context, const IloNum3DMatrix& xSol)
 {
+    SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_HEURISTIC_AVAIL, getNodeDepth(context));
+    int nbAdded = 0;
     /* Check VNF placement availability for each demand */
     for (int k = 0; k < data.getNbDemands(); k++){
         
@@ -671,33 +825,27 @@ void Callback::heuristicSeparationOfAvailibilityConstraints(const Context &conte
                 std::cout << "Adding " << cut.getName() << std::endl;
                 context.addUserCut(cut, IloCplex::UseCutForce, IloFalse);
                 incrementAvailabilityCutsHeuristic();
-                incrementUsercuts();
+                incrementUsercuts("HeurAvail");
+                recordCut(expr, 1.0, "HeurAvail");
                 expr.end();
+                nbAdded++;
             }
         }
     }
+    scope.setProduced(nbAdded);
 }
 
 /** Computes the availability increment resulted from the instalation of a new vnf. @param CHAIN_AVAIL The chain required availability. @param deltaAvail The matrix to be computed. @param sectionAvail THe current section availabilities. @param coeff The matrix of coefficients storing the possible vnfs to be placed. **/
 void Callback::computeDeltaAvailability(const double CHAIN_AVAIL, std::vector< std::vector<double> >& deltaAvail, const std::vector< double >& sectionAvail, const std::vector< std::vector<int> >& coeff){
-    for (unsigned int i = 0; i < sectionAvail.size(); i++){
-        for (unsigned int v = 0; v < coeff[i].size(); v++){
-            /* If node is already placed, forbid inclusion */
-            if (coeff[i][v] == 0){
-                deltaAvail[i][v] = 10.0;
-            }
-            else{
-                double newSectionAvail = (1.0 - ((1.0 - sectionAvail[i])*(1.0 - data.getNode(v).getAvailability())));
-                double newChainAvail = (CHAIN_AVAIL / sectionAvail[i])*newSectionAvail;
-                deltaAvail[i][v] = newChainAvail - CHAIN_AVAIL;
-            }
-        }
-    }
+    kernel.computeDeltaAvailability(CHAIN_AVAIL, deltaAvail, sectionAvail, coeff);
 }
 
 /** Solves the separation problems for a given integer solution. @note Should only be called within candidate context.**/
 void Callback::addLazyConstraints(const Context &context)
 {
+    const int DEPTH = getNodeDepth(context);
+    SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_LAZY_AVAIL, DEPTH);
+    int nbRejections = 0;
     try {
         /* Get current integer solution */
         getIntegerSolution(context); 
@@ -705,106 +853,114 @@ void Callback::addLazyConstraints(const Context &context)
         /* Check VNF placement availability for each demand */
         for (int k = 0; k < data.getNbDemands(); k++){
             
-            /* Compute sections availability and sort them by increasing order */
+            /* Compute sections availability and find the smallest subset of sections violating the SFC availability. */
             std::vector<MapAvailability> sectionAvailability = getAvailabilitiesOfSections(k, xSol);
-            std::sort(sectionAvailability.begin(), sectionAvailability.end(), compareAvailability);
-
-            /* Find smallest subset of sections violating the SFC availability. */
             const double REQUIRED_AVAIL = data.getDemand(k).getAvailability(); 
-            double chainAvailability = 1.0;
-            int index = 0;
-            int nbSelectedSections = 0;
-            while ((chainAvailability >= REQUIRED_AVAIL) && (index < data.getDemand(k).getNbVNFs())){
-                chainAvailability *= sectionAvailability[index].availability;
-                nbSelectedSections++;
-                index++;
-            }
+            const int nbSelectedSections = kernel.selectViolatedSections(sectionAvailability, REQUIRED_AVAIL);
+
             /* If such subset is found, add lazy constraint. */
-            if (chainAvailability < REQUIRED_AVAIL){
+            if (nbSelectedSections > 0){
+                /* Keep the unlifted placement for building further variants */
+                const std::vector<MapAvailability> unliftedAvailability = sectionAvailability;
+                const IloNumMatrix unliftedSolution = xSol[k];
+
                 /* Try to lift the separating inequality */
-                lift(xSol[k], REQUIRED_AVAIL, sectionAvailability, nbSelectedSections);
+                {
+                    SeparationProfile::Scope liftScope(separationProfile, SeparationProfile::ROUTINE_LIFTING, DEPTH);
+                    liftScope.setProduced(lift(xSol[k], REQUIRED_AVAIL, sectionAvailability, nbSelectedSections));
+                }
 
                 /* Build inequality. */
                 IloExpr exp(env);
-                for (int s = 0; s < nbSelectedSections; ++s){
-                    int i = sectionAvailability[s].section;
-                    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-                        int v = data.getNodeId(n);
-                        if (xSol[k][i][v] < 1 - EPS){
-                            exp += x[k][i][v];
-                        }
-                    }
-                }
+                std::vector<int> signature;
+                buildAvailabilityNoGood(k, xSol[k], sectionAvailability, nbSelectedSections, exp, signature);
                 IloRange cut(env, 1.0, exp, IloInfinity);
                 context.rejectCandidate(cut);
-                incrementLazyConstraints();
+                incrementLazyConstraints("LazyAvail");
+                nbRejections++;
+                if (data.getInput().getApproximationType() != Input::APPROXIMATION_TYPE_NONE){
+                    thread_flag.lock();
+                    nbExactRejections++;
+                    thread_flag.unlock();
+                }
+                recordCut(exp, 1.0, "LazyAvail");
                 exp.end();
+
+                /* Restore the candidate solution and store other lifted variants in the pool. */
+                xSol[k] = unliftedSolution;
+                addLiftedVariantsToPool(k, nbSelectedSections, unliftedAvailability, signature, DEPTH);
             }
         }
     }
     catch (...) {
         throw;
     }
+    scope.setProduced(nbRejections);
 }
 
-/** Tries to add new vnf placements to the current solution without changing its availability violation. @param xSol The current solution for a given demand. @param availabilityRequired The SFC required availability. @param sectionAvailability The current section availabilities. @param nbSections The number of sections that can be modified. **/
-void Callback::lift(IloNumMatrix& xSol, const double& availabilityRequired, std::vector<Callback::MapAvailability>& sectionAvailability, const int& nbSections)
+/** Tries to add new vnf placements to the current solution without changing its availability violation. Candidates are evaluated in log space and visited in availability rank order. **/
+int Callback::lift(IloNumMatrix& xSol, const double& availabilityRequired, std::vector<Callback::MapAvailability>& sectionAvailability, const int& nbSections, const int& variant)
 {
-    for (int s = 0; s < nbSections; ++s){
-        int i = sectionAvailability[s].section;
-        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-            int v = data.getNodeId(n);
-            /* If the i-th vnf is not placed on node v */
-            if (xSol[i][v] < 1 - EPS){
-                /* Compute the availability obtained if a i-th vnf was placed on node v*/
-                double futureAvailability = 1.0;
-                double futureAvailabilityOfSection = sectionAvailability[s].availability;
-                for (int j = 0; j < nbSections; ++j){
-                    if (s == j){
-                        double newFailureRate = (1.0 - sectionAvailability[j].availability)*(1.0 - data.getNode(v).getAvailability());
-                        futureAvailabilityOfSection = (1.0 - newFailureRate);
-                        futureAvailability *= futureAvailabilityOfSection;
-                    }
-                    else{
-                        futureAvailability *= sectionAvailability[j].availability;
-                    }
-                }
-                /* If the availability would still be violated */
-                if (futureAvailability < availabilityRequired){
-                    /* Place vnf */
-                    xSol[i][v] = 1;
-                    sectionAvailability[s].availability = futureAvailabilityOfSection;
-                }
+    return kernel.lift(xSol, availabilityRequired, sectionAvailability, nbSections, variant);
+}
+
+/** Builds the no-good inequality forbidding the placement stored in xSol over the given sections. **/
+void Callback::buildAvailabilityNoGood(const int k, const IloNumMatrix& xSol, const std::vector<MapAvailability>& sectionAvailability, const int nbSections, IloExpr& exp, std::vector<int>& signature)
+{
+    const int NB_NODES = data.getNbNodes();
+    const std::vector< std::pair<int, int> > SUPPORT = kernel.getNoGoodSupport(xSol, sectionAvailability, nbSections);
+    signature.clear();
+    signature.push_back(k);
+    for (unsigned int j = 0; j < SUPPORT.size(); ++j){
+        const int i = SUPPORT[j].first;
+        const int v = SUPPORT[j].second;
+        exp += x[k][i][v];
+        signature.push_back(i*NB_NODES + v);
+    }
+    std::sort(signature.begin() + 1, signature.end());
+}
+
+/** Generates additional lifted variants of a violated availability constraint and stores them in the cut pool. **/
+void Callback::addLiftedVariantsToPool(const int k, const int nbSections, const std::vector<MapAvailability>& sectionAvailability, const std::vector<int>& baseSignature, const int depth)
+{
+    const double REQUIRED_AVAIL = data.getDemand(k).getAvailability();
+    const int    NB_VARIANTS    = std::min(data.getInput().getNbLiftingVariants(), 2*nbSections);
+    for (int variant = 1; variant < NB_VARIANTS; ++variant){
+        IloNumMatrix liftedSolution = xSol[k];
+        std::vector<MapAvailability> liftedAvailability = sectionAvailability;
+        {
+            SeparationProfile::Scope scope(separationProfile, SeparationProfile::ROUTINE_LIFTING, depth);
+            scope.setProduced(lift(liftedSolution, REQUIRED_AVAIL, liftedAvailability, nbSections, variant));
+        }
+
+        IloExpr exp(env);
+        std::vector<int> signature;
+        buildAvailabilityNoGood(k, liftedSolution, liftedAvailability, nbSections, exp, signature);
+        if (signature != baseSignature){
+            std::string name = "LiftedAvail(" + std::to_string(k) + "," + std::to_string(variant) + ")";
+            IloRange cut(env, 1.0, exp, IloInfinity, name.c_str());
+            if (addToCutPool(cut, signature)){
+                recordCut(exp, 1.0, "LiftedAvail");
+            }
+            else{
+                /* Already in the pool */
+                cut.end();
             }
         }
+        exp.end();
     }
 }
 
 /** Returns the availability of the i-th section of a SFC demand obtained from an integer solution. @param k The demand id. @param i The section id. @param xSol The current integer solution. **/
 double Callback::getAvailabilityOfSection(const int& k, const int& i, const IloNum3DMatrix& xSol) const
 {
-    double failure_prob = 1.0;
-    for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-        int v = data.getNodeId(n);
-        if (xSol[k][i][v] >= 1 - EPS){
-            failure_prob *= (1.0 - data.getNode(v).getAvailability());
-        }
-    }
-    double availability = 1.0 - failure_prob;
-    return availability;
+    return kernel.getAvailabilityOfSection(xSol[k][i]);
 }
 
 /* Returns the availabilities of the sections of a SFC demand obtained from an integer solution. */
 std::vector<Callback::MapAvailability> Callback::getAvailabilitiesOfSections (const int& k, const IloNum3DMatrix& xSol) const
 {   
-    std::vector<MapAvailability> sectionAvailability;
-    for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-        MapAvailability entry;
-        entry.section = i;
-        entry.availability = getAvailabilityOfSection(k,i, xSol);
-        sectionAvailability.push_back(entry);
-    }
-    return sectionAvailability;
+    return kernel.getAvailabilitiesOfSections(xSol[k]);
 }
 
 /** Returns the current integer solution. @note Should only be called within candidate context. **/ 
@@ -817,7 +973,7 @@ void Callback::getIntegerSolution(const Context &context)
                 for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
                     for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
                         int v = data.getNodeId(n);
-                        xSol[k][i][v] = context.getCandidatePoint(x[k][i][v]);
+                        xSol[k][i][v] = (presolve.isAssignable(k, i, v) ? context.getCandidatePoint(x[k][i][v]) : 0.0);
                     }
                 }
             }
@@ -840,7 +996,7 @@ void Callback::getFractionalSolution(const Context &context)
             for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
                 for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
                     int v = data.getNodeId(n);
-                    xSol[k][i][v] = context.getRelaxationPoint(x[k][i][v]);
+                    xSol[k][i][v] = (presolve.isAssignable(k, i, v) ? context.getRelaxationPoint(x[k][i][v]) : 0.0);
                 }
             }
         }
@@ -865,10 +1021,11 @@ const bool Callback::isIntegerAssignment(const int& k, const IloNum3DMatrix& xSo
 }
 
 
-void Callback::incrementLazyConstraints()
+void Callback::incrementLazyConstraints(const std::string& family)
 {
     thread_flag.lock();
     ++nbLazyConstraints;
+    ++nbCutsPerFamily[family];
     thread_flag.unlock();
 }
 
@@ -879,10 +1036,11 @@ void Callback::incrementAvailabilityCutsHeuristic()
     thread_flag.unlock();
 }
 
-void Callback::incrementUsercuts()
+void Callback::incrementUsercuts(const std::string& family)
 {
     thread_flag.lock();
     ++nbCuts;
+    ++nbCutsPerFamily[family];
     thread_flag.unlock();
 }
 
@@ -893,7 +1051,100 @@ void Callback::incrementTime(const IloNum time)
     thread_flag.unlock();
 }
 
-bool compareAvailability(Callback::MapAvailability a, Callback::MapAvailability b)
+bool Callback::addToCutPool(const IloRange& cut, const std::vector<int>& signature)
+{
+    std::lock_guard<std::mutex> lock(pool_flag);
+    if (poolSignatures.insert(signature).second == false){
+        return false;
+    }
+    cutPool.add(cut);
+    ++nbLiftedCuts;
+    return true;
+}
+
+/****************************************************************************************/
+/*							Outer Approximation Methods  	    						*/
+/****************************************************************************************/
+
+/** Separates tangent cuts on log(secAvail) and log(secUnavail) at the current point. **/
+bool Callback::tangentSeparation(const Context &context)
+{
+    const bool RELAXATION = (context.getId() == Context::Id::Relaxation);
+    bool found = false;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            double avail, logAvail, unavail, logUnavail;
+            if (RELAXATION){
+                avail       = context.getRelaxationPoint(secAvail[k][i]);
+                logAvail    = context.getRelaxationPoint(logSecAvail[k][i]);
+                unavail     = context.getRelaxationPoint(secUnavail[k][i]);
+                logUnavail  = context.getRelaxationPoint(logSecUnavail[k][i]);
+            }
+            else{
+                avail       = context.getCandidatePoint(secAvail[k][i]);
+                logAvail    = context.getCandidatePoint(logSecAvail[k][i]);
+                unavail     = context.getCandidatePoint(secUnavail[k][i]);
+                logUnavail  = context.getCandidatePoint(logSecUnavail[k][i]);
+            }
+            if (addTangentCut(context, logSecAvail[k][i], secAvail[k][i], logAvail, avail)){
+                found = true;
+            }
+            if (addTangentCut(context, logSecUnavail[k][i], secUnavail[k][i], logUnavail, unavail)){
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+/** Adds the tangent of log at z0 as a cut, if it is violated by the given point. **/
+bool Callback::addTangentCut(const Context &context, const IloNumVar& w, const IloNumVar& z, const double wVal, const double zVal)
+{
+    const double TOUCH = std::max(zVal, EPSILON);
+    if (wVal <= std::log(TOUCH) + EPSILON){
+        return false;
+    }
+    // w <= log(z0) + (z - z0)/z0
+    IloRange cut(env, -IloInfinity, w - (1.0/TOUCH)*z, std::log(TOUCH) - 1.0);
+    if (context.getId() == Context::Id::Relaxation){
+        context.addUserCut(cut, IloCplex::UseCutPurge, IloFalse);
+        incrementUsercuts("Tangent");
+    }
+    else{
+        context.rejectCandidate(cut);
+        incrementLazyConstraints("Tangent");
+    }
+    thread_flag.lock();
+    nbTangentCuts++;
+    thread_flag.unlock();
+    cut.end();
+    return true;
+}
+
+/****************************************************************************************/
+/*							    Benders Methods    	    	    						*/
+/****************************************************************************************/
+
+/** Solves the routing subproblem of each demand for the current candidate and rejects it with the feasibility cuts found. **/
+bool Callback::bendersSeparation(const Context &context)
 {
-    return (a.availability < b.availability);
-}
\ No newline at end of file
+    getIntegerSolution(context);
+    const std::vector<Benders::Cut> cuts = benders.solve(xSol);
+    for (unsigned int c = 0; c < cuts.size(); c++){
+        /* sum(1 - x) >= 1 over the critical nodes of the demand */
+        IloExpr exp(env);
+        for (unsigned int t = 0; t < cuts[c].terms.size(); t++){
+            exp -= x[cuts[c].demand][cuts[c].terms[t].first][cuts[c].terms[t].second];
+        }
+        const double LB = 1.0 - (double)cuts[c].terms.size();
+        IloRange cut(env, LB, exp, IloInfinity);
+        context.rejectCandidate(cut);
+        thread_flag.lock();
+        nbBendersCuts++;
+        nbCutsPerFamily["BendersLatency"]++;
+        thread_flag.unlock();
+        /* Not cached: the cut depends on the links and delays, which the cache fingerprint ignores. */
+        exp.end();
+    }
+    return !cuts.empty();
+}
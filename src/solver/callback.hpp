@@ -8,6 +8,8 @@
 /*** C++ Libraries ***/
 #include <thread>
 #include <mutex>
+#include <set>
+#include <map>
 
 /*** CPLEX Libraries ***/
 #include <ilcplex/ilocplex.h>
@@ -15,7 +17,13 @@ ILOSTLBEGIN
 
 /*** Own Libraries ***/
 #include "../instance/data.hpp"
+#include "../instance/presolve.hpp"
 #include "../tools/others.hpp"
+#include "../tools/random.hpp"
+#include "cutcache.hpp"
+#include "benders.hpp"
+#include "separationprofile.hpp"
+#include "availabilitykernel.hpp"
 
 /****************************************************************************************/
 /*										TYPEDEFS										*/
@@ -53,6 +61,7 @@ private:
     /*** General variables ***/
     const IloEnv&   env;    /**< IBM environment **/
     const Data&     data;   /**< Data read in data.hpp **/
+    const Presolve& presolve; /**< Assignments removed before the model was built **/
 
 
     /*** LP data ***/
@@ -60,8 +69,20 @@ private:
 	const IloNumVarMatrix&      y;                  /**< VNF assignement variables **/
     const IloNumVarMatrix&      secAvail;			/**< Real variable between 0 and 1 representing the availability of a section**/
     const IloNumVarMatrix&      secUnavail;			/**< Real variable between 0 and 1 representing the unavailability of a section**/
+    const IloNumVarMatrix&      logSecAvail;		/**< Real variable bounded by log(secAvail), used by the outer approximation **/
+    const IloNumVarMatrix&      logSecUnavail;		/**< Real variable bounded by log(secUnavail), used by the outer approximation **/
     	
     IloRangeArray cutPool;                          /**< Cutpool to be checked on each node. **/
+    std::set< std::vector<int> > poolSignatures;    /**< Signatures of the lifted cuts already stored in the pool. **/
+
+    /*** Node cover templates ***/
+    std::map< double, std::pair<int,int> > coverClasses;   /**< First template and number of templates of each SLA. **/
+    std::vector<int>    coverCoeffs;                /**< Coefficients of every template, template t stored at [t*NB_NODES, (t+1)*NB_NODES). **/
+    std::vector<int>    coverRhs;                   /**< Right-hand side of each template. **/
+    std::vector<int>    coverNode;                  /**< Node v defining each template. **/
+    CutCache cutCache;                              /**< Cuts generated so far, stored by demand and node names. **/
+    Benders  benders;                               /**< Routing subproblems of the Benders decomposition. **/
+    std::unordered_map<IloInt, std::vector<int> > varIndex; /**< Maps the id of an assignment variable x[k][i][v] to its indexes {k, i, v}. **/
 
     
     /*** Solution data ***/
@@ -69,12 +90,21 @@ private:
     IloNum3DMatrix      xSol;               /**< Stores the x variables from a given solution **/
     double              objSol;             /**< Stores the objective function value from a given solution **/
     std::vector<double> remainingCapacity;  /**< Stores the remaining capacity of each node in the graph **/
+    AvailabilityKernel  kernel;             /**< Availability computations on integer solutions, including the lifting procedure **/
 
     /*** Manage execution and control ***/
     std::mutex  thread_flag;                /**< A mutex for synchronizing multi-thread operations. **/
+    std::mutex  pool_flag;                  /**< A mutex protecting the cut pool, which may grow during the optimization. **/
+    uint32_t    nbHeuristicCalls;           /**< Number of matheuristic calls so far. Protected by thread_flag. **/
     int         nb_cuts_avail_heuristic;    /**< Number of availability cuts added through heuristic procedure. **/
     int         nbLazyConstraints;          /**< Number of lazy constraints added. **/
     int         nbCuts;                     /**< Total number of user cuts added. **/
+    int         nbLiftedCuts;               /**< Number of lifted availability cuts stored in the pool. **/
+    int         nbTangentCuts;              /**< Number of outer approximation tangent cuts added. **/
+    int         nbExactRejections;          /**< Number of candidates accepted by the availability approximation but rejected by the exact availability check. **/
+    int         nbBendersCuts;              /**< Number of Benders feasibility cuts added. **/
+    std::map<std::string, int> nbCutsPerFamily; /**< Number of lazy constraints and user cuts added, by family. **/
+    SeparationProfile separationProfile;    /**< Calls, time and success of each separation routine, by node depth. **/
     IloNum      timeAll;                    /**< Total time spent on callback. **/
 
 
@@ -84,19 +114,17 @@ public:
 	/*										Constructors									*/
 	/****************************************************************************************/
     /** Constructor. Initializes callback variables. **/
-	Callback(const IloEnv& env_, const Data& data_, 
+	Callback(const IloEnv& env_, const Data& data_, const Presolve& presolve_,
                 const IloNumVar3DMatrix& x_, const IloNumVarMatrix& y_,
-                const IloNumVarMatrix& secAvail_, const IloNumVarMatrix& secUnavail_);
+                const IloNumVarMatrix& secAvail_, const IloNumVarMatrix& secUnavail_,
+                const IloNumVarMatrix& logSecAvail_, const IloNumVarMatrix& logSecUnavail_);
 
 
     /****************************************************************************************/
 	/*									Auxliary Structs     								*/
 	/****************************************************************************************/
     /** Stores the section id and its availability. Used for the separation of integer solutions. **/
-    struct MapAvailability { 
-        int section;            /**< The section id.*/
-        double availability;    /**< The section availability. */
-    }; 
+    typedef AvailabilityKernel::MapAvailability MapAvailability;
 
 
 	/****************************************************************************************/
@@ -123,17 +151,20 @@ public:
     /** Checks whether the current solution satisfies all cuts in the pool and add the unsatisfied one. **/
     bool    checkCutPool            (const Context &context);
 
+    /** Returns the branch and bound depth of the current node, or 0 if the separation profile is disabled. **/
+    int     getNodeDepth            (const Context &context) const;
+
 	/****************************************************************************************/
 	/*							Heuristic Related Methods  				    			    */
 	/****************************************************************************************/
     /** Launches the phase I of the matheuristic procedure.**/
-    void    runHeuristic_Phase_I    (const Context& context);
+    void    runHeuristic_Phase_I    (const Context& context, Random& rng);
 
     /** Launches the phase II of the matheuristic procedure. Returns true if a feasible solution was found. **/
     bool    runHeuristic_Phase_II   (const Context& context);
 
     /** Checks if the heuristic should be launched. **/
-    bool    heuristicRule           (const Context &context);
+    bool    heuristicRule           (const Context &context, Random& rng);
 
     /** Posts an heuristic solution into the optimization procedure. **/
     void    insertHeuristicSolution (const Context &context);
@@ -141,8 +172,8 @@ public:
     /** Returns the availability of SFC k obtained from the solution stored in xSol. @note least will store the index of the least available section of the SFC **/
     double  getSolutionAvail_k      (int k, int& least);
 
-    /** Chooses on which node VNF f should be installed for demand k **/
-    int     getNodeToInstall        (int f, int k);
+    /** Chooses on which node VNF f should be installed for section i of demand k **/
+    int     getNodeToInstall        (int f, int k, int i);
 
 	/****************************************************************************************/
 	/*							Cut Pool Definition Methods  							    */
@@ -152,6 +183,9 @@ public:
 
     /** Add (some) availability cover constraints to the cut pool. Only sets {j \in V : a(j) <= a(v) } for each v \in V are considered. **/
     void addAvailabilityCoverConstraints ();
+
+    /** Builds the availability cover templates shared by every demand with the same SLA. Returns the first template and the number of templates of the class. **/
+    const std::pair<int,int>& getCoverTemplates (const double sla);
     
     /** Add vnf lower bound constraints to the cut pool. @note These are chain cover constraints where the set of considered sections is the whole set of sections, i.e., Q = I. **/
     void addVnfLowerBoundConstraints ();
@@ -159,6 +193,18 @@ public:
     /** Add section failure constraints to the cut pool. **/
     void addSectionFailureConstraints ();
 
+	/****************************************************************************************/
+	/*							    Cut Cache Methods    							        */
+	/****************************************************************************************/
+    /** Stores a generated cut in the cut cache. @param exp The cut left-hand side. @param lb The cut right-hand side. @param family The cut family. @note Only cuts over assignment variables are stored. **/
+    void recordCut      (const IloExpr& exp, const double lb, const std::string& family);
+
+    /** Preloads the cuts stored in the cut cache file into the cut pool. **/
+    void loadCutCache   ();
+
+    /** Writes the cuts generated so far (and the ones preloaded) to the cut cache file. **/
+    void saveCutCache   ();
+
 	/****************************************************************************************/
 	/*							Availability Separation Methods  							*/
 	/****************************************************************************************/
@@ -171,8 +217,29 @@ public:
     /** Computes the availability increment resulted from the instalation of a new vnf. @param CHAIN_AVAIL The chain required availability. @param deltaAvail The matrix to be computed. @param sectionAvail THe current section availabilities. @param coeff The matrix of coefficients storing the possible vnfs to be placed. **/
     void computeDeltaAvailability(const double CHAIN_AVAIL, std::vector< std::vector<double> >& deltaAvail, const std::vector< double >& sectionAvail, const std::vector< std::vector<int> >& coeff);
     
-    /** Tries to add new vnf placements to the current solution without changing its availability violation. @param xSol The current solution for a given demand. @param availabilityRequired The SFC required availability. @param sectionAvailability The current section availabilities. @param nbSections The number of sections that can be modified. **/
-    void lift(IloNumMatrix& xSol, const double& availabilityRequired, std::vector<MapAvailability>& sectionAvailability, const int& nbSections);
+    /** Tries to add new vnf placements to the current solution without changing its availability violation. Candidates are evaluated in log space and visited in availability rank order. @param xSol The current solution for a given demand. @param availabilityRequired The SFC required availability. @param sectionAvailability The current section availabilities. @param nbSections The number of sections that can be modified. @param variant Defines the order in which candidates are visited: even variants follow the availability ranking, odd variants the reverse ranking, and the starting section is rotated by variant/2. Returns the number of placements added. **/
+    int  lift(IloNumMatrix& xSol, const double& availabilityRequired, std::vector<MapAvailability>& sectionAvailability, const int& nbSections, const int& variant = 0);
+
+    /** Builds the no-good inequality forbidding the placement stored in xSol over the given sections. @param k The demand id. @param xSol The (lifted) solution of demand k. @param sectionAvailability The sections sorted by availability. @param nbSections The number of sections involved. @param exp Stores the left-hand side of the inequality, whose right-hand side is 1. @param signature Stores the indexes of the variables appearing in the inequality. **/
+    void buildAvailabilityNoGood(const int k, const IloNumMatrix& xSol, const std::vector<MapAvailability>& sectionAvailability, const int nbSections, IloExpr& exp, std::vector<int>& signature);
+
+    /** Generates additional lifted variants of a violated availability constraint and stores them in the cut pool. @param k The demand id. @param nbSections The number of sections involved. @param sectionAvailability The sections sorted by availability before lifting. @param baseSignature The signature of the inequality already separated. @param depth The depth of the node being separated. **/
+    void addLiftedVariantsToPool(const int k, const int nbSections, const std::vector<MapAvailability>& sectionAvailability, const std::vector<int>& baseSignature, const int depth);
+
+	/****************************************************************************************/
+	/*							Outer Approximation Methods  	    						*/
+	/****************************************************************************************/
+    /** Separates tangent cuts w <= log(z0) + (z - z0)/z0 on (logSecAvail, secAvail) and (logSecUnavail, secUnavail) at the current point. Cuts are added as user cuts in relaxation context and used to reject the candidate in candidate context. Returns true if a violated tangent was found. **/
+    bool tangentSeparation(const Context &context);
+
+    /** Adds the tangent of log at z0 as a cut, if it is violated by the given point. Returns true if the cut was added. @param w The variable bounded by log(z). @param z The variable whose logarithm is approximated. @param wVal The value of w. @param zVal The value of z, used as tangent point. **/
+    bool addTangentCut(const Context &context, const IloNumVar& w, const IloNumVar& z, const double wVal, const double zVal);
+
+	/****************************************************************************************/
+	/*							    Benders Methods    	    	    						*/
+	/****************************************************************************************/
+    /** Solves the routing subproblem of each demand for the current candidate and rejects it with the feasibility cuts found. Returns true if a cut was added. @note Should only be called within candidate context. **/
+    bool bendersSeparation(const Context &context);
 
 	/****************************************************************************************/
 	/*							    Cover Separation Methods    							*/
@@ -202,6 +269,24 @@ public:
     /** Returns the number of lazy constraints added so far. **/ 
     const int    getNbLazyConstraints()    const{ return nbLazyConstraints; }
 
+    /** Returns the number of lifted availability cuts stored in the pool so far. **/ 
+    const int    getNbLiftedCuts()         const{ return nbLiftedCuts; }
+
+    /** Returns the number of candidates rejected by the exact availability check while an approximation is used. **/ 
+    const int    getNbExactRejections()    const{ return nbExactRejections; }
+
+    /** Returns the number of outer approximation tangent cuts added so far. **/ 
+    const int    getNbTangentCuts()        const{ return nbTangentCuts; }
+
+    /** Returns the number of Benders feasibility cuts added so far. **/ 
+    const int    getNbBendersCuts()        const{ return nbBendersCuts; }
+
+    /** Returns the number of lazy constraints and user cuts added so far, by family. **/ 
+    const std::map<std::string, int>& getNbCutsPerFamily() const{ return nbCutsPerFamily; }
+
+    /** Returns the calls, time and success of each separation routine, by node depth. **/ 
+    SeparationProfile& getSeparationProfile()      { return separationProfile; }
+
     /** Returns the total time spent on callback so far. **/ 
     const IloNum getTime()                 const{ return timeAll; }
 
@@ -212,14 +297,16 @@ public:
 	/****************************************************************************************/
 	/*								Thread Protected Methods			    				*/
 	/****************************************************************************************/
-    /** Increase by one the number of lazy constraints added. **/
-    void incrementLazyConstraints();
+    /** Increase by one the number of lazy constraints added. @param family The family of the constraint. **/
+    void incrementLazyConstraints(const std::string& family);
     /** Increase by one the number of availability cuts added through the heuristic procedure. **/
     void incrementAvailabilityCutsHeuristic();
-    /** Increase by one the number of user cuts added. **/
-    void incrementUsercuts();
+    /** Increase by one the number of user cuts added. @param family The family of the cut. **/
+    void incrementUsercuts(const std::string& family);
     /** Increases the total callback time. @param time The time to be added. **/
     void incrementTime(const IloNum time);
+    /** Adds a cut to the pool unless a cut with the same signature is already there. Returns true if the cut was added. @param cut The cut to be added. @param signature The indexes of the variables appearing in the cut. **/
+    bool addToCutPool(const IloRange& cut, const std::vector<int>& signature);
 
 	/****************************************************************************************/
 	/*										Destructors			    						*/
@@ -229,7 +316,4 @@ public:
 
 };
 
-/** Checks if the availability of a is lower than the one of b. **/
-bool compareAvailability(Callback::MapAvailability a, Callback::MapAvailability b);
-
 #endif
\ No newline at end of file
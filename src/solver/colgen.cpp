@@ -0,0 +1,317 @@
+#include "colgen.hpp"
+
+#define RC_EPSILON  1e-6    // Minimum reduced cost improvement for a column to be added
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Builds the restricted master problem, without columns. */
+ColumnGeneration::ColumnGeneration(const IloEnv& env_, const Data& data_) :
+                env(env_), model(env), cplex(model), data(data_), obj(env), lambda(env), artificial(env),
+                convexity(env), capacity(env), nbIterations(0), lpValue(0.0), lagrangianBound(0.0), bestValue(0.0), bestBound(0.0),
+                time(0.0), buildTime(0.0), found(false), best(data_),
+                pricer(data_, data_.getInput().getPricingGrid(), PatternPricer::ROUNDING_CONSERVATIVE),
+                boundPricer(data_, data_.getInput().getPricingGrid(), PatternPricer::ROUNDING_OPTIMISTIC)
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-              Building column generation master.               -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+        std::cout << "WARNING: Column generation does not model routing. Latency constraints are ignored." << std::endl;
+    }
+    const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+    buildMaster();
+    addInitialColumns();
+    cplex.setOut(env.getNullStream());
+    cplex.setParam(IloCplex::Param::Threads, data.getInput().getThreads());
+    buildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count();
+    std::cout << std::endl << "Master was correctly built ! " << std::endl;
+}
+
+/* Set up the placement variables, the objective and the linking constraints. */
+void ColumnGeneration::buildMaster()
+{
+    /* Placement variables and objective. */
+    IloExpr exp(env);
+    double bigM = 1.0;
+    y.resize(data.getNbNodes());
+    for (int v = 0; v < data.getNbNodes(); v++){
+        y[v].resize(data.getNbVnfs());
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            std::string name = "y(" + std::to_string(v) + "," + std::to_string(data.getVnf(f).getId()) + ")";
+            y[v][f] = IloNumVar(env, 0.0, 1.0, ILOFLOAT, name.c_str());
+            const double COST = data.getPlacementCost(data.getNode(v), data.getVnf(f));
+            exp += COST * y[v][f];
+            bigM += COST;
+        }
+    }
+    obj.setExpr(exp);
+    obj.setSense(IloObjective::Minimize);
+    model.add(obj);
+    exp.end();
+
+    /* One pattern per demand; artificial variables cost more than any placement. */
+    for (int k = 0; k < data.getNbDemands(); k++){
+        std::string name = "Convexity(" + std::to_string(k) + ")";
+        convexity.add(IloRange(env, 1.0, 1.0, name.c_str()));
+    }
+    model.add(convexity);
+    for (int k = 0; k < data.getNbDemands(); k++){
+        std::string name = "artificial(" + std::to_string(k) + ")";
+        artificial.add(IloNumVar(obj(bigM) + convexity[k](1.0), 0.0, IloInfinity, ILOFLOAT, name.c_str()));
+    }
+
+    /* Node capacity: the linking constraint between demands. */
+    for (int v = 0; v < data.getNbNodes(); v++){
+        std::string name = "Node_Capacity(" + std::to_string(v) + ")";
+        capacity.add(IloRange(env, -IloInfinity, data.getNode(v).getCapacity(), name.c_str()));
+    }
+    model.add(capacity);
+
+    /* A section can only use node v if its vnf is placed on v. */
+    linking.resize(data.getNbDemands());
+    for (int k = 0; k < data.getNbDemands(); k++){
+        linking[k].resize(data.getDemand(k).getNbVNFs());
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            linking[k][i].resize(data.getNbNodes());
+            const int f = data.getDemand(k).getVNF_i(i);
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (!pricer.isEligible(k, i, v)) continue;
+                IloExpr link(env);
+                link -= y[v][f];
+                std::string name = "VNF_Placement(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(v) + ")";
+                linking[k][i][v] = IloRange(env, -IloInfinity, link, 0.0, name.c_str());
+                model.add(linking[k][i][v]);
+                link.end();
+            }
+        }
+    }
+}
+
+/* Adds initial columns: those of the greedy heuristic, if it finds a solution. */
+void ColumnGeneration::addInitialColumns()
+{
+    Greedy greedy(data);
+    if (!greedy.run(data.getInput().getGreedyStartWorkers(), data.getInput().getGreedyStartIterations(), data.getInput().getRandomSeed())){
+        return;
+    }
+    for (int k = 0; k < data.getNbDemands(); k++){
+        Column column;
+        column.demand = k;
+        column.nodes.resize(data.getDemand(k).getNbVNFs());
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (greedy.getBest().isAssigned(k, i, v)) column.nodes[i].push_back(v);
+            }
+        }
+        addColumn(column);
+    }
+}
+
+/* Adds a column to the restricted master problem. */
+void ColumnGeneration::addColumn(const Column& column)
+{
+    const int k = column.demand;
+    std::vector<double> load(data.getNbNodes(), 0.0);
+    IloNumColumn col = obj(0.0) + convexity[k](1.0);
+    for (unsigned int i = 0; i < column.nodes.size(); i++){
+        for (unsigned int j = 0; j < column.nodes[i].size(); j++){
+            const int v = column.nodes[i][j];
+            load[v] += pricer.getLoad(k, i);
+            col += linking[k][i][v](1.0);
+        }
+    }
+    for (int v = 0; v < data.getNbNodes(); v++){
+        if (load[v] > 0.0) col += capacity[v](load[v]);
+    }
+    std::string name = "lambda(" + std::to_string(k) + "," + std::to_string(columns.size()) + ")";
+    lambda.add(IloNumVar(col, 0.0, 1.0, ILOFLOAT, name.c_str()));
+    columns.push_back(column);
+    col.end();
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Generates columns until no improving column is found, then solves the integer master over the generated columns. */
+void ColumnGeneration::run()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                Running column generation.                     -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const double TIME_LIMIT = data.getInput().getTimeLimit();
+
+    /* Column generation on the LP relaxation of the master. */
+    IloNumArray mu(env), pi(env);
+    for (nbIterations = 0; nbIterations < data.getInput().getColgenMaxIterations(); nbIterations++){
+        if (!cplex.solve()){
+            std::cout << "ERROR: The restricted master could not be solved." << std::endl;
+            break;
+        }
+        lpValue = cplex.getObjValue();
+        cplex.getDuals(mu, convexity);
+        cplex.getDuals(pi, capacity);
+
+        /* Every demand is priced with the duals of the same LP; columns are added afterwards. */
+        std::vector<Column> improving;
+        double minReducedCost = 0.0;
+        /* Lasdon bound: the LP value plus, for each demand, a lower bound on its most negative reduced cost. */
+        double bound = lpValue;
+        for (int k = 0; k < data.getNbDemands(); k++){
+            std::vector< std::vector<double> > weight(data.getDemand(k).getNbVNFs(), std::vector<double>(data.getNbNodes(), 0.0));
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                for (int v = 0; v < data.getNbNodes(); v++){
+                    if (!pricer.isEligible(k, i, v)) continue;
+                    weight[i][v] = std::max(-pi[v] * pricer.getLoad(k, i) - cplex.getDual(linking[k][i][v]), 0.0);
+                }
+            }
+            std::vector< std::vector<int> > relaxedNodes;
+            const double RELAXED_WEIGHT = boundPricer.solve(k, weight, relaxedNodes);
+            if (RELAXED_WEIGHT != DBL_MAX){
+                bound += std::min(RELAXED_WEIGHT - mu[k], 0.0);
+            }
+
+            Column column;
+            column.demand = k;
+            const double WEIGHT = pricer.solve(k, weight, column.nodes);
+            if (WEIGHT == DBL_MAX) continue;
+            const double REDUCED_COST = WEIGHT - mu[k];
+            minReducedCost = std::min(minReducedCost, REDUCED_COST);
+            if (REDUCED_COST < -RC_EPSILON && getAvailability(column) >= data.getDemand(k).getAvailability()){
+                improving.push_back(column);
+            }
+        }
+        for (unsigned int c = 0; c < improving.size(); c++){
+            addColumn(improving[c]);
+        }
+        const int added = (int)improving.size();
+        lagrangianBound = std::max(lagrangianBound, bound);
+        std::cout << "\t Iteration " << nbIterations << ": master LP " << lpValue << ", Lagrangian bound " << bound << ", " << added
+                  << " columns added, min reduced cost " << minReducedCost << "." << std::endl;
+        if (added == 0) break;
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > TIME_LIMIT) break;
+    }
+    mu.end();
+    pi.end();
+
+    /* Price-and-branch: integer master over the generated columns. */
+    std::cout << "Solving integer master over " << columns.size() << " columns..." << std::endl;
+    IloNumVarArray placement(env);
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            placement.add(y[v][f]);
+        }
+    }
+    model.add(IloConversion(env, lambda, ILOINT));
+    model.add(IloConversion(env, placement, ILOINT));
+    for (int k = 0; k < data.getNbDemands(); k++){
+        artificial[k].setUB(0.0);
+    }
+    const double ELAPSED = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    cplex.setParam(IloCplex::Param::TimeLimit, std::max(TIME_LIMIT - ELAPSED, 1.0));
+    cplex.setOut(env.out());
+    if (cplex.solve()){
+        found     = true;
+        bestValue = cplex.getObjValue();
+        bestBound = cplex.getBestObjValue();
+        best.clear();
+        for (unsigned int c = 0; c < columns.size(); c++){
+            if (cplex.getValue(lambda[c]) < 0.5) continue;
+            for (unsigned int i = 0; i < columns[c].nodes.size(); i++){
+                for (unsigned int j = 0; j < columns[c].nodes[i].size(); j++){
+                    best.assign(columns[c].demand, i, columns[c].nodes[i][j]);
+                }
+            }
+        }
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Returns the exact chain availability of a column. */
+double ColumnGeneration::getAvailability(const Column& column) const
+{
+    std::vector<double> sectionAvail(column.nodes.size());
+    for (unsigned int i = 0; i < column.nodes.size(); i++){
+        sectionAvail[i] = data.getParallelAvailability(column.nodes[i]);
+    }
+    return data.getChainAvailability(sectionAvail);
+}
+
+/****************************************************************************************/
+/*									Solution Query  									*/
+/****************************************************************************************/
+
+/* Displays the obtained results. */
+void ColumnGeneration::printResult()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                 Printing best solution found.                 -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    if (found){
+        best.print();
+    }
+    else{
+        std::cout << "No integer solution was found." << std::endl;
+    }
+    std::cout << std::endl << "Printing optimization informations..."                   << std::endl;
+    std::cout << "\t Master LP value:           " << lpValue                            << std::endl;
+    std::cout << "\t Lagrangian bound:          " << lagrangianBound                    << std::endl;
+    std::cout << "\t Objective value:           " << bestValue                          << std::endl;
+    std::cout << "\t Integer master bound:      " << bestBound                          << std::endl;
+    std::cout << "\t Iterations:                " << nbIterations                       << std::endl;
+    std::cout << "\t Columns generated:         " << columns.size()                     << std::endl;
+    std::cout << "\t Total time:                " << time << std::endl                  << std::endl;
+}
+
+/* Outputs the obtained results, in the same format as Model::output. */
+void ColumnGeneration::output()
+{
+    /* The master LP value is not a bound (grid-rounded pricing, early stop); the Lagrangian bound is. */
+    const double GAP = (found && bestValue > 0.0 ? (bestValue - lagrangianBound) / bestValue : 1.0);
+    int nbViolations = 0;
+    double maxViolation = 0.0;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        const double VIOLATION = data.getDemand(k).getAvailability() - best.getChainAvailability(k);
+        if (VIOLATION > 1e-12){
+            nbViolations++;
+            maxViolation = std::max(maxViolation, VIOLATION);
+        }
+    }
+    Results results(data, "colgen");
+    results.add("relax_type",       "COLGEN_" + std::to_string(data.getInput().getPricingGrid()), true);
+    results.add("time",             time,                                   true);
+    results.add("objective",        bestValue,                              true);
+    results.add("best_bound",       lagrangianBound,                        true);
+    results.add("gap",              GAP*100,                                true);
+    results.add("nodes",            0,                                      true);
+    results.add("nodes_left",       0,                                      true);
+    results.add("lazy_constraints", 0,                                      true);
+    results.add("user_cuts",        0,                                      true);
+    results.add("callback_time",    0.0,                                    true);
+    results.add("nb_avail_violations", nbViolations,                        true);
+    results.add("max_avail_violation", maxViolation,                        true);
+    results.add("build_time",       buildTime);
+    results.add("iterations",       nbIterations);
+    results.add("columns",          (long)columns.size());
+    results.add("cuts_per_family",  std::map<std::string, int>());
+    results.add("lifted_cuts",      0);
+    results.add("exact_rejections", 0);
+    results.write();
+}
+
+/* Writes the best solution found to the solution file. */
+void ColumnGeneration::exportSolution()
+{
+    const std::string solution_file = data.getInput().getSolutionFile();
+    if (solution_file.empty() || !found){
+        return;
+    }
+    std::cout << "Writting solution to file..." << std::endl;
+    best.write(solution_file);
+}
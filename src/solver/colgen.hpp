@@ -0,0 +1,121 @@
+#ifndef __colgen__hpp
+#define __colgen__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cmath>
+#include <chrono>
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/ilocplex.h>
+ILOSTLBEGIN
+
+/*** Own Libraries ***/
+#include "../heuristic/greedy.hpp"
+#include "pricing.hpp"
+#include "../tools/results.hpp"
+
+/****************************************************************************************/
+/*										TYPEDEFS										*/
+/****************************************************************************************/
+
+/*** CPLEX ***/
+typedef std::vector<IloNumVar>          IloNumVarVector;
+typedef std::vector<IloNumVarVector>    IloNumVarMatrix;
+typedef std::vector<IloRange>           IloRangeVector;
+typedef std::vector<IloRangeVector>     IloRangeMatrix;
+
+
+/************************************************************************************
+ * This class implements a column generation engine for the resilient VNF
+ * placement problem. Each column is a complete placement pattern of one SFC,
+ * i.e., the set of nodes assigned to each of its sections, whose chain
+ * availability meets the SLA. The restricted master problem selects one
+ * pattern per demand; node capacities and the placement variables y link the
+ * demands together. The pricing problem of a demand is solved by the dynamic
+ * program of PatternPricer with conservative rounding, so that every priced
+ * pattern is feasible; patterns are also checked against the exact chain
+ * availability before being added. The same dynamic program with optimistic
+ * rounding gives a lower bound on the reduced cost of every pattern, hence a
+ * Lagrangian bound at each iteration, valid even if the loop stops early.
+ * Once no improving column is found, the master is solved with integer
+ * variables over the generated columns (price-and-branch).
+ ************************************************************************************/
+class ColumnGeneration {
+
+public:
+    /** A placement pattern of one demand. **/
+    struct Column {
+        int                                 demand;     /**< The demand id. **/
+        std::vector< std::vector<int> >     nodes;      /**< The nodes assigned to each section. nodes[i] **/
+    };
+
+private:
+    /*** General features ***/
+    const IloEnv&       env;            /**< IBM environment **/
+    IloModel            model;          /**< IBM Model **/
+    IloCplex            cplex;          /**< IBM Cplex **/
+    const Data&         data;           /**< Data read from parameters files **/
+
+    /*** Restricted master problem ***/
+    IloObjective        obj;            /**< Objective function: placement cost **/
+    IloNumVarMatrix     y;              /**< VNF placement variables. y[v][f] **/
+    IloNumVarArray      lambda;         /**< Column variables, in the order of columns **/
+    IloNumVarArray      artificial;     /**< Artificial variables making the convexity constraints feasible. artificial[k] **/
+    IloRangeArray       convexity;      /**< One pattern per demand. convexity[k] **/
+    IloRangeArray       capacity;       /**< Node capacity. capacity[v] **/
+    std::vector<IloRangeMatrix> linking;/**< A section can only use node v if its vnf is placed on v. linking[k][i][v] **/
+    std::vector<Column> columns;        /**< The columns generated so far **/
+
+    /*** Execution ***/
+    int                 nbIterations;   /**< Number of column generation iterations **/
+    double              lpValue;        /**< Value of the last restricted master LP **/
+    double              lagrangianBound;/**< Best Lagrangian bound found over the iterations **/
+    double              bestValue;      /**< Value of the best integer solution found **/
+    double              bestBound;      /**< Best bound of the integer master **/
+    double              time;           /**< Time spent by the column generation and the integer master **/
+    double              buildTime;      /**< Time spent building the master and its initial columns **/
+    bool                found;          /**< True if an integer solution was found **/
+    Placement           best;           /**< The best integer solution found **/
+    PatternPricer       pricer;         /**< Solves the pricing problems **/
+    PatternPricer       boundPricer;    /**< Solves the pricing problems with optimistic rounding, for the Lagrangian bound **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Builds the restricted master problem, without columns. **/
+    ColumnGeneration(const IloEnv& env, const Data& data);
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+    /** Generates columns until no improving column is found, then solves the integer master over the generated columns. **/
+    void run();
+
+	/****************************************************************************************/
+	/*									Solution Query  									*/
+	/****************************************************************************************/
+    /** Displays the obtained results. **/
+    void printResult();
+    /** Outputs the obtained results, in the same format as Model::output. **/
+    void output();
+    /** Writes the best solution found to the solution file. **/
+    void exportSolution();
+
+private:
+    /** Set up the placement variables, the objective and the linking constraints. **/
+    void buildMaster();
+    /** Adds initial columns: those of the greedy heuristic, if it finds a solution. **/
+    void addInitialColumns();
+    /** Adds a column to the restricted master problem. **/
+    void addColumn(const Column& column);
+
+    /** Returns the exact chain availability of a column. **/
+    double getAvailability(const Column& column) const;
+};
+
+#endif
@@ -0,0 +1,317 @@
+#include "compact.hpp"
+#include "../heuristic/greedy.hpp"
+
+#define EPS 1e-4        // Tolerance used when reading variable values
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Builds the formulation in the backend. */
+CompactModel::CompactModel(const Data& data_, Backend& backend_) :
+                data(data_), backend(backend_), presolve(data_), kernel(data_), nbVariables(0),
+                nbLazy(0), nbCuts(0), status(Backend::STATUS_UNKNOWN), objValue(0.0), bestBound(0.0), nbNodes(0), time(0.0), buildTime(0.0)
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                   Building compact model.                     -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "Backend: " << backend.getName() << std::endl;
+    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+        std::cout << "WARNING: The compact model does not model routing. Latency constraints are ignored." << std::endl;
+    }
+    const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+    if (data.getInput().isPresolve()){
+        presolve.run();
+    }
+    if (presolve.isInfeasible()){
+        throw std::runtime_error("ERROR: Some demand cannot reach the availability required. The instance is infeasible.");
+    }
+    setVariables();
+    setConstraints();
+    backend.setSeparator(this, true, true);
+    buildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count();
+    std::cout << std::endl << "Model was correctly built ! " << std::endl;
+}
+
+/* Adds the placement and assignment variables. */
+void CompactModel::setVariables()
+{
+    std::cout << "\t > Setting up placement and assignment variables... " << std::endl;
+    y.resize(data.getNbNodes(), std::vector<int>(data.getNbVnfs()));
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            const double UB = (presolve.isPlaceable(v, f) ? 1.0 : 0.0);
+            const double COST = data.getPlacementCost(data.getNode(v), data.getVnf(f));
+            std::string name = "y(" + std::to_string(v) + "," + std::to_string(f) + ")";
+            y[v][f] = backend.addVariable(0.0, UB, COST, Backend::VAR_BINARY, name);
+            nbVariables = std::max(nbVariables, y[v][f] + 1);
+        }
+    }
+    x.resize(data.getNbDemands());
+    for (int k = 0; k < data.getNbDemands(); k++){
+        x[k].resize(data.getDemand(k).getNbVNFs(), std::vector<int>(data.getNbNodes()));
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                const double UB = (presolve.isAssignable(k, i, v) ? 1.0 : 0.0);
+                std::string name = "x(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(v) + ")";
+                x[k][i][v] = backend.addVariable(0.0, UB, 0.0, Backend::VAR_BINARY, name);
+                nbVariables = std::max(nbVariables, x[k][i][v] + 1);
+            }
+        }
+    }
+}
+
+/* Adds the assignment, placement and node capacity constraints. */
+void CompactModel::setConstraints()
+{
+    std::cout << "\t > Setting up VNF Assignment, VNF Placement and Node Capacity constraints... " << std::endl;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            const int f = data.getDemand(k).getVNF_i(i);
+            Backend::Row assignment;
+            assignment.lb = presolve.getMinNbNodes(k, i);
+            assignment.ub = Backend::getInfinity();
+            assignment.name = "VNF_Assignment(" + std::to_string(k) + "," + std::to_string(i) + ")";
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (!presolve.isAssignable(k, i, v)) continue;
+                assignment.vars.push_back(x[k][i][v]);
+                assignment.coefs.push_back(1.0);
+
+                Backend::Row placement;
+                placement.vars.push_back(x[k][i][v]);
+                placement.coefs.push_back(1.0);
+                placement.vars.push_back(y[v][f]);
+                placement.coefs.push_back(-1.0);
+                placement.lb = -Backend::getInfinity();
+                placement.ub = 0.0;
+                placement.name = "VNF_Placement(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(v) + ")";
+                backend.addRow(placement);
+            }
+            backend.addRow(assignment);
+        }
+    }
+    for (int v = 0; v < data.getNbNodes(); v++){
+        Backend::Row capacity;
+        capacity.lb = 0.0;
+        capacity.ub = data.getNode(v).getCapacity();
+        capacity.name = "Node_Capacity(" + std::to_string(v) + ")";
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                if (!presolve.isAssignable(k, i, v)) continue;
+                const int f = data.getDemand(k).getVNF_i(i);
+                capacity.vars.push_back(x[k][i][v]);
+                capacity.coefs.push_back(data.getDemand(k).getBandwidth() * data.getVnf(f).getConsumption());
+            }
+        }
+        backend.addRow(capacity);
+    }
+}
+
+/* Gives the greedy placement to the backend as a MIP start. */
+void CompactModel::setGreedyStart()
+{
+    Greedy greedy(data);
+    if (!greedy.run(data.getInput().getGreedyStartWorkers(), data.getInput().getGreedyStartIterations(), data.getInput().getRandomSeed())){
+        return;
+    }
+    const Placement& placement = greedy.getBest();
+    std::vector<double> values(nbVariables, 0.0);
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            if (!placement.isPlaced(v, f)) continue;
+            if (!presolve.isPlaceable(v, f)){
+                std::cout << "WARNING: The greedy placement violates the presolve fixings. It is not used as a MIP start." << std::endl;
+                return;
+            }
+            values[y[v][f]] = 1.0;
+        }
+    }
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (!placement.isAssigned(k, i, v)) continue;
+                if (!presolve.isAssignable(k, i, v)){
+                    std::cout << "WARNING: The greedy placement violates the presolve fixings. It is not used as a MIP start." << std::endl;
+                    return;
+                }
+                values[x[k][i][v]] = 1.0;
+            }
+        }
+    }
+    backend.setMipStart(values);
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Solves the formulation within the time limit. */
+void CompactModel::run()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                  Solving compact model.                       -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (data.getInput().isGreedyStart()){
+        setGreedyStart();
+    }
+    status = backend.solve(data.getInput().getTimeLimit(), data.getInput().getThreads());
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    nbNodes = backend.getNbNodes();
+    if (status != Backend::STATUS_INFEASIBLE){
+        bestBound = backend.getBestBound();
+    }
+    if (hasFound()){
+        objValue = backend.getObjValue();
+    }
+}
+
+/* Separates the availability no-goods violated by the point of the context. */
+void CompactModel::separate(Backend::Context& context)
+{
+    const bool CANDIDATE = context.isCandidate();
+    for (int k = 0; k < data.getNbDemands(); k++){
+        const int NB_SECTIONS = data.getDemand(k).getNbVNFs();
+        std::vector< std::vector<double> > xSol(NB_SECTIONS, std::vector<double>(data.getNbNodes(), 0.0));
+        for (int i = 0; i < NB_SECTIONS; i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (presolve.isAssignable(k, i, v)){
+                    xSol[i][v] = context.getValue(x[k][i][v]);
+                }
+            }
+        }
+
+        /* Find the smallest subset of sections violating the SFC availability, taking as placed the assignments at one. */
+        std::vector<MapAvailability> sectionAvailability = kernel.getAvailabilitiesOfSections(xSol);
+        const double REQUIRED_AVAIL = data.getDemand(k).getAvailability();
+        const int nbSelectedSections = kernel.selectViolatedSections(sectionAvailability, REQUIRED_AVAIL);
+        if (nbSelectedSections == 0) continue;
+
+        /* The no-good is valid whatever the point; a fractional point is only cut if it violates it. */
+        kernel.lift(xSol, REQUIRED_AVAIL, sectionAvailability, nbSelectedSections);
+        Backend::Row row = buildAvailabilityNoGood(k, xSol, sectionAvailability, nbSelectedSections);
+        if (CANDIDATE){
+            context.addLazy(row);
+            thread_flag.lock();
+            nbLazy++;
+            thread_flag.unlock();
+        }
+        else{
+            double activity = 0.0;
+            for (unsigned int j = 0; j < row.vars.size(); j++){
+                activity += context.getValue(row.vars[j]);
+            }
+            if (activity < 1.0 - EPS){
+                context.addCut(row);
+                thread_flag.lock();
+                nbCuts++;
+                thread_flag.unlock();
+            }
+        }
+    }
+}
+
+/* Returns the no-good forbidding the placement of xSol over the selected sections. */
+Backend::Row CompactModel::buildAvailabilityNoGood(const int k, const std::vector< std::vector<double> >& xSol, const std::vector<MapAvailability>& sectionAvailability, const int nbSections) const
+{
+    Backend::Row row;
+    row.lb = 1.0;
+    row.ub = Backend::getInfinity();
+    row.name = "LazyAvail(" + std::to_string(k) + ")";
+    const std::vector< std::pair<int, int> > SUPPORT = kernel.getNoGoodSupport(xSol, sectionAvailability, nbSections);
+    for (unsigned int j = 0; j < SUPPORT.size(); ++j){
+        const int i = SUPPORT[j].first;
+        const int v = SUPPORT[j].second;
+        /* Assignments fixed to zero by the presolve have no variable. */
+        if (presolve.isAssignable(k, i, v)){
+            row.vars.push_back(x[k][i][v]);
+            row.coefs.push_back(1.0);
+        }
+    }
+    return row;
+}
+
+/****************************************************************************************/
+/*									Solution Query  									*/
+/****************************************************************************************/
+
+/* Returns the best placement found by the backend. */
+Placement CompactModel::getPlacement() const
+{
+    Placement placement(data);
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (backend.getValue(x[k][i][v]) >= 1 - EPS){
+                    placement.assign(k, i, v);
+                }
+            }
+        }
+    }
+    return placement;
+}
+
+/* Displays the obtained results. */
+void CompactModel::printResult()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                 Printing best solution found.                 -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    if (hasFound()){
+        getPlacement().print();
+    }
+    else{
+        std::cout << "No feasible placement was found." << std::endl;
+    }
+    std::cout << std::endl << "Printing optimization informations..."                   << std::endl;
+    std::cout << "\t Backend:                   " << backend.getName()                  << std::endl;
+    std::cout << "\t Objective value:           " << objValue                           << std::endl;
+    std::cout << "\t Best bound:                " << bestBound                          << std::endl;
+    std::cout << "\t Nodes explored:            " << nbNodes                            << std::endl;
+    std::cout << "\t Lazy constraints:          " << nbLazy                             << std::endl;
+    std::cout << "\t User cuts:                 " << nbCuts                             << std::endl;
+    std::cout << "\t Total time:                " << time << std::endl                  << std::endl;
+}
+
+/* Outputs the obtained results, in the same format as Model::output. */
+void CompactModel::output()
+{
+    std::map<std::string, int> nbCutsPerFamily;
+    nbCutsPerFamily["LazyAvail"] = nbLazy;
+    nbCutsPerFamily["UserAvail"] = nbCuts;
+    const double GAP = (hasFound() && objValue > 0.0 ? (objValue - bestBound) / objValue : 1.0);
+    Results results(data, "compact");
+    results.add("relax_type",       "COMPACT_" + backend.getName(),         true);
+    results.add("time",             time,                                   true);
+    results.add("objective",        objValue,                               true);
+    results.add("best_bound",       bestBound,                              true);
+    results.add("gap",              GAP*100,                                true);
+    results.add("nodes",            nbNodes,                                true);
+    results.add("nodes_left",       0,                                      true);
+    results.add("lazy_constraints", nbLazy,                                 true);
+    results.add("user_cuts",        nbCuts,                                 true);
+    results.add("callback_time",    0.0,                                    true);
+    results.add("nb_avail_violations", 0,                                   true);
+    results.add("max_avail_violation", 0.0,                                 true);
+    results.add("build_time",       buildTime);
+    results.add("iterations",       0);
+    results.add("columns",          0);
+    results.add("cuts_per_family",  nbCutsPerFamily);
+    results.add("lifted_cuts",      0);
+    results.add("exact_rejections", 0);
+    results.write();
+}
+
+/* Writes the best placement found to the solution file. */
+void CompactModel::exportSolution()
+{
+    const std::string solution_file = data.getInput().getSolutionFile();
+    if (solution_file.empty() || !hasFound()){
+        return;
+    }
+    std::cout << "Writting solution to file..." << std::endl;
+    getPlacement().write(solution_file);
+}
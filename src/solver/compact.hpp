@@ -0,0 +1,101 @@
+#ifndef __compact__hpp
+#define __compact__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+
+/*** Own Libraries ***/
+#include "backend.hpp"
+#include "availabilitykernel.hpp"
+#include "../instance/presolve.hpp"
+#include "../heuristic/placement.hpp"
+#include "../tools/results.hpp"
+
+
+/************************************************************************************
+ * This class implements the placement formulation of the resilient VNF
+ * placement problem on top of the Backend interface, so that it can be solved
+ * by any MIP solver compiled in. Variables y[v][f] place vnfs and x[k][i][v]
+ * assign sections to nodes; the availability of each SFC is enforced by the
+ * lifted no-good inequalities of Callback::addLazyConstraints, computed by the
+ * same AvailabilityKernel and separated on integer candidates as lazy
+ * constraints and on fractional points as user cuts. Routing is not modeled,
+ * nor are the approximation models and cut families of Model and Callback.
+ * benchmark/compact.txt and benchmark/highs.txt run it on both backends.
+ ************************************************************************************/
+class CompactModel : public Backend::Separator {
+
+private:
+    typedef AvailabilityKernel::MapAvailability MapAvailability;
+
+    const Data&                                     data;           /**< Data read in data.hpp **/
+    Backend&                                        backend;        /**< The MIP solver **/
+    Presolve                                        presolve;       /**< Variables fixed before the model is built **/
+    AvailabilityKernel                              kernel;         /**< Availability computations shared with Callback **/
+
+    std::vector< std::vector<int> >                 y;              /**< Placement variable indexes. y[v][f] **/
+    std::vector< std::vector< std::vector<int> > >  x;              /**< Assignment variable indexes. x[k][i][v] **/
+    int                                             nbVariables;    /**< Number of variables in the backend. **/
+
+    /*** Execution ***/
+    std::mutex                                      thread_flag;    /**< Protects the counters when the separator is called concurrently. **/
+    int                                             nbLazy;         /**< Number of lazy constraints added. **/
+    int                                             nbCuts;         /**< Number of user cuts added. **/
+    Backend::Status                                 status;         /**< Status of the solve. **/
+    double                                          objValue;       /**< Value of the best solution. **/
+    double                                          bestBound;      /**< Best bound. **/
+    long                                            nbNodes;        /**< Number of branch-and-bound nodes explored. **/
+    double                                          time;           /**< Time spent by the solve. **/
+    double                                          buildTime;      /**< Time spent building the formulation. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Builds the formulation in the backend. @param data_ The instance data. @param backend_ The MIP solver, owned by the caller. **/
+    CompactModel(const Data& data_, Backend& backend_);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Solves the formulation within the time limit, starting from the greedy placement if greedy_start is set. **/
+    void run();
+
+    /** Separates the availability no-goods violated by the point of the context. **/
+    void separate(Backend::Context& context);
+
+	/****************************************************************************************/
+	/*									Solution Query  									*/
+	/****************************************************************************************/
+    /** Displays the obtained results. **/
+    void printResult();
+    /** Outputs the obtained results, in the same format as Model::output. **/
+    void output();
+    /** Writes the best placement found to the solution file. **/
+    void exportSolution();
+
+private:
+    /** Adds the placement and assignment variables. **/
+    void setVariables();
+    /** Adds the assignment, placement and node capacity constraints. **/
+    void setConstraints();
+    /** Gives the greedy placement to the backend as a MIP start, if it respects the presolve fixings. **/
+    void setGreedyStart();
+
+    /** Returns the no-good forbidding the placement of xSol over the first nbSections sections. **/
+    Backend::Row buildAvailabilityNoGood(const int k, const std::vector< std::vector<double> >& xSol, const std::vector<MapAvailability>& sectionAvailability, const int nbSections) const;
+
+    /** Returns true if the backend found a solution. **/
+    bool hasFound() const { return (status == Backend::STATUS_FEASIBLE || status == Backend::STATUS_OPTIMAL); }
+    /** Returns the best placement found by the backend. **/
+    Placement getPlacement() const;
+};
+
+#endif
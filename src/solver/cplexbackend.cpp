@@ -0,0 +1,178 @@
+#ifndef NO_CPLEX
+
+#include "cplexbackend.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Builds an empty minimization model. */
+CplexBackend::CplexBackend() : env(), model(env), cplex(model), obj(IloMinimize(env)), vars(env), nbRows(0),
+                               separator(NULL), contextMask(0), bridge(*this), status(STATUS_UNKNOWN)
+{
+    model.add(obj);
+}
+
+/* Destructor. Releases the environment. */
+CplexBackend::~CplexBackend()
+{
+    env.end();
+}
+
+/****************************************************************************************/
+/*										Model											*/
+/****************************************************************************************/
+
+/* Adds a variable to be minimized in the objective. */
+int CplexBackend::addVariable(const double lb, const double ub, const double cost, const VarType type, const std::string& name)
+{
+    const IloNumVarType CPLEX_TYPE = (type == VAR_BINARY ? ILOBOOL : (type == VAR_INTEGER ? ILOINT : ILOFLOAT));
+    const double LB = (lb <= -getInfinity() ? -IloInfinity : lb);
+    const double UB = (ub >=  getInfinity() ?  IloInfinity : ub);
+    IloNumVar var(env, LB, UB, CPLEX_TYPE, name.c_str());
+    vars.add(var);
+    /* Extract it even if no row nor the objective uses it, e.g., when fixed by presolve. */
+    model.add(var);
+    if (cost != 0.0){
+        obj.setLinearCoef(var, cost);
+    }
+    return (int)vars.getSize() - 1;
+}
+
+/* Adds a row. */
+int CplexBackend::addRow(const Row& row)
+{
+    model.add(toRange(row));
+    return nbRows++;
+}
+
+/* Sets the solution the solver starts from. */
+void CplexBackend::setMipStart(const std::vector<double>& values)
+{
+    mipStart = values;
+}
+
+/* Sets the separator. */
+void CplexBackend::setSeparator(Separator* separator_, const bool candidates, const bool relaxations)
+{
+    separator = separator_;
+    contextMask = 0;
+    if (candidates)  contextMask |= IloCplex::Callback::Context::Id::Candidate;
+    if (relaxations) contextMask |= IloCplex::Callback::Context::Id::Relaxation;
+}
+
+/* Returns the Concert range of a row. */
+IloRange CplexBackend::toRange(const Row& row) const
+{
+    IloExpr exp(env);
+    for (unsigned int j = 0; j < row.vars.size(); j++){
+        exp += row.coefs[j] * vars[row.vars[j]];
+    }
+    const double LB = (row.lb <= -getInfinity() ? -IloInfinity : row.lb);
+    const double UB = (row.ub >=  getInfinity() ?  IloInfinity : row.ub);
+    IloRange range(env, LB, exp, UB, row.name.c_str());
+    exp.end();
+    return range;
+}
+
+/****************************************************************************************/
+/*										Solve											*/
+/****************************************************************************************/
+
+/* Solves the model. */
+CplexBackend::Status CplexBackend::solve(const double timeLimit, const int threads)
+{
+    cplex.setParam(IloCplex::Param::TimeLimit, timeLimit);
+    cplex.setParam(IloCplex::Param::Threads, threads);
+    if (separator != NULL && contextMask != 0){
+        cplex.use(&bridge, contextMask);
+    }
+    if (!mipStart.empty()){
+        IloNumArray values(env);
+        for (unsigned int j = 0; j < mipStart.size(); j++){
+            values.add(mipStart[j]);
+        }
+        cplex.addMIPStart(vars, values, IloCplex::MIPStartAuto, "BackendStart");
+        values.end();
+    }
+
+    cplex.solve();
+    switch (cplex.getStatus()){
+        case IloAlgorithm::Optimal:     status = STATUS_OPTIMAL;    break;
+        case IloAlgorithm::Feasible:    status = STATUS_FEASIBLE;   break;
+        case IloAlgorithm::Infeasible:  status = STATUS_INFEASIBLE; break;
+        default:                        status = STATUS_UNKNOWN;    break;
+    }
+    return status;
+}
+
+/* Calls the separator from the generic callback. */
+void CplexBackend::Bridge::invoke(const IloCplex::Callback::Context& context)
+{
+    if (context.getId() == IloCplex::Callback::Context::Id::Candidate && !context.isCandidatePoint()){
+        throw IloCplex::Exception(-1, "ERROR: Unbounded solution within callback !");
+    }
+    ContextAdapter adapter(backend, context);
+    backend.separator->separate(adapter);
+}
+
+/* Returns true if the point is an integer candidate. */
+bool CplexBackend::ContextAdapter::isCandidate() const
+{
+    return (context.getId() == IloCplex::Callback::Context::Id::Candidate);
+}
+
+/* Returns the value of a variable at the point. */
+double CplexBackend::ContextAdapter::getValue(const int var) const
+{
+    if (isCandidate()){
+        return context.getCandidatePoint(backend.vars[var]);
+    }
+    return context.getRelaxationPoint(backend.vars[var]);
+}
+
+/* Rejects the candidate with a lazy constraint. */
+void CplexBackend::ContextAdapter::addLazy(const Row& row)
+{
+    IloRange range = backend.toRange(row);
+    context.rejectCandidate(range);
+    range.end();
+}
+
+/* Adds a user cut. */
+void CplexBackend::ContextAdapter::addCut(const Row& row)
+{
+    IloRange range = backend.toRange(row);
+    context.addUserCut(range, IloCplex::UseCutPurge, IloFalse);
+    range.end();
+}
+
+/****************************************************************************************/
+/*									Solution Query  									*/
+/****************************************************************************************/
+
+/* Returns the value of a variable in the best solution. */
+double CplexBackend::getValue(const int var) const
+{
+    return cplex.getValue(vars[var]);
+}
+
+/* Returns the value of the best solution. */
+double CplexBackend::getObjValue() const
+{
+    return cplex.getObjValue();
+}
+
+/* Returns the best bound. */
+double CplexBackend::getBestBound() const
+{
+    return cplex.getBestObjValue();
+}
+
+/* Returns the number of branch-and-bound nodes explored. */
+long CplexBackend::getNbNodes() const
+{
+    return (long)cplex.getNnodes();
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef __cplexbackend__hpp
+#define __cplexbackend__hpp
+
+#ifndef NO_CPLEX
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/ilocplex.h>
+ILOSTLBEGIN
+
+/*** Own Libraries ***/
+#include "backend.hpp"
+
+
+/************************************************************************************
+ * This class implements the Backend interface with CPLEX Concert. The separator
+ * is called from a generic callback, in the candidate context for integer
+ * points and in the relaxation context for fractional ones.
+ ************************************************************************************/
+class CplexBackend : public Backend {
+
+private:
+    /** Bridges the generic callback to the separator. **/
+    class Bridge : public IloCplex::Callback::Function {
+    private:
+        CplexBackend&   backend;    /**< The backend. **/
+    public:
+        Bridge(CplexBackend& backend_) : backend(backend_) {}
+        void invoke(const IloCplex::Callback::Context& context);
+    };
+
+    /** Adapts a callback context to the Backend::Context interface. **/
+    class ContextAdapter : public Backend::Context {
+    private:
+        const CplexBackend&                     backend;    /**< The backend. **/
+        const IloCplex::Callback::Context&      context;    /**< The CPLEX context. **/
+    public:
+        ContextAdapter(const CplexBackend& backend_, const IloCplex::Callback::Context& context_) : backend(backend_), context(context_) {}
+        bool    isCandidate () const;
+        double  getValue    (const int var) const;
+        void    addLazy     (const Row& row);
+        void    addCut      (const Row& row);
+    };
+
+    IloEnv              env;            /**< IBM environment, owned by the backend **/
+    IloModel            model;          /**< IBM Model **/
+    IloCplex            cplex;          /**< IBM Cplex **/
+    IloObjective        obj;            /**< Objective function **/
+    IloNumVarArray      vars;           /**< The variables, in index order **/
+    int                 nbRows;         /**< Number of rows added **/
+    std::vector<double> mipStart;       /**< The MIP start, empty if none **/
+    Separator*          separator;      /**< The separator, or NULL **/
+    CPXLONG             contextMask;    /**< The contexts on which the separator is called **/
+    Bridge              bridge;         /**< The generic callback **/
+    Status              status;         /**< Status of the last solve **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Builds an empty minimization model. **/
+    CplexBackend();
+    /** Destructor. Releases the environment. **/
+    ~CplexBackend();
+
+	/****************************************************************************************/
+	/*										Model											*/
+	/****************************************************************************************/
+    int     addVariable     (const double lb, const double ub, const double obj, const VarType type, const std::string& name);
+    int     addRow          (const Row& row);
+    void    setMipStart     (const std::vector<double>& values);
+    void    setSeparator    (Separator* separator, const bool candidates, const bool relaxations);
+
+	/****************************************************************************************/
+	/*										Solve											*/
+	/****************************************************************************************/
+    Status  solve           (const double timeLimit, const int threads);
+
+	/****************************************************************************************/
+	/*									Solution Query  									*/
+	/****************************************************************************************/
+    double  getValue        (const int var) const;
+    double  getObjValue     () const;
+    double  getBestBound    () const;
+    long    getNbNodes      () const;
+    std::string getName     () const { return "cplex"; }
+
+private:
+    /** Returns the Concert range of a row. **/
+    IloRange toRange(const Row& row) const;
+};
+
+#endif
+
+#endif
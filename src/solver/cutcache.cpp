@@ -0,0 +1,146 @@
+#include "cutcache.hpp"
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Returns true if cuts of the given family can be cached. */
+bool CutCache::isCacheable(const std::string& family)
+{
+    return (family == "ChainCover" || family == "GenCover" || family == "HeurAvail" || family == "LazyAvail" || family == "LiftedAvail");
+}
+
+/* Adds a cut to the cache unless it is already there or cannot be cached. */
+bool CutCache::add(const Cut& cut)
+{
+    if (!isCacheable(cut.family)){
+        return false;
+    }
+    std::string key = toString(cut);
+    std::lock_guard<std::mutex> lock(flag);
+    if (keys.insert(key).second == false){
+        return false;
+    }
+    cuts.push_back(cut);
+    return true;
+}
+
+/* Returns the textual representation of a cut. */
+std::string CutCache::toString(const Cut& cut) const
+{
+    std::ostringstream line;
+    line << std::setprecision(17);
+    line << "cut;" << cut.family << ";"
+         << data.getDemand(cut.demand).getName() << ";"
+         << data.getDemand(cut.demand).getAvailability() << ";"
+         << cut.lb;
+    for (unsigned int t = 0; t < cut.terms.size(); t++){
+        line << ";" << cut.terms[t].section << "," << data.getNode(cut.terms[t].node).getName() << "," << cut.terms[t].coeff;
+    }
+    return line.str();
+}
+
+/* Reads the cuts stored in a cache file. */
+int CutCache::read(const std::string filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file.good()){
+        std::cout << "\t Cut cache '" << filename << "' not found. Starting with an empty cache." << std::endl;
+        return 0;
+    }
+    file.close();
+
+    std::cout << "\t Reading cut cache " << filename << " ..." << std::endl;
+    Reader reader(filename);
+    std::vector<std::vector<std::string> > dataList = reader.getData();
+
+    /* The cache is only valid if nodes and their availabilities are the same. */
+    int nbNodes = 0;
+    for (unsigned int l = 0; l < dataList.size(); l++){
+        if (dataList[l].size() == 3 && dataList[l][0] == "node"){
+            nbNodes++;
+            bool found = false;
+            for (int v = 0; v < data.getNbNodes() && !found; v++){
+                if (data.getNode(v).getName() == dataList[l][1]){
+                    found = (std::abs(data.getNode(v).getAvailability() - atof(dataList[l][2].c_str())) < 1e-12);
+                }
+            }
+            if (!found){
+                std::cout << "WARNING: Cut cache was built on a different set of nodes. It will be ignored." << std::endl;
+                return 0;
+            }
+        }
+    }
+    if (nbNodes != data.getNbNodes()){
+        std::cout << "WARNING: Cut cache was built on a different set of nodes. It will be ignored." << std::endl;
+        return 0;
+    }
+
+    /* Load cuts whose demand exists with the same availability requirement. */
+    int nbRejected = 0;
+    for (unsigned int l = 0; l < dataList.size(); l++){
+        if (dataList[l].size() < 5 || dataList[l][0] != "cut"){
+            continue;
+        }
+        Cut cut;
+        cut.family = dataList[l][1];
+        cut.demand = data.getIdFromDemandName(dataList[l][2]);
+        cut.lb     = atof(dataList[l][4].c_str());
+        bool compatible = (cut.demand != -1);
+        if (compatible){
+            compatible = (std::abs(data.getDemand(cut.demand).getAvailability() - atof(dataList[l][3].c_str())) < 1e-12);
+        }
+        for (unsigned int t = 5; t < dataList[l].size() && compatible; t++){
+            std::vector<std::string> term = split(dataList[l][t], ",");
+            if (term.size() != 3){
+                compatible = false;
+                break;
+            }
+            /* A corrupt term (section not a number, unknown node) rejects the cut. */
+            Term entry;
+            try {
+                entry.section = std::stoi(term[0]);
+                entry.node    = data.getIdFromNodeName(term[1]);
+            }
+            catch (const std::exception&) {
+                compatible = false;
+                break;
+            }
+            entry.coeff   = atof(term[2].c_str());
+            if (entry.section < 0 || entry.section >= data.getDemand(cut.demand).getNbVNFs()){
+                compatible = false;
+            }
+            cut.terms.push_back(entry);
+        }
+        if (compatible && add(cut)){
+            nbLoaded++;
+        }
+        else{
+            nbRejected++;
+        }
+    }
+    std::cout << "\t " << nbLoaded << " cuts loaded from cache (" << nbRejected << " ignored)." << std::endl;
+    return nbLoaded;
+}
+
+/* Writes all cuts stored in the cache to a file. */
+void CutCache::write(const std::string filename)
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write cut cache '" << filename << "'." << std::endl;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(flag);
+    file << std::setprecision(17);
+    /* Instance fingerprint */
+    for (int v = 0; v < data.getNbNodes(); v++){
+        file << "node;" << data.getNode(v).getName() << ";" << data.getNode(v).getAvailability() << std::endl;
+    }
+    /* Cuts */
+    for (unsigned int c = 0; c < cuts.size(); c++){
+        file << toString(cuts[c]) << std::endl;
+    }
+    file.close();
+    std::cout << "\t " << cuts.size() << " cuts written to cache " << filename << "." << std::endl;
+}
@@ -0,0 +1,87 @@
+#ifndef __cutcache__hpp
+#define __cutcache__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <iomanip>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class stores the cuts generated during the optimization in a solver
+ * independent way, that is, demands and nodes are identified by their names.
+ * The cache can be written to a file and preloaded on a later run of a
+ * compatible instance (same nodes with the same availabilities). Only the
+ * availability cuts are cached: Benders cuts also depend on links, delays,
+ * latency bounds and demand endpoints, which the fingerprint does not hold.
+ ************************************************************************************/
+class CutCache {
+
+public:
+    /** A term of a cached cut: the coefficient of the variable assigning a section to a node. **/
+    struct Term {
+        int         section;    /**< The section id inside the demand. **/
+        int         node;       /**< The node id in the current instance. **/
+        double      coeff;      /**< The variable coefficient. **/
+    };
+
+    /** A cached cut of the form sum(coeff * x[k][section][node]) >= lb. **/
+    struct Cut {
+        std::string         family;     /**< The family of the cut (e.g., ChainCover). **/
+        int                 demand;     /**< The demand id in the current instance. **/
+        double              lb;         /**< The cut right-hand side. **/
+        std::vector<Term>   terms;      /**< The cut terms. **/
+    };
+
+private:
+    const Data&         data;       /**< Data read in data.hpp **/
+    std::vector<Cut>    cuts;       /**< The cuts stored in the cache. **/
+    std::set<std::string> keys;     /**< The textual representation of each cut, used to avoid duplicates. **/
+    std::mutex          flag;       /**< A mutex protecting the cache during the optimization. **/
+    int                 nbLoaded;   /**< Number of cuts read from file. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param data_ The instance data. **/
+    CutCache(const Data& data_) : data(data_), nbLoaded(0) {}
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the cuts stored in the cache. **/
+    const std::vector<Cut>& getCuts()       const { return cuts; }
+    /** Returns the number of cuts stored in the cache. **/
+    const int               getNbCuts()     const { return (int)cuts.size(); }
+    /** Returns the number of cuts read from file. **/
+    const int               getNbLoaded()   const { return nbLoaded; }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Returns true if cuts of the given family only depend on node availabilities and SLAs, and can therefore be cached. @param family The family of the cut. **/
+    static bool isCacheable(const std::string& family);
+
+    /** Adds a cut to the cache unless it is already there or its family cannot be cached. Returns true if the cut was added. @param cut The cut to be stored. @note Thread safe. **/
+    bool add(const Cut& cut);
+
+    /** Reads the cuts stored in a cache file. Cuts are only kept if the file was generated on a compatible instance. Returns the number of cuts loaded. @param filename The cache file. **/
+    int  read(const std::string filename);
+
+    /** Writes all cuts stored in the cache to a file. @param filename The cache file. **/
+    void write(const std::string filename);
+
+    /** Returns the textual representation of a cut, as written in the cache file. @param cut The cut to be represented. **/
+    std::string toString(const Cut& cut) const;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#ifdef USE_HIGHS
+
+#include "highsbackend.hpp"
+
+/** Maximum number of cutting-plane rounds over the LP relaxation. **/
+#define MAX_ROOT_ROUNDS 20
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Builds an empty minimization model. */
+HighsBackend::HighsBackend() : separator(NULL), candidates(false), relaxations(false), status(STATUS_UNKNOWN),
+                               objValue(0.0), bestBound(0.0), nbNodes(0)
+{
+    highs.setOptionValue("output_flag", false);
+}
+
+/****************************************************************************************/
+/*										Model											*/
+/****************************************************************************************/
+
+/* Adds a variable to be minimized in the objective. */
+int HighsBackend::addVariable(const double lb, const double ub, const double cost, const VarType type, const std::string& name)
+{
+    const HighsInt COL = highs.getNumCol();
+    const double LB = (lb <= -getInfinity() ? -kHighsInf : lb);
+    const double UB = (ub >=  getInfinity() ?  kHighsInf : ub);
+    highs.addVar(LB, UB);
+    highs.changeColCost(COL, cost);
+    integrality.push_back(type == VAR_CONTINUOUS ? HighsVarType::kContinuous : HighsVarType::kInteger);
+    highs.changeColIntegrality(COL, integrality.back());
+    highs.passColName(COL, name);
+    costs.push_back(cost);
+    return (int)COL;
+}
+
+/* Adds a row. */
+int HighsBackend::addRow(const Row& row)
+{
+    const HighsInt ROW = highs.getNumRow();
+    std::vector<HighsInt> index(row.vars.begin(), row.vars.end());
+    const double LB = (row.lb <= -getInfinity() ? -kHighsInf : row.lb);
+    const double UB = (row.ub >=  getInfinity() ?  kHighsInf : row.ub);
+    highs.addRow(LB, UB, (HighsInt)index.size(), index.data(), row.coefs.data());
+    if (!row.name.empty()){
+        highs.passRowName(ROW, row.name);
+    }
+    return (int)ROW;
+}
+
+/* Sets the solution the solver starts from. */
+void HighsBackend::setMipStart(const std::vector<double>& values)
+{
+    mipStart = values;
+}
+
+/* Sets the separator. */
+void HighsBackend::setSeparator(Separator* separator_, const bool candidates_, const bool relaxations_)
+{
+    separator = separator_;
+    candidates = candidates_;
+    relaxations = relaxations_;
+}
+
+/****************************************************************************************/
+/*										Solve											*/
+/****************************************************************************************/
+
+/* Solves the model. */
+HighsBackend::Status HighsBackend::solve(const double timeLimit, const int threads)
+{
+    const std::chrono::steady_clock::time_point DEADLINE = std::chrono::steady_clock::now() + std::chrono::milliseconds((long)(timeLimit * 1000.0));
+    highs.setOptionValue("threads", (HighsInt)threads);
+    status = STATUS_UNKNOWN;
+    solution.clear();
+    nbNodes = 0;
+
+    if (separator != NULL && relaxations){
+        separateRelaxation(DEADLINE);
+    }
+
+    /* Row generation: solve the MIP until the separator accepts its solution. */
+    bool accepted = false;
+    bool optimal = false;
+    bestBound = -getInfinity();
+    while (!accepted && getRemainingTime(DEADLINE) > 0.0){
+        highs.setOptionValue("time_limit", getRemainingTime(DEADLINE));
+        if (!mipStart.empty()){
+            HighsSolution start;
+            start.col_value = mipStart;
+            start.value_valid = true;
+            highs.setSolution(start);
+        }
+        highs.run();
+        const HighsInfo& info = highs.getInfo();
+        nbNodes += (long)info.mip_node_count;
+        bestBound = info.mip_dual_bound;
+        if (highs.getModelStatus() == HighsModelStatus::kInfeasible){
+            status = STATUS_INFEASIBLE;
+            return status;
+        }
+        if (info.primal_solution_status != kSolutionStatusFeasible){
+            break;
+        }
+        const std::vector<double>& point = highs.getSolution().col_value;
+        if (separator == NULL || !candidates || separate(point, true) == 0){
+            accepted = true;
+            optimal = (highs.getModelStatus() == HighsModelStatus::kOptimal);
+            solution = point;
+            objValue = info.objective_function_value;
+        }
+    }
+
+    /* The MIP start satisfies every row, it is kept if no better solution was accepted. */
+    if (!accepted && !mipStart.empty()){
+        accepted = true;
+        solution = mipStart;
+        objValue = 0.0;
+        for (unsigned int j = 0; j < costs.size(); j++){
+            objValue += costs[j] * solution[j];
+        }
+    }
+    if (accepted){
+        status = (optimal ? STATUS_OPTIMAL : STATUS_FEASIBLE);
+        if (optimal){
+            bestBound = objValue;
+        }
+    }
+    return status;
+}
+
+/* Generates user cuts over the LP relaxation until none is violated or the round limit is reached. */
+void HighsBackend::separateRelaxation(const std::chrono::steady_clock::time_point& deadline)
+{
+    const HighsInt LAST = (HighsInt)integrality.size() - 1;
+    if (LAST < 0){
+        return;
+    }
+    std::vector<HighsVarType> continuous(integrality.size(), HighsVarType::kContinuous);
+    highs.changeColsIntegrality(0, LAST, continuous.data());
+    for (int round = 0; round < MAX_ROOT_ROUNDS && getRemainingTime(deadline) > 0.0; round++){
+        highs.setOptionValue("time_limit", getRemainingTime(deadline));
+        highs.run();
+        if (highs.getModelStatus() != HighsModelStatus::kOptimal){
+            break;
+        }
+        if (separate(highs.getSolution().col_value, false) == 0){
+            break;
+        }
+    }
+    highs.changeColsIntegrality(0, LAST, integrality.data());
+}
+
+/* Calls the separator on a point and adds the rows it violates. */
+int HighsBackend::separate(const std::vector<double>& point, const bool candidate)
+{
+    std::vector<Row> rows;
+    ContextAdapter adapter(point, candidate, rows);
+    separator->separate(adapter);
+    for (unsigned int r = 0; r < rows.size(); r++){
+        addRow(rows[r]);
+    }
+    return (int)rows.size();
+}
+
+/* Returns the number of seconds left before a deadline. */
+double HighsBackend::getRemainingTime(const std::chrono::steady_clock::time_point& deadline) const
+{
+    const std::chrono::duration<double> LEFT = deadline - std::chrono::steady_clock::now();
+    return LEFT.count();
+}
+
+#endif
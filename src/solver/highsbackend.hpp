@@ -0,0 +1,100 @@
+#ifndef __highsbackend__hpp
+#define __highsbackend__hpp
+
+#ifdef USE_HIGHS
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <iostream>
+
+/*** HiGHS Libraries ***/
+#include <Highs.h>
+
+/*** Own Libraries ***/
+#include "backend.hpp"
+
+
+/************************************************************************************
+ * This class implements the Backend interface with the open-source HiGHS
+ * solver. HiGHS does not expose lazy constraint callbacks, so the separator is
+ * called between solves: user cuts are generated by a cutting-plane loop over
+ * the LP relaxation before branching, and lazy constraints by a row-generation
+ * loop which re-solves the MIP until its solution is accepted by the
+ * separator. Every row added is valid, so the final bound is valid and the
+ * final solution is optimal when the last solve is.
+ ************************************************************************************/
+class HighsBackend : public Backend {
+
+private:
+    /** Stores a point and collects the rows found by the separator. **/
+    class ContextAdapter : public Backend::Context {
+    private:
+        const std::vector<double>&  point;      /**< The point to be separated. **/
+        const bool                  candidate;  /**< True if the point is integer. **/
+        std::vector<Row>&           rows;       /**< The rows found. **/
+    public:
+        ContextAdapter(const std::vector<double>& point_, const bool candidate_, std::vector<Row>& rows_) : point(point_), candidate(candidate_), rows(rows_) {}
+        bool    isCandidate () const                { return candidate; }
+        double  getValue    (const int var) const   { return point[var]; }
+        void    addLazy     (const Row& row)        { rows.push_back(row); }
+        void    addCut      (const Row& row)        { rows.push_back(row); }
+    };
+
+    Highs                       highs;          /**< The HiGHS instance **/
+    std::vector<HighsVarType>   integrality;    /**< The type of each variable **/
+    std::vector<double>         costs;          /**< The objective coefficient of each variable **/
+    std::vector<double>         mipStart;       /**< The MIP start, empty if none **/
+    std::vector<double>         solution;       /**< The best solution **/
+    Separator*                  separator;      /**< The separator, or NULL **/
+    bool                        candidates;     /**< True if the separator is called on integer points **/
+    bool                        relaxations;    /**< True if the separator is called on fractional points **/
+    Status                      status;         /**< Status of the last solve **/
+    double                      objValue;       /**< Value of the best solution **/
+    double                      bestBound;      /**< Best bound **/
+    long                        nbNodes;        /**< Nodes explored by all MIP solves **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Builds an empty minimization model. **/
+    HighsBackend();
+
+	/****************************************************************************************/
+	/*										Model											*/
+	/****************************************************************************************/
+    int     addVariable     (const double lb, const double ub, const double obj, const VarType type, const std::string& name);
+    int     addRow          (const Row& row);
+    void    setMipStart     (const std::vector<double>& values);
+    void    setSeparator    (Separator* separator, const bool candidates, const bool relaxations);
+
+	/****************************************************************************************/
+	/*										Solve											*/
+	/****************************************************************************************/
+    Status  solve           (const double timeLimit, const int threads);
+
+	/****************************************************************************************/
+	/*									Solution Query  									*/
+	/****************************************************************************************/
+    double  getValue        (const int var) const   { return solution[var]; }
+    double  getObjValue     () const                { return objValue; }
+    double  getBestBound    () const                { return bestBound; }
+    long    getNbNodes      () const                { return nbNodes; }
+    std::string getName     () const                { return "highs"; }
+
+private:
+    /** Generates user cuts over the LP relaxation until none is violated or the round limit is reached. @param deadline The time at which the solve must stop. **/
+    void    separateRelaxation  (const std::chrono::steady_clock::time_point& deadline);
+    /** Calls the separator on a point and adds the rows it violates. Returns the number of rows added. **/
+    int     separate            (const std::vector<double>& point, const bool candidate);
+    /** Returns the number of seconds left before a deadline. **/
+    double  getRemainingTime    (const std::chrono::steady_clock::time_point& deadline) const;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,332 @@
+#include "lagrangian.hpp"
+
+#define PRECISION   1e-6    // Tolerance used when comparing bounds
+#define INIT_STEP   1.0     // Initial Polyak step factor
+#define MIN_STEP    1e-4    // The algorithm stops once the step factor falls below this value
+#define PATIENCE    5       // Number of iterations without bound improvement before the step factor is halved
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Capacity multipliers start at zero. */
+Lagrangian::Lagrangian(const Data& data_) :
+                data(data_), pricer(data_, data_.getInput().getPricingGrid(), PatternPricer::ROUNDING_OPTIMISTIC),
+                nbWorkers(std::max(1, data_.getInput().getLagrangianWorkers())),
+                pi(data_.getNbNodes(), 0.0), xSol(data_.getNbDemands()), subValue(data_.getNbDemands(), 0.0),
+                ySol(data_.getNbNodes(), std::vector<int>(data_.getNbVnfs(), 0)),
+                nbIterations(0), bestBound(-DBL_MAX), bestValue(DBL_MAX), found(false), infeasible(false), best(data_), time(0.0)
+{
+    /* Each placement cost is shared among the sections that may use it, so that the placement subproblem starts with null reduced costs. */
+    std::vector< std::vector<int> > nbUsers(data.getNbNodes(), std::vector<int>(data.getNbVnfs(), 0));
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (pricer.isEligible(k, i, v)) nbUsers[v][data.getDemand(k).getVNF_i(i)]++;
+            }
+        }
+    }
+    mu.resize(data.getNbDemands());
+    for (int k = 0; k < data.getNbDemands(); k++){
+        mu[k].resize(data.getDemand(k).getNbVNFs(), std::vector<double>(data.getNbNodes(), 0.0));
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            const int f = data.getDemand(k).getVNF_i(i);
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (!pricer.isEligible(k, i, v)) continue;
+                mu[k][i][v] = data.getPlacementCost(data.getNode(v), data.getVnf(f)) / nbUsers[v][f];
+            }
+        }
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Runs the subgradient algorithm. */
+void Lagrangian::run()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                Running Lagrangian relaxation.                 -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+        std::cout << "WARNING: The Lagrangian relaxation does not model routing. Latency constraints are ignored." << std::endl;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    /* Any placement costs less than placing every vnf on every node. */
+    double trivialBound = 0.0;
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            trivialBound += data.getPlacementCost(data.getNode(v), data.getVnf(f));
+        }
+    }
+
+    double stepFactor = INIT_STEP;
+    int nbStalls = 0;
+    std::vector<double> gPi;
+    std::vector< std::vector< std::vector<double> > > gMu;
+    for (nbIterations = 0; nbIterations < data.getInput().getLagrangianMaxIterations(); nbIterations++){
+        const double VALUE = evaluate();
+        if (VALUE == DBL_MAX){
+            std::cout << "ERROR: A demand has no feasible placement. The instance is infeasible." << std::endl;
+            infeasible = true;
+            break;
+        }
+        if (VALUE > bestBound + PRECISION){
+            bestBound = VALUE;
+            nbStalls = 0;
+        }
+        else if (++nbStalls >= PATIENCE){
+            stepFactor /= 2.0;
+            nbStalls = 0;
+        }
+        repair();
+
+        const double UPPER = (found ? bestValue : trivialBound);
+        std::cout << "\t Iteration " << nbIterations << ": bound " << VALUE << ", best bound " << bestBound
+                  << ", best value " << (found ? bestValue : 0.0) << "." << std::endl;
+
+        if (UPPER - bestBound <= PRECISION * std::max(1.0, UPPER)) break;
+        if (stepFactor < MIN_STEP) break;
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > data.getInput().getTimeLimit()) break;
+
+        /* Projected subgradient step. */
+        const double NORM = getSubgradient(gPi, gMu);
+        if (NORM <= 0.0) break;
+        const double STEP = stepFactor * (UPPER - VALUE) / NORM;
+        for (int v = 0; v < data.getNbNodes(); v++){
+            pi[v] = std::max(0.0, pi[v] + STEP * gPi[v]);
+        }
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                for (int v = 0; v < data.getNbNodes(); v++){
+                    mu[k][i][v] = std::max(0.0, mu[k][i][v] + STEP * gMu[k][i][v]);
+                }
+            }
+        }
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Solves every subproblem for the current multipliers. */
+double Lagrangian::evaluate()
+{
+    /* Demand subproblems. */
+    if (nbWorkers <= 1){
+        solveWorker(0, 1);
+    }
+    else{
+        std::vector<std::thread> workers;
+        for (int w = 0; w < nbWorkers; w++){
+            workers.push_back(std::thread(&Lagrangian::solveWorker, this, w, nbWorkers));
+        }
+        for (unsigned int w = 0; w < workers.size(); w++){
+            workers[w].join();
+        }
+    }
+    double value = 0.0;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        if (subValue[k] == DBL_MAX) return DBL_MAX;
+        value += subValue[k];
+    }
+
+    /* Placement subproblem: a vnf is placed wherever its linking multipliers exceed its cost. */
+    std::vector< std::vector<double> > reducedCost(data.getNbNodes(), std::vector<double>(data.getNbVnfs(), 0.0));
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            reducedCost[v][f] = data.getPlacementCost(data.getNode(v), data.getVnf(f));
+        }
+    }
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            const int f = data.getDemand(k).getVNF_i(i);
+            for (int v = 0; v < data.getNbNodes(); v++){
+                reducedCost[v][f] -= mu[k][i][v];
+            }
+        }
+    }
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            ySol[v][f] = (reducedCost[v][f] < 0.0 ? 1 : 0);
+            value += std::min(0.0, reducedCost[v][f]);
+        }
+        value -= pi[v] * data.getNode(v).getCapacity();
+    }
+    return value;
+}
+
+/* Solves the subproblems of the demands assigned to a worker. */
+void Lagrangian::solveWorker(const int worker, const int nbThreads)
+{
+    for (int k = worker; k < data.getNbDemands(); k += nbThreads){
+        std::vector< std::vector<double> > weight(data.getDemand(k).getNbVNFs(), std::vector<double>(data.getNbNodes(), 0.0));
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                weight[i][v] = pi[v] * pricer.getLoad(k, i) + mu[k][i][v];
+            }
+        }
+        subValue[k] = pricer.solve(k, weight, xSol[k]);
+    }
+}
+
+/* Computes the subgradient of the current solution. */
+double Lagrangian::getSubgradient(std::vector<double>& gPi, std::vector< std::vector< std::vector<double> > >& gMu) const
+{
+    gPi.assign(data.getNbNodes(), 0.0);
+    gMu.resize(data.getNbDemands());
+    for (int v = 0; v < data.getNbNodes(); v++){
+        gPi[v] = -data.getNode(v).getCapacity();
+    }
+    for (int k = 0; k < data.getNbDemands(); k++){
+        gMu[k].resize(data.getDemand(k).getNbVNFs());
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            const int f = data.getDemand(k).getVNF_i(i);
+            gMu[k][i].assign(data.getNbNodes(), 0.0);
+            for (int v = 0; v < data.getNbNodes(); v++){
+                gMu[k][i][v] = -ySol[v][f];
+            }
+            for (unsigned int j = 0; j < xSol[k][i].size(); j++){
+                const int v = xSol[k][i][j];
+                gPi[v] += pricer.getLoad(k, i);
+                gMu[k][i][v] += 1.0;
+            }
+        }
+    }
+
+    /* Components that would push a null multiplier below zero do not move. */
+    double norm = 0.0;
+    for (int v = 0; v < data.getNbNodes(); v++){
+        if (pi[v] <= 0.0 && gPi[v] < 0.0) gPi[v] = 0.0;
+        norm += gPi[v] * gPi[v];
+    }
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (mu[k][i][v] <= 0.0 && gMu[k][i][v] < 0.0) gMu[k][i][v] = 0.0;
+                norm += gMu[k][i][v] * gMu[k][i][v];
+            }
+        }
+    }
+    return norm;
+}
+
+/* Builds a feasible placement from the subproblem assignments. */
+void Lagrangian::repair()
+{
+    Placement placement(data);
+    std::vector<double> load(data.getNbDemands(), 0.0);
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            load[k] += placement.getRequiredCapacity(k, i);
+        }
+    }
+    std::vector<int> order = getSortedIndexes_Desc(load);
+
+    /* A demand which cannot be completed is moved to the front and the construction restarts. */
+    for (int attempt = 0; attempt < data.getNbDemands(); attempt++){
+        placement.clear();
+        int failed = -1;
+        for (unsigned int j = 0; j < order.size() && failed == -1; j++){
+            const int k = order[j];
+            for (unsigned int i = 0; i < xSol[k].size(); i++){
+                for (unsigned int n = 0; n < xSol[k][i].size(); n++){
+                    placement.assign(k, i, xSol[k][i][n]);
+                }
+            }
+            if (!placement.complete(k)){
+                failed = (int)j;
+                break;
+            }
+            /* Optimistic rounding may over-assign: drop the assignments that are not needed. */
+            for (unsigned int i = 0; i < xSol[k].size(); i++){
+                for (unsigned int n = 0; n < xSol[k][i].size(); n++){
+                    const int v = xSol[k][i][n];
+                    if (!placement.isAssigned(k, i, v)) continue;
+                    placement.unassign(k, i, v);
+                    if (!placement.isFeasible(k)){
+                        placement.assign(k, i, v);
+                    }
+                }
+            }
+        }
+        if (failed == -1) break;
+        if (failed == 0) return;
+        std::rotate(order.begin(), order.begin() + failed, order.begin() + failed + 1);
+    }
+    if (placement.isFeasible() && placement.getCost() < bestValue - PRECISION){
+        best = placement;
+        bestValue = placement.getCost();
+        found = true;
+    }
+}
+
+/****************************************************************************************/
+/*									Solution Query  									*/
+/****************************************************************************************/
+
+/* Displays the obtained results. */
+void Lagrangian::printResult()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                 Printing best solution found.                 -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    if (found){
+        best.print();
+    }
+    else{
+        std::cout << "No feasible placement was found." << std::endl;
+    }
+    std::cout << std::endl << "Printing optimization informations..."                   << std::endl;
+    if (infeasible){
+        std::cout << "The instance is infeasible." << std::endl;
+    }
+    if (hasBound()){
+        std::cout << "\t Lagrangian bound:          " << bestBound                          << std::endl;
+    }
+    std::cout << "\t Objective value:           " << (found ? bestValue : 0.0)          << std::endl;
+    std::cout << "\t Iterations:                " << nbIterations                       << std::endl;
+    std::cout << "\t Total time:                " << time << std::endl                  << std::endl;
+}
+
+/* Outputs the obtained results, in the same format as Model::output. */
+void Lagrangian::output()
+{
+    /* Without a bound, the bound is written as 0, as CompactModel does on an infeasible instance. */
+    const double VALUE = (found ? bestValue : 0.0);
+    const double BOUND = (hasBound() ? bestBound : 0.0);
+    const double GAP = (found && hasBound() && bestValue > 0.0 ? (bestValue - bestBound) / bestValue : 1.0);
+    Results results(data, "lagrangian");
+    results.add("relax_type",       "LAGRANGIAN_" + std::to_string(data.getInput().getPricingGrid()), true);
+    results.add("time",             time,                                   true);
+    results.add("objective",        VALUE,                                  true);
+    results.add("best_bound",       BOUND,                                  true);
+    results.add("gap",              GAP*100,                                true);
+    results.add("nodes",            0,                                      true);
+    results.add("nodes_left",       0,                                      true);
+    results.add("lazy_constraints", 0,                                      true);
+    results.add("user_cuts",        0,                                      true);
+    results.add("callback_time",    0.0,                                    true);
+    results.add("nb_avail_violations", 0,                                   true);
+    results.add("max_avail_violation", 0.0,                                true);
+    results.add("build_time",       0.0);
+    results.add("iterations",       nbIterations);
+    results.add("columns",          0);
+    results.add("cuts_per_family",  std::map<std::string, int>());
+    results.add("lifted_cuts",      0);
+    results.add("exact_rejections", 0);
+    results.write();
+}
+
+/* Writes the best placement found to the solution file. */
+void Lagrangian::exportSolution()
+{
+    const std::string solution_file = data.getInput().getSolutionFile();
+    if (solution_file.empty() || !found){
+        return;
+    }
+    std::cout << "Writting solution to file..." << std::endl;
+    best.write(solution_file);
+}
@@ -0,0 +1,107 @@
+#ifndef __lagrangian__hpp
+#define __lagrangian__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cfloat>
+#include <thread>
+#include <chrono>
+#include <fstream>
+
+/*** Own Libraries ***/
+#include "pricing.hpp"
+#include "../heuristic/placement.hpp"
+#include "../tools/others.hpp"
+#include "../tools/results.hpp"
+
+
+/************************************************************************************
+ * This class implements a Lagrangian relaxation of the resilient VNF placement
+ * problem. Node capacities and the linking constraints x[k][i][v] <= y[v][f]
+ * are dualized, so that the problem splits into a trivial placement problem
+ * and one availability placement problem per demand. The demand subproblems are
+ * solved in parallel by the dynamic program of PatternPricer with optimistic
+ * rounding, so that the Lagrangian value is a valid lower bound. Multipliers
+ * are updated by subgradient with Polyak steps. At each iteration, the
+ * subproblem assignments are repaired into a feasible placement, giving upper
+ * bounds. It does not depend on any MIP solver.
+ ************************************************************************************/
+class Lagrangian {
+
+private:
+    const Data&                                         data;           /**< Data read in data.hpp **/
+    const PatternPricer                                 pricer;         /**< Solves the demand subproblems. **/
+    const int                                           nbWorkers;      /**< Number of threads solving the subproblems. **/
+
+    /*** Multipliers ***/
+    std::vector<double>                                 pi;             /**< Node capacity multipliers. pi[v] **/
+    std::vector< std::vector< std::vector<double> > >   mu;             /**< Linking multipliers. mu[k][i][v] **/
+
+    /*** Subproblem solutions ***/
+    std::vector< std::vector< std::vector<int> > >      xSol;           /**< Nodes assigned to each section. xSol[k][i] **/
+    std::vector<double>                                 subValue;       /**< Value of each demand subproblem. **/
+    std::vector< std::vector<int> >                     ySol;           /**< Placement subproblem solution. ySol[v][f] **/
+
+    /*** Execution ***/
+    int                                                 nbIterations;   /**< Number of subgradient iterations. **/
+    double                                              bestBound;      /**< Best Lagrangian bound. **/
+    double                                              bestValue;      /**< Cost of the best placement found. **/
+    bool                                                found;          /**< True if a feasible placement was found. **/
+    bool                                                infeasible;     /**< True if some demand subproblem has no solution. **/
+    Placement                                           best;           /**< The best placement found. **/
+    double                                              time;           /**< Time spent by the relaxation. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Capacity multipliers start at zero; linking multipliers share each placement cost among the sections that may use it. @param data_ The instance data. **/
+    Lagrangian(const Data& data_);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the best Lagrangian bound. **/
+    const double&       getBestBound()  const { return bestBound; }
+    /** Returns the best placement found. **/
+    const Placement&    getBest()       const { return best; }
+    /** Returns true if a feasible placement was found. **/
+    const bool&         hasFound()      const { return found; }
+    /** Returns true if the instance was proven infeasible. **/
+    const bool&         isInfeasible()  const { return infeasible; }
+    /** Returns true if a Lagrangian bound was computed. **/
+    const bool          hasBound()      const { return (bestBound > -DBL_MAX); }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Runs the subgradient algorithm until the step size vanishes, the gap closes, or the iteration or time limit is reached. **/
+    void run();
+
+	/****************************************************************************************/
+	/*									Solution Query  									*/
+	/****************************************************************************************/
+    /** Displays the obtained results. **/
+    void printResult();
+    /** Outputs the obtained results, in the same format as Model::output. **/
+    void output();
+    /** Writes the best placement found to the solution file. **/
+    void exportSolution();
+
+private:
+    /** Solves every subproblem for the current multipliers. Returns the Lagrangian value, or DBL_MAX if a demand has no feasible pattern. **/
+    double evaluate();
+    /** Solves the subproblems of the demands assigned to a worker. **/
+    void solveWorker(const int worker, const int nbThreads);
+
+    /** Computes the subgradient of the current solution. Returns its squared norm. @param gPi Stores the capacity components. @param gMu Stores the linking components. **/
+    double getSubgradient(std::vector<double>& gPi, std::vector< std::vector< std::vector<double> > >& gMu) const;
+
+    /** Builds a feasible placement from the subproblem assignments, completing the demands which do not fit. Demands with the largest load are placed first. **/
+    void repair();
+};
+
+#endif
@@ -2,31 +2,45 @@
 
 /** Constructor: Builds and exports the mathematical model to mip.lp file. Also sets up CPLEX parameters. **/
 Model::Model(const IloEnv& env_, const Data& data_) : 
-                env(env_), model(env), cplex(model), data(data_), 
-                obj(env), constraints(env)
+                env(env_), model(env), cplex(model), data(data_), presolve(data_), 
+                obj(env), constraints(env), approxConstraints(env), approxSOS(env), pwlCache(data_), symmetry(data_)
 {
 	std::cout << std::endl;
     std::cout << "=================================================================" << std::endl;
     std::cout << "-                  Building optimization model.                 -" << std::endl;
     std::cout << "=================================================================" << std::endl;
+    const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+    Profiler::Phase phase(data.getProfiler(), "Model");
+    if (data.getInput().isPresolve()){
+        Profiler::Phase presolvePhase(data.getProfiler(), "presolve");
+        presolve.run();
+    }
+    if (presolve.isInfeasible()){
+        throw std::runtime_error("ERROR: Some demand cannot reach the availability required. The instance is infeasible.");
+    }
     setVariables();
     setObjective();  
     setConstraints();  
     setCplexParameters();
-    cplex.exportModel("mip.lp");
+    {
+        Profiler::Phase exportPhase(data.getProfiler(), "exportModel");
+        cplex.exportModel("mip.lp");
+    }
+    buildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count();
     std::cout << std::endl << "Model was correctly built ! " << std::endl;                 
 }
 
 
 /** Set up the Cplex parameters. **/
 void Model::setCplexParameters(){
+    Profiler::Phase phase(data.getProfiler(), "setCplexParameters");
     std::cout << std::endl << "Setting up CPLEX optimization parameters... " << std::endl;
     // build callback
-    callback = new Callback(env, data, x, y, secAvail, secUnavail);
+    callback = new Callback(env, data, presolve, x, y, secAvail, secUnavail, logSecAvail, logSecUnavail);
 
     // define contexts on which the callback will be used
     CPXLONG contextmask = 0;
-    if (data.getInput().getLazy() == Input::LAZY_ON){
+    if (data.getInput().getLazy() == Input::LAZY_ON || data.getInput().isExactCheck() || data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_OUTER || data.getInput().isBenders()){
 	    contextmask |= IloCplex::Callback::Context::Id::Candidate;
     }
     contextmask |= IloCplex::Callback::Context::Id::Relaxation;
@@ -34,10 +48,18 @@ void Model::setCplexParameters(){
     // activate the callback usage
 	cplex.use(callback, contextmask);
 
+    // the exact check is meant to be combined with an approximation from above
+    if (data.getInput().isExactCheck() && data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_RESTRICTION){
+        std::cout << "WARNING: Exact check combined with a restriction may cut off feasible solutions. Consider availability_approx=1." << std::endl;
+    }
+
     /** Time limit definition **/
     cplex.setParam(IloCplex::Param::TimeLimit, data.getInput().getTimeLimit());
-	// Treads limited to one
-    cplex.setParam(IloCplex::Param::Threads, 1); 
+    // Treads limited to one: the callback keeps the current solution in shared members
+    if (data.getInput().getThreads() > 1){
+        std::cout << "WARNING: The branch-and-cut callback is not thread-safe, threads=" << data.getInput().getThreads() << " is ignored. Use solver=compact to solve with several threads." << std::endl;
+    }
+    cplex.setParam(IloCplex::Param::Threads, 1);
     
     // cplex.setParam(IloCplex::Param::MIP::Strategy::HeuristicFreq, -1); // Uncomment to desactivate CPLEX automatic heuristics
 }
@@ -47,6 +69,7 @@ void Model::setCplexParameters(){
 
 /** Set up variables **/
 void Model::setVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setVariables");
 
     std::cout << "Setting up variables... " << std::endl;
     // Define y variables
@@ -55,8 +78,8 @@ void Model::setVariables(){
     // Define x variables
     setAssignmentVariables();
 
-    // If routing is activated, define rounting related variables
-    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+    // If routing is activated, define rounting related variables (in Benders mode, routing is checked by the callback)
+    if (hasRoutingVariables()){
         setPairAssignmentVariables();
         setRoutingVariables();
         setDelayVariables();
@@ -74,6 +97,7 @@ void Model::setVariables(){
 /** Set up VNF placement variables: For any node v and VNF f, 
     y[v][f] =  1 if VNF f is installed on node v; 0 otherwise **/
 void Model::setPlacementVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setPlacementVariables");
     std::cout << "\t > Setting up VNF placement variables... " << std::endl;
     y.resize(lemon::countNodes(data.getGraph()));
     for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
@@ -82,11 +106,13 @@ void Model::setPlacementVariables(){
         for (int f = 0; f < data.getNbVnfs(); f++){
             int vnf = data.getVnf(f).getId();
             std::string name = "y(" + std::to_string(v) + "," + std::to_string(vnf) + ")";
+            // placements removed by the presolve are fixed to zero
+            const double UB = (presolve.isPlaceable(v, f) ? 1.0 : 0.0);
             if (data.getInput().isRelaxation()){
-                y[v][f] = IloNumVar(env, 0.0, 1.0, ILOFLOAT, name.c_str());
+                y[v][f] = IloNumVar(env, 0.0, UB, ILOFLOAT, name.c_str());
             }
             else{
-                y[v][f] = IloNumVar(env, 0.0, 1.0, ILOINT, name.c_str());
+                y[v][f] = IloNumVar(env, 0.0, UB, ILOINT, name.c_str());
             }
             model.add(y[v][f]);
         }
@@ -96,6 +122,7 @@ void Model::setPlacementVariables(){
 /** Set up VNF assignment variables: For any demand k, section i, and node v, 
     x[k][i][v] = 1 if the i-th VNF of SFC k can be processed on node v; 0 otherwise. **/
 void Model::setAssignmentVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setAssignmentVariables");
     std::cout << "\t > Setting up VNF assignment variables... " << std::endl;
     x.resize(data.getNbDemands());
     for (int k = 0; k < data.getNbDemands(); k++){
@@ -105,11 +132,13 @@ void Model::setAssignmentVariables(){
             for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
                 int v = data.getNodeId(n);
                 std::string name = "x(" + std::to_string(v) + "," + std::to_string(i) + "," + std::to_string(data.getDemand(k).getId()) + ")";
+                // assignments removed by the presolve are fixed to zero and left out of the constraints
+                const double UB = (presolve.isAssignable(k, i, v) ? 1.0 : 0.0);
                 if (data.getInput().isRelaxation()){
-                    x[k][i][v] = IloNumVar(env, 0.0, 1.0, ILOFLOAT, name.c_str());
+                    x[k][i][v] = IloNumVar(env, 0.0, UB, ILOFLOAT, name.c_str());
                 }
                 else{
-                    x[k][i][v] = IloNumVar(env, 0.0, 1.0, ILOINT, name.c_str());
+                    x[k][i][v] = IloNumVar(env, 0.0, UB, ILOINT, name.c_str());
                 }
                 model.add(x[k][i][v]);
             }
@@ -120,6 +149,7 @@ void Model::setAssignmentVariables(){
 /** Set up VNF pair assignment variables: For any demand k, section i, nodes s and t,
     z[k][i][s][t] = 1 if for demand k, its i-th VNF is installed on node s and its (i+1)-th VNF is installed on node t **/
 void Model::setPairAssignmentVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setPairAssignmentVariables");
     std::cout << "\t > Setting up VNF pair assignment variables... " << std::endl;
     z.resize(data.getNbDemands());
     for (int k = 0; k < data.getNbDemands(); k++){
@@ -160,6 +190,7 @@ void Model::setPairAssignmentVariables(){
 /** Set up SFC routing variables: For any demand k, section i, arc a, and nodes s and t,
     r[k][i][a][s][t] = 1 if the arc a is used for routing the i-th section of demand k from s to t **/
 void Model::setRoutingVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setRoutingVariables");
     std::cout << "\t > Setting up SFC routing variables... " << std::endl;
     r.resize(data.getNbDemands());
     for (int k = 0; k < data.getNbDemands(); k++){
@@ -208,6 +239,7 @@ void Model::setRoutingVariables(){
 /** Set up SFC delay variables: For any demand k, and section i,
     delay[k][i] corresponds to the maximal delay that can be obtained in this section **/
 void Model::setDelayVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setDelayVariables");
     std::cout << "\t > Setting up SFC delay variables... " << std::endl;
     delay.resize(data.getNbDemands());
     for (int k = 0; k < data.getNbDemands(); k++){
@@ -224,6 +256,7 @@ void Model::setDelayVariables(){
 /** Set up SFC arc usage variables: For any demand k, section i, and arc a,
     arc_usage[k][i][a] = 1 if arc a is used for routing the i-th section of demand k **/
 void Model::setArcUsageVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setArcUsageVariables");
     std::cout << "\t > Setting up SFC arc usage variables... " << std::endl;
     arc_usage.resize(data.getNbDemands());
     for (int k = 0; k < data.getNbDemands(); k++){
@@ -262,6 +295,7 @@ void Model::setArcUsageVariables(){
 /** Set up availability variables: For any demand k, and section i,
     secAvail[k][i] refers to the availability of the i-th section of demand k.**/
 void Model::setAvailabilityVariables(){
+    Profiler::Phase phase(data.getProfiler(), "setAvailabilityVariables");
     std::cout << "\t > Setting up section availability variables... " << std::endl;
     const int NB_DEMANDS = data.getNbDemands();
     secAvail.resize(NB_DEMANDS);
@@ -290,6 +324,25 @@ void Model::setAvailabilityVariables(){
             model.add(secUnavail[k][i]);
         }
     }
+
+    // logSecAvail and logSecUnavail are only used by the outer approximation
+    if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_OUTER){
+        logSecAvail.resize(NB_DEMANDS);
+        logSecUnavail.resize(NB_DEMANDS);
+        for (int k = 0; k < NB_DEMANDS; k++){
+            const int NB_VNFS = data.getDemand(k).getNbVNFs();
+            logSecAvail[k].resize(NB_VNFS);
+            logSecUnavail[k].resize(NB_VNFS);
+            for (int i = 0; i < NB_VNFS; i++){
+                std::string name = "logSecAvail(" + std::to_string(k) + "," + std::to_string(i) + ")";
+                logSecAvail[k][i] = IloNumVar(env, std::log(data.getDemand(k).getAvailability()), 0.0, ILOFLOAT, name.c_str());
+                model.add(logSecAvail[k][i]);
+                name = "logSecUnavail(" + std::to_string(k) + "," + std::to_string(i) + ")";
+                logSecUnavail[k][i] = IloNumVar(env, -IloInfinity, 0.0, ILOFLOAT, name.c_str());
+                model.add(logSecUnavail[k][i]);
+            }
+        }
+    }
 }
 
 /*************************************************************************/
@@ -298,6 +351,7 @@ void Model::setAvailabilityVariables(){
 
 /* Set up objective function. */
 void Model::setObjective(){
+    Profiler::Phase phase(data.getProfiler(), "setObjective");
 
     std::cout << "Setting up objective function... " << std::endl;
 
@@ -332,6 +386,7 @@ void Model::setObjective(){
 
 /* Set up constraints. */
 void Model::setConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setConstraints");
     std::cout << std::endl << "Setting up constraints... " << std::endl;
     // Placement related constraints
     setVnfAssignmentConstraints();
@@ -344,13 +399,12 @@ void Model::setConstraints(){
             setVnfPlacementConstraints();
         break;
         default:
-            std::cout << "ERROR: DISAGGREGATED_VNF_PLACEMENT not recognized." << std::endl;
-            exit(EXIT_FAILURE);
+            throw std::runtime_error("ERROR: DISAGGREGATED_VNF_PLACEMENT not recognized.");
         break;
     }
 
     // Routing related constraints
-    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+    if (hasRoutingVariables()){
         setDelayConstraints();
         setLinkingConstraints();
         setRoutingConstraints();
@@ -359,21 +413,27 @@ void Model::setConstraints(){
 
     // Availability approx related constraints
     if (data.getInput().getApproximationType() != Input::APPROXIMATION_TYPE_NONE){
-        setSFCAvailabilityApproxConstraints();
-        setSectionAvailabilityApproxConstraints();
+        setAvailabilityApproxConstraints();
     }
 
 
     if (data.getInput().getStrongNodeCapacity() == Input::STRONG_NODE_CAPACITY_ON){
         setStrongNodeCapacityConstraints();
     }
+
+    if (data.getInput().getSymmetryBreaking() != Input::SYMMETRY_BREAKING_OFF){
+        setSymmetryBreakingConstraints();
+    }
     
     model.add(constraints);
+    model.add(approxConstraints);
+    model.add(approxSOS);
 }
 
 /* Add up the original aggregated VNF placement constraints. */
 void Model::setOriginalVnfPlacementConstraints()
 {
+    Profiler::Phase phase(data.getProfiler(), "setOriginalVnfPlacementConstraints");
     std::cout << "\t > Setting up aggregated VNF Placement constraints... " << std::endl;
     for (int f = 0; f < data.getNbVnfs(); f++){
         for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
@@ -383,7 +443,7 @@ void Model::setOriginalVnfPlacementConstraints()
             for (int k = 0; k < data.getNbDemands(); k++){
                 for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
                     int f_ik = data.getDemand(k).getVNF_i(i);
-                    if (f_ik == f){
+                    if (f_ik == f && presolve.isAssignable(k, i, v)){
                         exp += x[k][i][v];
                     }
                 }
@@ -405,12 +465,14 @@ void Model::setOriginalVnfPlacementConstraints()
 /* Add up the VNF placement constraints: a VNF can only be assigned to a demand if it is already placed. */
 void Model::setVnfPlacementConstraints()
 {
+    Profiler::Phase phase(data.getProfiler(), "setVnfPlacementConstraints");
     std::cout << "\t > Setting up VNF Placement constraints... " << std::endl;
     for (int k = 0; k < data.getNbDemands(); k++){
         for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
             int f = data.getDemand(k).getVNF_i(i);
             for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
                 int v = data.getNodeId(n);
+                if (!presolve.isAssignable(k, i, v)) continue;
                 IloExpr exp(env);
                 exp += x[k][i][v];
                 exp -= y[v][f];
@@ -425,23 +487,25 @@ void Model::setVnfPlacementConstraints()
 
 /* Add up the VNF assignment constraints: At least lb VNFs must be assigned to each section of each demand. */
 void Model::setVnfAssignmentConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setVnfAssignmentConstraints");
     std::cout << "\t > Setting up VNF Assignment constraints... " << std::endl;
     for (int k = 0; k < data.getNbDemands(); k++){
         for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
             IloExpr exp(env);
             for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
                 int v = data.getNodeId(n);
-                exp += x[k][i][v];
+                if (presolve.isAssignable(k, i, v)){
+                    exp += x[k][i][v];
+                }
             }
             std::string name = "VNF_Assignment(" + std::to_string(k) + "," + std::to_string(i) + ")";
-            int rhs = data.getMinNbNodes(data.getDemand(k).getAvailability());
+            int rhs = presolve.getMinNbNodes(k, i);
             //std::cout << rhs << std::endl;
             if (rhs >= 1){
                 constraints.add(IloRange(env, rhs, exp, IloInfinity, name.c_str()));
             }
             else{
-                std::cerr << "ERROR: Error within method getMinNbNodes. \n" << std::endl;
-                exit(0);
+                throw std::runtime_error("ERROR: Error within method getMinNbNodes.");
             }
             exp.clear();
             exp.end();
@@ -451,6 +515,7 @@ void Model::setVnfAssignmentConstraints(){
 
 /* Add up the node capacity constraints: the bandwidth treated in a node must respect its capacity. */
 void Model::setNodeCapacityConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setNodeCapacityConstraints");
     std::cout << "\t > Setting up Node Capacity constraints... " << std::endl;
     for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
         int v = data.getNodeId(n);
@@ -458,6 +523,7 @@ void Model::setNodeCapacityConstraints(){
         double capacity = data.getNode(v).getCapacity();
         for (int k = 0; k < data.getNbDemands(); k++){
             for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                if (!presolve.isAssignable(k, i, v)) continue;
                 int vnf = data.getDemand(k).getVNF_i(i);
                 double coeff = data.getDemand(k).getBandwidth() * data.getVnf(vnf).getConsumption();
                 exp += (coeff * x[k][i][v]);
@@ -472,6 +538,7 @@ void Model::setNodeCapacityConstraints(){
 
 /* Add up the strong node capacity constraints. */
 void Model::setStrongNodeCapacityConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setStrongNodeCapacityConstraints");
     std::cout << "\t Setting up Strong Node Capacity constraints... " << std::endl;
     for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
         int v = data.getNodeId(n);
@@ -481,7 +548,7 @@ void Model::setStrongNodeCapacityConstraints(){
             for (int k = 0; k < data.getNbDemands(); k++){
                 for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
                     int vnf = data.getDemand(k).getVNF_i(i);
-                    if (vnf == f){
+                    if (vnf == f && presolve.isAssignable(k, i, v)){
                         double coeff = data.getDemand(k).getBandwidth() * data.getVnf(vnf).getConsumption();
                         exp += (coeff * x[k][i][v]);
                     }
@@ -498,6 +565,7 @@ void Model::setStrongNodeCapacityConstraints(){
 
 /* Add up the delay constraints. */
 void Model::setDelayConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setDelayConstraints");
     std::cout << "\t > Setting up Delay constraints... " << std::endl;
     // Section delay
     for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
@@ -542,6 +610,7 @@ void Model::setDelayConstraints(){
 
 /* Add up the linking constraints. */
 void Model::setLinkingConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setLinkingConstraints");
     std::cout << "\t > Setting up Linking constraints... " << std::endl;
     for (int k = 0; k < data.getNbDemands(); k++){
         const int NB_SECTIONS = data.getDemand(k).getNbVNFs()+1;
@@ -639,6 +708,7 @@ void Model::setLinkingConstraints(){
 
 /* Add up the routing constraints. */
 void Model::setRoutingConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setRoutingConstraints");
     std::cout << "\t > Setting up Routing constraints... " << std::endl;
     // tail route
     for (int k = 0; k < data.getNbDemands(); k++){
@@ -680,6 +750,7 @@ void Model::setRoutingConstraints(){
 
 /* Add up the bandwidth constraints. */
 void Model::setBandwidthConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setBandwidthConstraints");
     std::cout << "\t Setting up Bandwidth constraints... " << std::endl;
     for (ArcIt arc_it(data.getGraph()); arc_it != lemon::INVALID; ++arc_it){
         int a = data.getArcId(arc_it);
@@ -724,23 +795,148 @@ void Model::setBandwidthConstraints(){
     }
 }
 
+/* Add up the symmetry breaking constraints. */
+void Model::setSymmetryBreakingConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setSymmetryBreakingConstraints");
+    std::cout << "\t > Setting up Symmetry Breaking constraints... " << std::endl;
+    symmetry.print();
+
+    /* Interchangeable sections of a demand: g(k,i) <= g(k,j) for consecutive sections of an orbit. */
+    if (data.getInput().getSymmetryBreaking() == Input::SYMMETRY_BREAKING_SECTIONS){
+        for (int k = 0; k < data.getNbDemands(); k++){
+            const std::vector< std::vector<int> >& orbits = symmetry.getSectionOrbits(k);
+            for (unsigned int o = 0; o < orbits.size(); o++){
+                for (unsigned int p = 0; p+1 < orbits[o].size(); p++){
+                    const int i = orbits[o][p];
+                    const int j = orbits[o][p+1];
+                    IloExpr exp(env);
+                    for (int v = 0; v < data.getNbNodes(); v++){
+                        exp += Symmetry::getWeight(v) * x[k][i][v];
+                        exp -= Symmetry::getWeight(v) * x[k][j][v];
+                    }
+                    std::string name = "SectionOrder(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(j) + ")";
+                    constraints.add(IloRange(env, -IloInfinity, exp, 0, name.c_str()));
+                    exp.clear();
+                    exp.end();
+                }
+            }
+        }
+    }
+
+    /* Equivalent demands: g(k1) <= g(k2) for consecutive demands of an orbit, where g sums over all sections. */
+    const std::vector< std::vector<int> >& orbits = symmetry.getDemandOrbits();
+    for (unsigned int o = 0; o < orbits.size(); o++){
+        for (unsigned int p = 0; p+1 < orbits[o].size(); p++){
+            const int k1 = orbits[o][p];
+            const int k2 = orbits[o][p+1];
+            IloExpr exp(env);
+            for (int i = 0; i < data.getDemand(k1).getNbVNFs(); i++){
+                for (int v = 0; v < data.getNbNodes(); v++){
+                    exp += Symmetry::getWeight(v) * x[k1][i][v];
+                    exp -= Symmetry::getWeight(v) * x[k2][i][v];
+                }
+            }
+            std::string name = "DemandOrder(" + std::to_string(k1) + "," + std::to_string(k2) + ")";
+            constraints.add(IloRange(env, -IloInfinity, exp, 0, name.c_str()));
+            exp.clear();
+            exp.end();
+        }
+    }
+}
+
+/** Add up the availability approximation constraints corresponding to the chosen approximation type. **/
+void Model::setAvailabilityApproxConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setAvailabilityApproxConstraints");
+    if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_OUTER){
+        setOuterApproximationConstraints();
+    }
+    else{
+        setSFCAvailabilityApproxConstraints();
+        setSectionAvailabilityApproxConstraints();
+    }
+}
+
+/** Add up the outer approximation constraints. **/
+void Model::setOuterApproximationConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setOuterApproximationConstraints");
+    std::cout << "\t > Setting up outer approximation of availability constraints... " << std::endl;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        // The sum of section log-availabilities should be at least log(SLA)
+        IloExpr exp(env);
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            exp += logSecAvail[k][i];
+        }
+        std::string name = "ReqAvail(" + std::to_string(k) + ")";
+        double rhs = std::log(data.getDemand(k).getAvailability());
+        approxConstraints.add(IloRange(env, rhs, exp, IloInfinity, name.c_str()));
+        exp.clear();
+        exp.end();
+
+        const PwlCache::Approximation& availApprox   = pwlCache.get(PwlCache::LOG_AVAIL, k);
+        const PwlCache::Approximation& unavailApprox = pwlCache.get(PwlCache::LOG_UNAVAIL, k);
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            // Link between avail and unavail
+            IloExpr link(env);
+            link += secUnavail[k][i];
+            link += secAvail[k][i];
+            name = "availLink(" + std::to_string(k) + "," + std::to_string(i) + ")";
+            approxConstraints.add(IloRange(env, 1, link, 1, name.c_str()));
+            link.end();
+
+            // The log-unavailability of a section is the sum of the log-unavailabilities of its nodes
+            IloExpr section(env);
+            section += logSecUnavail[k][i];
+            for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
+                int v = data.getNodeId(n);
+                double coeff = std::log(1.0 - data.getNode(v).getAvailability());
+                section -= coeff * x[k][i][v];
+            }
+            name = "SectionAvail(" + std::to_string(k) + "," + std::to_string(i) + ")";
+            approxConstraints.add(IloRange(env, 0, section, 0, name.c_str()));
+            section.end();
+
+            // Initial tangents: log(z) <= log(t) + (z - t)/t
+            for (unsigned int t = 0; t < availApprox.touchs.size(); t++){
+                const double TOUCH = availApprox.touchs[t];
+                name = "AvailTangent(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(t) + ")";
+                approxConstraints.add(IloRange(env, -IloInfinity, logSecAvail[k][i] - (1.0/TOUCH)*secAvail[k][i], std::log(TOUCH) - 1.0, name.c_str()));
+            }
+            for (unsigned int t = 0; t < unavailApprox.touchs.size(); t++){
+                const double TOUCH = unavailApprox.touchs[t];
+                name = "UnavailTangent(" + std::to_string(k) + "," + std::to_string(i) + "," + std::to_string(t) + ")";
+                approxConstraints.add(IloRange(env, -IloInfinity, logSecUnavail[k][i] - (1.0/TOUCH)*secUnavail[k][i], std::log(TOUCH) - 1.0, name.c_str()));
+            }
+        }
+    }
+}
+
 void Model::setSFCAvailabilityApproxConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setSFCAvailabilityApproxConstraints");
     std::cout << "\t > Setting up section availability piecewise linear approximation constraints... " << std::endl;
 
     std::cout << "\t > Setting up approximated SFC availability constraints... " << std::endl;
     // The availability of a chain should be at least its required SLA
     for (int k = 0; k < data.getNbDemands(); k++){
         IloExpr exp(env);
-        IloNumArray breakpoints(env);
-        IloNumArray slopes(env);
-        // define the piecewise linear approximation parameters
-        buildApproximationFunctionAvail(k, breakpoints, slopes);
+        IloNumArray breakpoints;
+        IloNumArray slopes;
+        // get the piecewise linear approximation parameters
+        if (data.getInput().getPwlEncoding() == Input::PWL_ENCODING_CPLEX){
+            getApproximationFunction(PwlCache::LOG_AVAIL, k, breakpoints, slopes);
+        }
         for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
-            exp += IloPiecewiseLinear(secAvail[k][i], breakpoints, slopes, 1, 0);
+            if (data.getInput().getPwlEncoding() == Input::PWL_ENCODING_CPLEX){
+                exp += IloPiecewiseLinear(secAvail[k][i], breakpoints, slopes, 1, 0);
+            }
+            else{
+                IloExpr pwl = buildExplicitPwl(PwlCache::LOG_AVAIL, k, secAvail[k][i]);
+                exp += pwl;
+                pwl.end();
+            }
         }
         std::string name = "ReqAvail(" + std::to_string(k) + ")";
         double rhs = std::log(data.getDemand(k).getAvailability());
-        constraints.add(IloRange(env, rhs, exp, IloInfinity, name.c_str()));
+        approxConstraints.add(IloRange(env, rhs, exp, IloInfinity, name.c_str()));
         exp.clear();
         exp.end();
     }
@@ -753,7 +949,7 @@ void Model::setSFCAvailabilityApproxConstraints(){
             exp += secUnavail[k][i];
             exp += secAvail[k][i];
             std::string name = "availLink(" + std::to_string(k) + "," + std::to_string(i) + ")";
-            constraints.add(IloRange(env, 1, exp, 1, name.c_str()));
+            approxConstraints.add(IloRange(env, 1, exp, 1, name.c_str()));
             exp.clear();
             exp.end();
         }
@@ -761,17 +957,27 @@ void Model::setSFCAvailabilityApproxConstraints(){
 }
 
 void Model::setSectionAvailabilityApproxConstraints(){
+    Profiler::Phase phase(data.getProfiler(), "setSectionAvailabilityApproxConstraints");
 
     std::cout << "\t > Setting up approximated section unavailability constraints... " << std::endl;
     // The unavailability of a section should be at least the product of the unavailabilities of its nodes
     for (int k = 0; k < data.getNbDemands(); k++){ 
-        IloNumArray breakpoints(env);
-        IloNumArray slopes(env);
-        // define the piecewise linear approximation parameters
-        buildApproximationFunctionUnavail(k, breakpoints, slopes);
+        IloNumArray breakpoints;
+        IloNumArray slopes;
+        // get the piecewise linear approximation parameters
+        if (data.getInput().getPwlEncoding() == Input::PWL_ENCODING_CPLEX){
+            getApproximationFunction(PwlCache::LOG_UNAVAIL, k, breakpoints, slopes);
+        }
         for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
             IloExpr exp(env);
-            exp += IloPiecewiseLinear(secUnavail[k][i], breakpoints, slopes, 1, 0);
+            if (data.getInput().getPwlEncoding() == Input::PWL_ENCODING_CPLEX){
+                exp += IloPiecewiseLinear(secUnavail[k][i], breakpoints, slopes, 1, 0);
+            }
+            else{
+                IloExpr pwl = buildExplicitPwl(PwlCache::LOG_UNAVAIL, k, secUnavail[k][i]);
+                exp += pwl;
+                pwl.end();
+            }
             for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
                 int v = data.getNodeId(n);
                 double coeff = std::log(1.0 - data.getNode(v).getAvailability());
@@ -779,198 +985,366 @@ void Model::setSectionAvailabilityApproxConstraints(){
             }
             std::string name = "SectionAvail(" + std::to_string(k) + "," + std::to_string(i) + ")";
         
-            constraints.add(IloRange(env, 0, exp, 0, name.c_str()));
+            approxConstraints.add(IloRange(env, 0, exp, 0, name.c_str()));
             exp.clear();
             exp.end();
         }
     }
+    std::cout << "\t > " << pwlCache.getNbBuilt() << " piecewise linear functions built for " << data.getNbDemands() << " demands." << std::endl;
 }
 
-void Model::buildApproximationFunctionAvail(int demand, IloNumArray &breakpoints, IloNumArray &slopes){
-    //initialize parameters
-    breakpoints.clear();
-    slopes.clear();
-
-    // get touch points and breakpoints
-    IloNumArray touchs(env);
-    buildAvailTouchs(demand, touchs);
-    buildAvailBreakpoints(demand, breakpoints, touchs);
-
-    // get slopes
-    switch (data.getInput().getApproximationType()){
-        case Input::APPROXIMATION_TYPE_RESTRICTION:
-            slopes.add( 1.0/touchs[0] );
-            for (int i = 0; i < touchs.getSize()-1; i++){
-                double delta_X = touchs[i+1] - touchs[i];
-                double delta_Y = std::log(touchs[i+1]) - std::log(touchs[i]);
-                slopes.add( delta_Y/delta_X );
-            }
-            slopes.add( 0 );
-            
-            break;
-        case Input::APPROXIMATION_TYPE_RELAXATION:
-            for (unsigned int i = 0; i < touchs.getSize(); i++){
-                double tangent = 1.0/touchs[i];
-                slopes.add(tangent);
+/** Returns the piecewise linear approximation of a function of a given variable, encoded as a convex combination of its vertices. **/
+IloExpr Model::buildExplicitPwl(const PwlCache::Function function, const int demand, const IloNumVar& var){
+    const PwlCache::Approximation& approx = pwlCache.get(function, demand);
+    const std::string ID = std::to_string(function) + "," + std::to_string(demand) + "," + var.getName();
+
+    // vertices: variable bounds and the breakpoints in between
+    std::vector<double> vertices;
+    vertices.push_back(var.getLB());
+    for (unsigned int b = 0; b < approx.breakpoints.size(); b++){
+        if (approx.breakpoints[b] > var.getLB() + EPSILON && approx.breakpoints[b] < var.getUB() - EPSILON){
+            vertices.push_back(approx.breakpoints[b]);
+        }
+    }
+    if (var.getUB() > var.getLB() + EPSILON){
+        vertices.push_back(var.getUB());
+    }
+    const int NB_VERTICES = (int)vertices.size();
+
+    // convex combination of the vertices
+    IloNumVarArray lambda(env);
+    IloNumArray weights(env);
+    IloExpr value(env);
+    IloExpr convexity(env);
+    IloExpr link(env);
+    link += var;
+    for (int j = 0; j < NB_VERTICES; j++){
+        std::string name = "lambda(" + ID + "," + std::to_string(j) + ")";
+        lambda.add(IloNumVar(env, 0.0, 1.0, ILOFLOAT, name.c_str()));
+        weights.add(vertices[j]);
+        value += pwlCache.evaluate(approx, vertices[j]) * lambda[j];
+        convexity += lambda[j];
+        link -= vertices[j] * lambda[j];
+    }
+    approxConstraints.add(IloRange(env, 1, convexity, 1, ("pwlConvexity(" + ID + ")").c_str()));
+    approxConstraints.add(IloRange(env, 0, link, 0, ("pwlLink(" + ID + ")").c_str()));
+    convexity.end();
+    link.end();
+
+    const int NB_SEGMENTS = NB_VERTICES - 1;
+    if (NB_SEGMENTS <= 1){
+        return value;
+    }
+    if (data.getInput().getPwlEncoding() == Input::PWL_ENCODING_SOS2){
+        approxSOS.add(IloSOS2(env, lambda, weights, ("pwlSOS2(" + ID + ")").c_str()));
+        return value;
+    }
+
+    // logarithmic encoding: segment s (between vertices s-1 and s) is identified by the Gray code of s-1
+    int nbBits = 0;
+    while ((1 << nbBits) < NB_SEGMENTS) nbBits++;
+    for (int l = 0; l < nbBits; l++){
+        std::string name = "pwlBit(" + ID + "," + std::to_string(l) + ")";
+        IloNumVar bit(env, 0.0, 1.0, ILOINT, name.c_str());
+        IloExpr ones(env);
+        IloExpr zeros(env);
+        for (int j = 0; j < NB_VERTICES; j++){
+            // vertex j belongs to segments j and j+1
+            bool allOnes = true;
+            bool allZeros = true;
+            for (int segment = j; segment <= j+1; segment++){
+                if (segment < 1 || segment > NB_SEGMENTS) continue;
+                const int GRAY = (segment-1) ^ ((segment-1) >> 1);
+                if ((GRAY >> l) & 1) allZeros = false;
+                else allOnes = false;
             }
-            break;
-        default:
-            throw IloCplex::Exception(-1, "ERROR: Unexpected availability approx !");
+            if (allOnes)  ones  += lambda[j];
+            if (allZeros) zeros += lambda[j];
+        }
+        approxConstraints.add(IloRange(env, -IloInfinity, ones - bit, 0, ("pwlBitOne(" + ID + "," + std::to_string(l) + ")").c_str()));
+        approxConstraints.add(IloRange(env, -IloInfinity, zeros + bit, 1, ("pwlBitZero(" + ID + "," + std::to_string(l) + ")").c_str()));
+        ones.end();
+        zeros.end();
     }
+    return value;
 }
 
+/** Returns the piecewise linear approximation of a function for a given demand. Arrays are built once for each SLA class and shared by all demands of the class. **/
+void Model::getApproximationFunction(const PwlCache::Function function, const int demand, IloNumArray &breakpoints, IloNumArray &slopes){
+    const PwlCache::Key KEY = pwlCache.getKey(function, demand);
+    std::map<PwlCache::Key, std::pair<IloNumArray, IloNumArray> >::iterator it = pwlArrays.find(KEY);
+    if (it == pwlArrays.end()){
+        const PwlCache::Approximation& approx = pwlCache.get(function, demand);
+        IloNumArray cachedBreakpoints(env);
+        IloNumArray cachedSlopes(env);
+        for (unsigned int b = 0; b < approx.breakpoints.size(); b++){
+            cachedBreakpoints.add(approx.breakpoints[b]);
+        }
+        for (unsigned int s = 0; s < approx.slopes.size(); s++){
+            cachedSlopes.add(approx.slopes[s]);
+        }
+        it = pwlArrays.insert(std::make_pair(KEY, std::make_pair(cachedBreakpoints, cachedSlopes))).first;
+    }
+    breakpoints = it->second.first;
+    slopes      = it->second.second;
+}
 
-/* Set up the vector u for approximating log(avail). */
-void Model::buildAvailTouchs(int demand, IloNumArray &touchs){
-    const int NB_BREAKS  = data.getInput().getNbBreakpoints();
-    int       NB_TOUCHS  = NB_BREAKS;
 
-    // If approximation from above
-    if (data.getInput().getApproximationType() ==  Input::APPROXIMATION_TYPE_RELAXATION){
-        NB_TOUCHS = NB_BREAKS + 1;
+void Model::run()
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                Running optimization procedure.                -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    
+    if (data.getInput().isGreedyStart()){
+        Profiler::Phase phase(data.getProfiler(), "runGreedyStart");
+        runGreedyStart();
+    }
+    if (!data.getInput().getWarmStartFile().empty()){
+        Profiler::Phase phase(data.getProfiler(), "loadWarmStart");
+        loadWarmStart();
+    }
+    {
+        Profiler::Phase phase(data.getProfiler(), "solve");
+        time = cplex.getCplexTime();
+        cplex.solve();
+        time = cplex.getCplexTime() - time;
     }
 
-    // get upper and lower bounds for avail
-    const double MIN_AVAIL = data.getDemand(demand).getAvailability();
-    const double LB = MIN_AVAIL;
-    const double UB = 1.0;
-    // const double UB = data.getParallelAvailability(data.getNMostAvailableNodes(5));
-    for (int t = 1; t <= NB_TOUCHS; t++){
-        double exponent  = ((double) (NB_TOUCHS - t)) / (NB_TOUCHS - 1);
-        double touch_val = UB * std::pow((LB / UB), exponent);
-        touchs.add(touch_val);
+    if (data.getInput().isAdaptiveBreakpoints() && data.getInput().getApproximationType() != Input::APPROXIMATION_TYPE_NONE){
+        Profiler::Phase phase(data.getProfiler(), "runAdaptiveRefinement");
+        runAdaptiveRefinement();
     }
-    // std::cout << "Avail touchs: " << touchs << std::endl;
+
+    callback->saveCutCache();
 }
 
-/* Set up the breakpoints for approximating log(avail). */
-void Model::buildAvailBreakpoints(int demand, IloNumArray &breakpoints, IloNumArray &touchs){
-    
-    if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_RELAXATION){
-        for (int k = 1; k < touchs.getSize(); k++){
-            double log_u_k1 = std::log(touchs[k]);
-            double log_u_k = std::log(touchs[k-1]);
-            double inv_u_k1 = 1.0/touchs[k];
-            double inv_u_k = 1.0/touchs[k-1];
-            
-            breakpoints.add( (log_u_k1 - log_u_k) / (inv_u_k - inv_u_k1) );
+/** Refines the availability approximation around the worst approximated values and re-solves, warm started from the previous solution, until the availability violation falls below the tolerance. **/
+void Model::runAdaptiveRefinement(){
+    const double TOLERANCE = data.getInput().getAdaptiveTolerance();
+    for (int iter = 1; iter < data.getInput().getAdaptiveMaxIterations(); iter++){
+        if (cplex.getStatus() != IloAlgorithm::Feasible && cplex.getStatus() != IloAlgorithm::Optimal){
+            std::cout << "Adaptive refinement: no solution available, stopping." << std::endl;
+            return;
         }
-    }
-    else{
-        for (int k = 0; k < touchs.getSize(); k++){
-            breakpoints.add(touchs[k]);
+        const double VIOLATION = getMaxAvailViolation();
+        std::cout << "Adaptive refinement " << iter << ": " << getNbAvailViolation() << " violated demands, max violation " << VIOLATION << "." << std::endl;
+        if (VIOLATION <= TOLERANCE){
+            return;
         }
+        Placement previous = getPlacement();
+        if (refineApproximation() == 0){
+            std::cout << "Adaptive refinement: no breakpoint could be added, stopping." << std::endl;
+            return;
+        }
+        addMIPStart(previous, std::vector< std::vector< std::vector< std::pair<int,int> > > >(), "Refinement");
+
+        const double START = cplex.getCplexTime();
+        cplex.solve();
+        time += cplex.getCplexTime() - START;
     }
 }
 
-void Model::buildApproximationFunctionUnavail(int demand, IloNumArray &breakpoints, IloNumArray &slopes){
-    //initialize parameters
-    breakpoints.clear();
-    slopes.clear();
-    
-    // get touch points and breakpoints
-    IloNumArray touchs(env);
-    buildUnavailTouchs(demand, touchs);
-    buildUnavailBreakpoints(demand, breakpoints, touchs);
-
-    switch (data.getInput().getApproximationType()){
-        case Input::APPROXIMATION_TYPE_RESTRICTION:
-            slopes.add(1.0/breakpoints[0]);
-            for (int i = 0; i < breakpoints.getSize()-1; i++){
-                double delta_X = breakpoints[i+1] - breakpoints[i];
-                double delta_Y = std::log(breakpoints[i+1]) - std::log(breakpoints[i]);
-                slopes.add( delta_Y/delta_X );
+/** Adds touch points where the approximation error is largest and rebuilds the approximation constraints. Returns the number of touch points added. **/
+int Model::refineApproximation(){
+    /* Only sections of violated demands are considered, unless no demand is violated. */
+    std::vector<int> demands;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        if (getServiceAvail(k) + 1e-12 < data.getDemand(k).getAvailability()){
+            demands.push_back(k);
+        }
+    }
+    if (demands.empty()){
+        demands.resize(data.getNbDemands());
+        std::iota(demands.begin(), demands.end(), 0);
+    }
+
+    /* For each approximation, find the value with the largest error. */
+    std::map<PwlCache::Key, std::pair<double, std::pair<int, double> > > worst;
+    for (unsigned int d = 0; d < demands.size(); d++){
+        const int k = demands[d];
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            const double AVAIL   = cplex.getValue(secAvail[k][i]);
+            const double UNAVAIL = cplex.getValue(secUnavail[k][i]);
+            const double ERROR_AVAIL   = pwlCache.getError(PwlCache::LOG_AVAIL, k, AVAIL);
+            const double ERROR_UNAVAIL = pwlCache.getError(PwlCache::LOG_UNAVAIL, k, UNAVAIL);
+            const PwlCache::Key KEY_AVAIL   = pwlCache.getKey(PwlCache::LOG_AVAIL, k);
+            const PwlCache::Key KEY_UNAVAIL = pwlCache.getKey(PwlCache::LOG_UNAVAIL, k);
+            if (worst.find(KEY_AVAIL) == worst.end() || ERROR_AVAIL > worst[KEY_AVAIL].first){
+                worst[KEY_AVAIL] = std::make_pair(ERROR_AVAIL, std::make_pair(k, AVAIL));
             }
-            slopes.add(0);
-            break;
-        case Input::APPROXIMATION_TYPE_RELAXATION:
-            for (int i = 0; i < touchs.getSize(); i++){
-                double tangent = 1.0/touchs[i];
-                slopes.add(tangent);
+            if (worst.find(KEY_UNAVAIL) == worst.end() || ERROR_UNAVAIL > worst[KEY_UNAVAIL].first){
+                worst[KEY_UNAVAIL] = std::make_pair(ERROR_UNAVAIL, std::make_pair(k, UNAVAIL));
             }
-            break;
-        default:
-            throw IloCplex::Exception(-1, "ERROR: Unexpected availability approx !");
+        }
+    }
+
+    int nbAdded = 0;
+    for (std::map<PwlCache::Key, std::pair<double, std::pair<int, double> > >::iterator it = worst.begin(); it != worst.end(); ++it){
+        const PwlCache::Function FUNCTION = (PwlCache::Function)std::get<0>(it->first);
+        if (it->second.first > EPSILON && pwlCache.addTouch(FUNCTION, it->second.second.first, it->second.second.second)){
+            std::map<PwlCache::Key, std::pair<IloNumArray, IloNumArray> >::iterator cached = pwlArrays.find(it->first);
+            if (cached != pwlArrays.end()){
+                cached->second.first.end();
+                cached->second.second.end();
+                pwlArrays.erase(cached);
+            }
+            nbAdded++;
+        }
+    }
+    if (nbAdded == 0){
+        return 0;
+    }
+
+    /* Rebuild the approximation constraints with the new breakpoints. */
+    model.remove(approxConstraints);
+    model.remove(approxSOS);
+    approxConstraints.endElements();
+    approxSOS.endElements();
+    approxConstraints = IloRangeArray(env);
+    approxSOS = IloConstraintArray(env);
+    setAvailabilityApproxConstraints();
+    model.add(approxConstraints);
+    model.add(approxSOS);
+    std::cout << "\t " << nbAdded << " touch points added." << std::endl;
+    return nbAdded;
+}
+
+/** Runs the greedy start heuristic and gives its best placement to CPLEX as a MIP start. **/
+void Model::runGreedyStart(){
+    Greedy greedy(data);
+    if (greedy.run(data.getInput().getGreedyStartWorkers(), data.getInput().getGreedyStartIterations(), data.getInput().getRandomSeed())){
+        greedy.getBest().print();
+        addMIPStart(greedy.getBest(), std::vector< std::vector< std::vector< std::pair<int,int> > > >(), "GreedyStart");
     }
-    // std::cout << "touchs: " << touchs << std::endl;
-    // std::cout << "breakpoints: " << breakpoints << std::endl;
-    // std::cout << "slopes: " << slopes << std::endl;
 }
-/* Set up the vector u for approximating log(unavail). */
-void Model::buildUnavailTouchs(int demand, IloNumArray &touchs){
-
-    const int NB_BREAKS  = data.getInput().getNbBreakpoints();
-    int       NB_TOUCHS  = NB_BREAKS;
-
-    // If approximation from above
-    if (data.getInput().getApproximationType() ==  Input::APPROXIMATION_TYPE_RELAXATION){
-        NB_TOUCHS = NB_BREAKS + 1;
-    }
-
-    const double minAvail = data.getDemand(demand).getAvailability();
-    // const double minAvail = data.getParallelAvailability(data.getNMostAvailableNodes(1));
-    const double maxAvail = data.getParallelAvailability(data.getAvailNodeRank());
-    // const double maxAvail = data.getParallelAvailability(data.getNMostAvailableNodes(5));
-    const double EPSILON_PRECISION = 1e-8;
-    double UB = std::min(1.0 - minAvail, 1.0 - EPSILON_PRECISION);
-    double LB = std::max(1.0 - maxAvail, EPSILON_PRECISION);
-    // std::cout <<"UB : " << UB << std::endl;
-    // std::cout <<"LB : " << LB << std::endl;
-
-    /** billionnet spacement of touchs **/
-    for (int k = 1; k <= NB_TOUCHS; k++){
-        double expo = ((double) (NB_TOUCHS - k)) / (NB_TOUCHS - 1);
-        // std::cout <<"exp : " << expo << std::endl;
-        double u = (UB) * std::pow((LB/UB), expo);
-        // std::cout <<"touch : " << u << std::endl;
-        touchs.add(u);
-    }
-
-    /** linearly spaced touchs **/
-    // double interval = (UB - LB)/(NB_TOUCHS-1);
-    // for (int k = 0; k < NB_TOUCHS; k++){
-    //     double u = LB + interval*k;
-    //     touchs.add(u);
-    // }
 
+/** Reads the warm start file, repairs it with respect to the current data and gives it to CPLEX as a MIP start. **/
+void Model::loadWarmStart(){
+    std::cout << "Loading warm start..." << std::endl;
+    Placement placement(data);
+    placement.read(data.getInput().getWarmStartFile());
 
-    touchs.add(1.0);
-    // std::cout <<"Unavail touchs : " << touchs << std::endl;
+    /* Repair first: routing is only kept for demands whose sections are left unchanged by the repair. */
+    const bool FEASIBLE = placement.repair();
+    int nbModified = 0;
+    for (int k = 0; k < data.getNbDemands(); k++){
+        if (placement.isModified(k)) nbModified++;
+    }
+    if (!FEASIBLE){
+        std::cout << "WARNING: Warm start could not be made feasible. CPLEX will try to repair it." << std::endl;
+    }
+    std::cout << "\t " << nbModified << " demands were repaired or completed." << std::endl;
+
+    std::vector< std::vector< std::vector< std::pair<int,int> > > > routing(data.getNbDemands());
+    if (hasRoutingVariables()){
+        for (int k = 0; k < data.getNbDemands(); k++){
+            routing[k].resize(data.getDemand(k).getNbVNFs()+1);
+        }
+        Reader reader(data.getInput().getWarmStartFile());
+        std::vector<std::vector<std::string> > dataList = reader.getData();
+        for (unsigned int l = 0; l < dataList.size(); l++){
+            if (dataList[l].size() != 5 || dataList[l][0] != "z"){
+                continue;
+            }
+            const int k = data.getIdFromDemandName(dataList[l][1]);
+            if (k == -1 || placement.isModified(k) || !data.hasNode(dataList[l][3]) || !data.hasNode(dataList[l][4])){
+                continue;
+            }
+            /* The section index has at most as many digits as the number of sections. */
+            const std::string& SECTION = dataList[l][2];
+            if (SECTION.empty() || SECTION.size() > std::to_string(data.getDemand(k).getNbVNFs()).size() || SECTION.find_first_not_of("0123456789") != std::string::npos){
+                std::cout << "WARNING: Invalid section index '" << SECTION << "' for demand " << dataList[l][1] << " in " << data.getInput().getWarmStartFile() << ". Line is skipped." << std::endl;
+                continue;
+            }
+            const int i = std::stoi(SECTION);
+            if (i <= data.getDemand(k).getNbVNFs()){
+                routing[k][i].push_back(std::make_pair(data.getIdFromNodeName(dataList[l][3]), data.getIdFromNodeName(dataList[l][4])));
+            }
+        }
+    }
+
+    placement.print();
+    addMIPStart(placement, routing, "WarmStart");
 }
 
-/* Set up the breakpoints for approximating log(unavail). */
-void Model::buildUnavailBreakpoints(int demand, IloNumArray &breakpoints, IloNumArray &touchs){
-    // std::cout << "NBtouchs " << touchs.getSize()-1 << std::endl;
-    if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_RELAXATION){
-        for (int k = 1; k <= touchs.getSize()-1; k++){
-            double log_u_k1 = std::log(touchs[k]);
-            double log_u_k = std::log(touchs[k-1]);
-            double inv_u_k1 = 1.0/touchs[k];
-            double inv_u_k = 1.0/touchs[k-1];
-            breakpoints.add( (log_u_k1 - log_u_k) / (inv_u_k - inv_u_k1) );
-            
-            // std::cout << "break[" << k-1 << "] = " << breakpoints[k-1] << std::endl;
+/** Gives a placement to CPLEX as a MIP start. **/
+void Model::addMIPStart(const Placement& placement, const std::vector< std::vector< std::vector< std::pair<int,int> > > >& routing, const std::string name){
+    IloNumVarArray startVar(env);
+    IloNumArray startVal(env);
+    for (int v = 0; v < data.getNbNodes(); v++){
+        for (int f = 0; f < data.getNbVnfs(); f++){
+            startVar.add(y[v][f]);
+            startVal.add(placement.isPlaced(v, f) ? 1.0 : 0.0);
         }
     }
-    else{
-        for (int k = 0; k < touchs.getSize(); k++){
-            breakpoints.add(touchs[k]);
+
+    /* When symmetries are broken, the assignments of each orbit are sorted so that the start satisfies the ordering constraints. */
+    std::vector<int> demandFrom(data.getNbDemands());
+    std::vector< std::vector<int> > sectionFrom(data.getNbDemands());
+    std::iota(demandFrom.begin(), demandFrom.end(), 0);
+    for (int k = 0; k < data.getNbDemands(); k++){
+        sectionFrom[k].resize(data.getDemand(k).getNbVNFs());
+        std::iota(sectionFrom[k].begin(), sectionFrom[k].end(), 0);
+    }
+    if (data.getInput().getSymmetryBreaking() == Input::SYMMETRY_BREAKING_SECTIONS){
+        for (int k = 0; k < data.getNbDemands(); k++){
+            std::vector<double> value(data.getDemand(k).getNbVNFs());
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                value[i] = getOrderingValue(placement, k, i);
+            }
+            sectionFrom[k] = Symmetry::sortOrbits(symmetry.getSectionOrbits(k), value);
         }
     }
-    // std::cout << "end breaks" << std::endl;
-}
+    if (data.getInput().getSymmetryBreaking() != Input::SYMMETRY_BREAKING_OFF){
+        std::vector<double> value(data.getNbDemands(), 0.0);
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+                value[k] += getOrderingValue(placement, k, i);
+            }
+        }
+        demandFrom = Symmetry::sortOrbits(symmetry.getDemandOrbits(), value);
+    }
 
+    for (int k = 0; k < data.getNbDemands(); k++){
+        const int from = demandFrom[k];
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                startVar.add(x[k][i][v]);
+                startVal.add(placement.isAssigned(from, sectionFrom[from][i], v) ? 1.0 : 0.0);
+            }
+        }
+    }
+    if (hasRoutingVariables()){
+        for (int k = 0; k < data.getNbDemands(); k++){
+            const int from = demandFrom[k];
+            if (placement.isModified(from) || from >= (int)routing.size()){
+                continue;
+            }
+            for (unsigned int i = 0; i < routing[from].size(); i++){
+                for (unsigned int p = 0; p < routing[from][i].size(); p++){
+                    startVar.add(z[k][i][routing[from][i][p].first][routing[from][i][p].second]);
+                    startVal.add(1.0);
+                }
+            }
+        }
+    }
+    /* Routing variables not given are completed by CPLEX. */
+    cplex.addMIPStart(startVar, startVal, IloCplex::MIPStartAuto, name.c_str());
+    startVar.end();
+    startVal.end();
+}
 
-void Model::run()
-{
-	std::cout << std::endl;
-    std::cout << "=================================================================" << std::endl;
-    std::cout << "-                Running optimization procedure.                -" << std::endl;
-    std::cout << "=================================================================" << std::endl;
-    
-    time = cplex.getCplexTime();
-	cplex.solve();
-	time = cplex.getCplexTime() - time;
+/* Returns the ordering function g used by the symmetry breaking constraints for section i of demand k in a given placement. */
+double Model::getOrderingValue(const Placement& placement, const int k, const int i) const {
+    double value = 0.0;
+    for (int v = 0; v < data.getNbNodes(); v++){
+        if (placement.isAssigned(k, i, v)){
+            value += Symmetry::getWeight(v);
+        }
+    }
+    return value;
 }
 
 int Model::getNbAvailViolation(){
@@ -1029,6 +1403,10 @@ void Model::printResult(){
     std::cout << "\t Nodes evaluated:           " << cplex.getNnodes()                  << std::endl;
     std::cout << "\t User cuts added:           " << callback->getNbUserCuts()          << std::endl;
     std::cout << "\t Lazy constraints added:    " << callback->getNbLazyConstraints()   << std::endl;
+    std::cout << "\t Lifted cuts in pool:       " << callback->getNbLiftedCuts()        << std::endl;
+    std::cout << "\t Tangent cuts:              " << callback->getNbTangentCuts()       << std::endl;
+    std::cout << "\t Exact check rejections:    " << callback->getNbExactRejections()   << std::endl;
+    std::cout << "\t Benders cuts:              " << callback->getNbBendersCuts()       << std::endl;
     std::cout << "\t Time on cuts:              " << callback->getTime()                << std::endl;
     std::cout << "\t Total time:                " << time << std::endl                  << std::endl;
 
@@ -1045,7 +1423,7 @@ void Model::printDemand(const int demand){
         }
     }
     // print routing
-    if (data.getInput().getRoutingActivation() == Input::ROUTING_ON){
+    if (hasRoutingVariables()){
         std::cout << "\t Routing: " << std::endl;
         for (int i = 0; i < data.getDemand(demand).getNbVNFs()+1; i++){
             printRouting(demand, i);
@@ -1127,8 +1505,7 @@ void Model::printPath(const int demand, const int section, Graph::Node &source,
             }
         }
         if (currentNode == nextNode){
-            std::cerr << std::endl << "ERROR: Could not find next node on path." << std::endl;
-            exit(EXIT_FAILURE);
+            throw std::runtime_error("ERROR: Could not find next node on path.");
         }
     }
     if (section == data.getDemand(demand).getNbVNFs()){
@@ -1138,26 +1515,54 @@ void Model::printPath(const int demand, const int section, Graph::Node &source,
         std::cout << t << "(" << data.getVnf(data.getDemand(demand).getVNF_i(section)).getName() << ");" << std::endl;
     }
 }
-void Model::output(){
-    std::cout << "Writting results to file..." << std::endl;
-    std::string output_file = data.getInput().getOutputFile();
-    if (output_file.empty()){
-        std::cout << "Warning: There is no output file." << std::endl;
+/** Returns the placement given by the best solution found. **/
+Placement Model::getPlacement(){
+    Placement placement(data);
+    for (int k = 0; k < data.getNbDemands(); k++){
+        for (int i = 0; i < data.getDemand(k).getNbVNFs(); i++){
+            for (int v = 0; v < data.getNbNodes(); v++){
+                if (cplex.getValue(x[k][i][v]) > 1.0 - EPS){
+                    if (!placement.assign(k, i, v)){
+                        std::cout << "WARNING: Solution violates the capacity of node " << data.getNode(v).getName() << "." << std::endl;
+                    }
+                }
+            }
+        }
+    }
+    return placement;
+}
+
+/** Writes the best solution found to the solution file. **/
+void Model::exportSolution(){
+    std::string solution_file = data.getInput().getSolutionFile();
+    if (solution_file.empty()){
+        return;
+    }
+    if (cplex.getStatus() != IloAlgorithm::Feasible && cplex.getStatus() != IloAlgorithm::Optimal){
+        std::cout << "Warning: No solution to be written." << std::endl;
         return;
     }
+    std::cout << "Writting solution to file..." << std::endl;
+    getPlacement().write(solution_file);
 
-	std::ofstream fileReport(output_file, std::ios_base::app); // File report
-    // If file_output can't be opened 
-    if(!fileReport)
-    {
-        std::cerr << "ERROR: Unable to access output file." << std::endl;
-        exit(EXIT_FAILURE);
+    if (hasRoutingVariables()){
+        std::ofstream file(solution_file, std::ios_base::app);
+        for (int k = 0; k < data.getNbDemands(); k++){
+            for (int i = 0; i <= data.getDemand(k).getNbVNFs(); i++){
+                for (int s = 0; s < data.getNbNodes(); s++){
+                    for (int t = 0; t < data.getNbNodes(); t++){
+                        if (cplex.getValue(z[k][i][s][t]) > 1.0 - EPS){
+                            file << "z;" << data.getDemand(k).getName() << ";" << i << ";" << data.getNode(s).getName() << ";" << data.getNode(t).getName() << std::endl;
+                        }
+                    }
+                }
+            }
+        }
+        file.close();
     }
+}
 
-    std::string demand_name = data.getInput().getDemandFile();
-    std::string node_name   = data.getInput().getNodeFile();
-    std::string link_name   = data.getInput().getLinkFile();
-    std::string vnf_name    = data.getInput().getVnfFile();
+void Model::output(){
     std::string relax_type  = "";
     if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_NONE){
         relax_type = "NO_APPROX";
@@ -1168,29 +1573,38 @@ void Model::output(){
     if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_RELAXATION){
         relax_type = "RELAX_" + std::to_string(data.getInput().getNbBreakpoints());
     }
-    std::string instance_name = node_name + "_" + demand_name;
-
-    fileReport << link_name << ";"
-    		   << node_name << ";"
-    		   << demand_name << ";"
-    		   << vnf_name << ";"
-    		   << relax_type << ";"
-    		   << time << ";"
-    		   << cplex.getObjValue() << ";"
-    		   << cplex.getBestObjValue() << ";"
-    		   << cplex.getMIPRelativeGap()*100 << ";"
-    		   << cplex.getNnodes() << ";"
-    		   << cplex.getNnodesLeft() << ";" 
-               << callback->getNbLazyConstraints() << ";" 
-    		   << callback->getNbUserCuts() << ";" 
-    		   << callback->getTime() << ";" 
-               << getNbAvailViolation() << ";"
-               << getMaxAvailViolation() << ";"
-               << std::endl;
-    		   
-    // Finalization ***
-    fileReport.close();
+    if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_OUTER){
+        relax_type = "OUTER_" + std::to_string(data.getInput().getNbBreakpoints());
+    }
+    if (data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_RESTRICTION || data.getInput().getApproximationType() == Input::APPROXIMATION_TYPE_RELAXATION){
+        if (data.getInput().getPwlEncoding() == Input::PWL_ENCODING_SOS2)           relax_type += "_SOS2";
+        if (data.getInput().getPwlEncoding() == Input::PWL_ENCODING_LOGARITHMIC)    relax_type += "_LOG";
+    }
 
+    Results results(data, "mip");
+    results.add("relax_type",       relax_type,                             true);
+    results.add("time",             (double)time,                           true);
+    results.add("objective",        (double)cplex.getObjValue(),            true);
+    results.add("best_bound",       (double)cplex.getBestObjValue(),        true);
+    results.add("gap",              (double)cplex.getMIPRelativeGap()*100,  true);
+    results.add("nodes",            (long)cplex.getNnodes(),                true);
+    results.add("nodes_left",       (long)cplex.getNnodesLeft(),            true);
+    results.add("lazy_constraints", callback->getNbLazyConstraints(),      true);
+    results.add("user_cuts",        callback->getNbUserCuts(),              true);
+    results.add("callback_time",    (double)callback->getTime(),            true);
+    results.add("nb_avail_violations", getNbAvailViolation(),              true);
+    results.add("max_avail_violation", getMaxAvailViolation(),             true);
+    results.add("build_time",       buildTime);
+    results.add("iterations",       0);
+    results.add("columns",          0);
+    results.add("cuts_per_family",  callback->getNbCutsPerFamily());
+    results.add("lifted_cuts",      callback->getNbLiftedCuts());
+    results.add("exact_rejections", callback->getNbExactRejections());
+    results.write();
+
+    if (!data.getInput().getSeparationProfileFile().empty()){
+        callback->getSeparationProfile().write(data.getInput().getSeparationProfileFile());
+    }
 }
 
 /****************************************************************************************/
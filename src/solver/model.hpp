@@ -8,8 +8,14 @@
 
 /*** Own Libraries ***/
 #include "callback.hpp"
+#include "../heuristic/greedy.hpp"
+#include "pwl.hpp"
+#include "../instance/symmetry.hpp"
+#include "../instance/presolve.hpp"
+#include "../tools/results.hpp"
 
 #include <limits>
+#include <chrono>
 /****************************************************************************************/
 /*										TYPEDEFS										*/
 /****************************************************************************************/
@@ -40,6 +46,7 @@ class Model
 	 	IloModel        model;  /**< IBM Model **/
 		IloCplex        cplex;  /**< IBM Cplex **/
 		const Data&     data;   /**< Data read from parameters files **/
+		Presolve        presolve; /**< Variables fixed before the model is built **/
 
 		/*** Formulation specific ***/
 		
@@ -56,14 +63,26 @@ class Model
 		// Approximation related Variables
 		IloNumVarMatrix secAvail;			/**< Real variable between 0 and 1 representing the availability of a section**/
 		IloNumVarMatrix secUnavail;			/**< Real variable between 0 and 1 representing the unavailability of a section**/
+		IloNumVarMatrix logSecAvail;		/**< Real variable bounded by log(secAvail), used by the outer approximation **/
+		IloNumVarMatrix logSecUnavail;		/**< Real variable bounded by log(secUnavail), used by the outer approximation **/
 		
 		/*** Formulation general ***/
 		IloObjective    	obj;            /**< Objective function **/
 		IloRangeArray   	constraints;    /**< Set of constraints **/
+		IloRangeArray   	approxConstraints; /**< Set of availability approximation constraints, rebuilt when breakpoints are refined **/
+		IloConstraintArray	approxSOS;		/**< SOS2 constraints of the explicit piecewise linear encodings **/
+
+		/*** Approximation ***/
+		PwlCache			pwlCache;		/**< Piecewise linear approximations shared by demands with the same SLA **/
+		std::map<PwlCache::Key, std::pair<IloNumArray, IloNumArray> > pwlArrays; /**< Breakpoints and slopes given to CPLEX for each approximation **/
+
+		/*** Symmetry ***/
+		Symmetry			symmetry;		/**< Orbits of equivalent demands and interchangeable sections **/
 
 		/*** Manage execution and control ***/
 		Callback* 			callback; 		/**< User generic callback **/
 		IloNum time;						/**< Time spent during the optimization **/
+		double buildTime;					/**< Time spent building the model **/
 
 	public:
 	/****************************************************************************************/
@@ -121,8 +140,14 @@ class Model
         void setLinkingConstraints();
         /** Add up the routing constraints: There must be a path between any two consecutive VNFs. **/
         void setRoutingConstraints();
+        /** Add up the symmetry breaking constraints: equivalent demands (and interchangeable sections) are ordered by the weighted sum of their assigned nodes. **/
+        void setSymmetryBreakingConstraints();
 
 		void setSectionAvailabilityApproxConstraints();
+		/** Add up the availability approximation constraints corresponding to the chosen approximation type. **/
+		void setAvailabilityApproxConstraints();
+		/** Add up the outer approximation constraints: log-availabilities are linear in the log space and bounded by a few initial tangents of log(secAvail) and log(secUnavail); further tangents are separated in the callback. **/
+		void setOuterApproximationConstraints();
 		void setSFCAvailabilityApproxConstraints();
 
 	/****************************************************************************************/
@@ -131,13 +156,24 @@ class Model
 		/** Solves the MIP. **/
 		void run();
 
+		/** Refines the availability approximation around the worst approximated values and re-solves, warm started from the previous solution, until the availability violation falls below the tolerance. **/
+		void runAdaptiveRefinement();
+		/** Adds touch points where the approximation error is largest and rebuilds the approximation constraints. Returns the number of touch points added. **/
+		int  refineApproximation();
+		/** Runs the greedy start heuristic and gives its best placement to CPLEX as a MIP start. **/
+		void runGreedyStart();
+		/** Reads the warm start file, repairs it with respect to the current data and gives it to CPLEX as a MIP start. **/
+		void loadWarmStart();
+		/** Gives a placement to CPLEX as a MIP start. Routing values are used for demands whose assignment was not modified. @param placement The placement. @param routing The pairs (s,t) used by each section of each demand, as read from the warm start file. @param name The name of the MIP start. **/
+		void addMIPStart(const Placement& placement, const std::vector< std::vector< std::vector< std::pair<int,int> > > >& routing, const std::string name);
+		/** Returns the ordering function g used by the symmetry breaking constraints for section i of demand k in a given placement. **/
+		double getOrderingValue(const Placement& placement, const int k, const int i) const;
+
 		/** Approximation related methods **/
-		void buildApproximationFunctionAvail	(int demand, IloNumArray &breakpoints, IloNumArray &slopes);
-		void buildApproximationFunctionUnavail	(int demand, IloNumArray &breakpoints, IloNumArray &slopes);
-		void buildAvailTouchs					(int demand, IloNumArray &touchs);
-		void buildAvailBreakpoints				(int demand, IloNumArray &breakpoints, IloNumArray &touchs);
-		void buildUnavailTouchs					(int demand, IloNumArray &touchs);
-		void buildUnavailBreakpoints			(int demand, IloNumArray &breakpoints, IloNumArray &touchs);
+		/** Returns the piecewise linear approximation of a function of a given variable, encoded as a convex combination of its vertices. The combination is restricted either by an SOS2 constraint or by the logarithmic encoding of Vielma and Nemhauser. **/
+		IloExpr 	  buildExplicitPwl			(const PwlCache::Function function, const int demand, const IloNumVar& var);
+		/** Returns the piecewise linear approximation of a function for a given demand. Arrays are built once for each SLA class and shared by all demands of the class. **/
+		void getApproximationFunction			(const PwlCache::Function function, const int demand, IloNumArray &breakpoints, IloNumArray &slopes);
 
 	/****************************************************************************************/
 	/*									Solution Query  									*/
@@ -151,12 +187,19 @@ class Model
 		void printPath					(const int demand, const int section, Graph::Node &s, Graph::Node &t);
 		
 		/** Auxialiary getters **/
+		/** Returns true if routing is modeled by variables, i.e., routing is activated and not left to the Benders subproblems. **/
+		bool	hasRoutingVariables	() const { return (data.getInput().getRoutingActivation() == Input::ROUTING_ON && !data.getInput().isBenders()); }
 		double 	getServiceAvail		(const int demand);
 		int 	getNbAvailViolation	();
 		double 	getMaxAvailViolation();
 
+		/** Returns the placement given by the best solution found. **/
+		Placement getPlacement();
+
 		/** Outputs the obtained results **/
 		void output();
+		/** Writes the best solution found to the solution file, identifying demands, nodes and vnfs by their names. **/
+		void exportSolution();
 
 	/****************************************************************************************/
 	/*										Destructors 									*/
@@ -0,0 +1,136 @@
+#include "pricing.hpp"
+
+#define PRECISION   1e-9    // Tolerance used when rounding levels
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Finds the cheapest pattern of demand k. */
+double PatternPricer::solve(const int k, const std::vector< std::vector<double> >& weight, std::vector< std::vector<int> >& nodes) const
+{
+    /* The chain log-unavailability budget -log(SLA) is split into grid units of size delta. */
+    const double BUDGET = std::max(-std::log(data.getDemand(k).getAvailability()), PRECISION);
+    const double DELTA  = BUDGET / grid;
+    /* A section with unavailability sum above this level loses less than one unit. */
+    const double STEP   = -std::log(1.0 - std::exp(-DELTA)) / grid;
+    const int    NB_SECTIONS = data.getDemand(k).getNbVNFs();
+
+    /* Cheapest subsets reaching each unavailability level, for each section. */
+    std::vector< std::vector<double> > levelCost(NB_SECTIONS);
+    std::vector< std::vector< std::vector<bool> > > take(NB_SECTIONS);
+    for (int i = 0; i < NB_SECTIONS; i++){
+        solveSection(k, i, weight[i], STEP, levelCost[i], take[i]);
+    }
+
+    /* Combine sections: chainCost[i][b] is the cheapest cost of sections 0..i losing exactly b units. */
+    std::vector< std::vector<double> > chainCost(NB_SECTIONS, std::vector<double>(grid+1, DBL_MAX));
+    std::vector< std::vector<int> > choice(NB_SECTIONS, std::vector<int>(grid+1, -1));
+    for (int i = 0; i < NB_SECTIONS; i++){
+        for (int j = 1; j <= grid; j++){
+            if (levelCost[i][j] == DBL_MAX) continue;
+            const int UNITS = getLoss(j, STEP, DELTA);
+            if (UNITS > grid) continue;
+            for (int b = UNITS; b <= grid; b++){
+                const double PREVIOUS = (i == 0 ? (b == UNITS ? 0.0 : DBL_MAX) : chainCost[i-1][b - UNITS]);
+                if (PREVIOUS == DBL_MAX) continue;
+                if (PREVIOUS + levelCost[i][j] < chainCost[i][b]){
+                    chainCost[i][b] = PREVIOUS + levelCost[i][j];
+                    choice[i][b] = j;
+                }
+            }
+        }
+    }
+    int bestUnits = -1;
+    for (int b = 0; b <= grid; b++){
+        if (chainCost[NB_SECTIONS-1][b] < DBL_MAX && (bestUnits == -1 || chainCost[NB_SECTIONS-1][b] < chainCost[NB_SECTIONS-1][bestUnits])){
+            bestUnits = b;
+        }
+    }
+    if (bestUnits == -1){
+        return DBL_MAX;
+    }
+
+    /* Rebuild the pattern. */
+    nodes.assign(NB_SECTIONS, std::vector<int>());
+    const std::vector<int>& rank = data.getAvailNodeRank();
+    int b = bestUnits;
+    for (int i = NB_SECTIONS-1; i >= 0; i--){
+        int j = choice[i][b];
+        b -= getLoss(j, STEP, DELTA);
+        for (int r = (int)rank.size()-1; r >= 0 && j > 0; r--){
+            if (take[i][r][j]){
+                const int v = rank[r];
+                nodes[i].push_back(v);
+                j = std::max(0, j - getUnits(v, STEP));
+            }
+        }
+    }
+    return chainCost[NB_SECTIONS-1][bestUnits];
+}
+
+/* Computes the cheapest subsets of nodes reaching each unavailability level for section i of demand k. */
+void PatternPricer::solveSection(const int k, const int i, const std::vector<double>& weight, const double step, std::vector<double>& cost, std::vector< std::vector<bool> >& take) const
+{
+    /* 0-1 knapsack over nodes in availability rank: cost[j] is the cheapest subset whose units sum to at least j. */
+    const std::vector<int>& rank = data.getAvailNodeRank();
+    cost.assign(grid+1, DBL_MAX);
+    cost[0] = 0.0;
+    take.assign(rank.size(), std::vector<bool>(grid+1, false));
+    for (unsigned int r = 0; r < rank.size(); r++){
+        const int v = rank[r];
+        if (!isEligible(k, i, v)) continue;
+        const int UNITS = getUnits(v, step);
+        if (UNITS == 0) continue;
+        for (int j = grid; j >= 1; j--){
+            const int FROM = std::max(0, j - UNITS);
+            if (cost[FROM] == DBL_MAX) continue;
+            if (cost[FROM] + weight[v] < cost[j]){
+                cost[j] = cost[FROM] + weight[v];
+                take[r][j] = true;
+            }
+        }
+    }
+}
+
+/* Returns the number of unavailability units contributed by node v. */
+int PatternPricer::getUnits(const int v, const double step) const
+{
+    const double UNAVAIL = 1.0 - data.getNode(v).getAvailability();
+    if (UNAVAIL <= 0.0){
+        return grid;
+    }
+    /* Conservative: rounded down, so the actual unavailability of a subset is at least its level.
+       Optimistic: rounded up, so the level of a subset is at least its actual unavailability. */
+    const double UNITS = -std::log(UNAVAIL) / step;
+    if (rounding == ROUNDING_CONSERVATIVE){
+        return (int)std::min((double)grid, std::floor(UNITS));
+    }
+    return (int)std::min((double)grid, std::ceil(UNITS));
+}
+
+/* Returns the number of budget units lost by a section at unavailability level j. */
+int PatternPricer::getLoss(const int j, const double step, const double delta) const
+{
+    const double LOSS = -std::log(1.0 - std::exp(-j * step)) / delta;
+    if (rounding == ROUNDING_CONSERVATIVE){
+        return (int)std::ceil(LOSS - PRECISION);
+    }
+    /* The last level gathers every larger unavailability, whose loss is below one unit. */
+    if (j == grid){
+        return 0;
+    }
+    return (int)std::floor(LOSS);
+}
+
+/* Returns true if node v can host section i of demand k. */
+bool PatternPricer::isEligible(const int k, const int i, const int v) const
+{
+    return (getLoad(k, i) <= data.getNode(v).getCapacity() + PRECISION);
+}
+
+/* Returns the load of section i of demand k on a node. */
+double PatternPricer::getLoad(const int k, const int i) const
+{
+    return data.getDemand(k).getBandwidth() * data.getVnf(data.getDemand(k).getVNF_i(i)).getConsumption();
+}
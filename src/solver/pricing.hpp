@@ -0,0 +1,70 @@
+#ifndef __pricing__hpp
+#define __pricing__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cmath>
+#include <cfloat>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class solves the single-SFC placement problem: given a weight for
+ * assigning each section of a demand to each node, find the cheapest node
+ * subsets whose chain availability meets the SLA. It is solved by dynamic
+ * programming in log space. The -log(SLA) budget is split into grid units; a
+ * knapsack over the availability-ranked nodes gives the cheapest subset reaching
+ * each unavailability level of a section, and a second knapsack combines
+ * sections under the budget. With conservative rounding every subset found is
+ * feasible (used for pricing columns); with optimistic rounding every feasible
+ * subset is admitted, so the value found is a lower bound (used for Lagrangian
+ * bounds). It does not depend on any MIP solver.
+ ************************************************************************************/
+class PatternPricer {
+
+public:
+    /** States how unavailability levels and losses are rounded to grid units. **/
+    enum Rounding {
+        ROUNDING_CONSERVATIVE   = 0,    /**< Every pattern found is feasible. **/
+        ROUNDING_OPTIMISTIC     = 1     /**< Every feasible pattern is admitted. **/
+    };
+
+private:
+    const Data&     data;       /**< Data read in data.hpp **/
+    const int       grid;       /**< Number of units into which the log(SLA) budget is divided. **/
+    const Rounding  rounding;   /**< The rounding used. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param data_ The instance data. @param grid_ The number of units of the log(SLA) budget. @param rounding_ The rounding used. **/
+    PatternPricer(const Data& data_, const int grid_, const Rounding rounding_) : data(data_), grid(grid_), rounding(rounding_) {}
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Finds the cheapest pattern of demand k. Returns its weight, or DBL_MAX if there is none. @param k The demand id. @param weight The non-negative weight of assigning each section to each node. weight[i][v] @param nodes Stores the nodes assigned to each section. nodes[i] **/
+    double solve(const int k, const std::vector< std::vector<double> >& weight, std::vector< std::vector<int> >& nodes) const;
+
+    /** Returns true if node v can host section i of demand k, i.e., it has enough capacity. **/
+    bool isEligible(const int k, const int i, const int v) const;
+    /** Returns the load of section i of demand k on a node. **/
+    double getLoad(const int k, const int i) const;
+
+private:
+    /** Computes the cheapest subsets of nodes reaching each unavailability level for section i of demand k. Level j means sum(-log(1-a_v)) >= j*step. @param cost Stores the cost of each level. @param take Stores the knapsack decisions, used to rebuild the subsets. **/
+    void solveSection(const int k, const int i, const std::vector<double>& weight, const double step, std::vector<double>& cost, std::vector< std::vector<bool> >& take) const;
+
+    /** Returns the number of unavailability units contributed by node v, i.e., -log(1-a_v)/step rounded and capped at the grid. **/
+    int getUnits(const int v, const double step) const;
+    /** Returns the number of budget units lost by a section at unavailability level j. **/
+    int getLoss(const int j, const double step, const double delta) const;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "pwl.hpp"
+
+/****************************************************************************************/
+/*										Getters 										*/
+/****************************************************************************************/
+
+/* Returns the key identifying the approximation of a function for a given demand. */
+PwlCache::Key PwlCache::getKey(const Function function, const int demand) const
+{
+    return Key(function, data.getInput().getApproximationType(), data.getInput().getNbBreakpoints(), data.getDemand(demand).getAvailability());
+}
+
+/****************************************************************************************/
+/*										Methods 										*/
+/****************************************************************************************/
+
+/* Returns the approximation of a function for a given demand, building it if it is not in the cache. */
+const PwlCache::Approximation& PwlCache::get(const Function function, const int demand)
+{
+    const Key KEY = getKey(function, demand);
+    std::map<Key, Approximation>::iterator it = cache.find(KEY);
+    if (it != cache.end()){
+        return it->second;
+    }
+
+    Approximation& approx = cache[KEY];
+    const double SLA = data.getDemand(demand).getAvailability();
+    if (function == LOG_AVAIL){
+        buildAvailTouchs(SLA, approx.touchs);
+    }
+    else{
+        buildUnavailTouchs(SLA, approx.touchs);
+    }
+    buildBreakpoints(approx);
+    return approx;
+}
+
+/* Adds a touch point to the approximation of a function for a given demand. */
+bool PwlCache::addTouch(const Function function, const int demand, const double value)
+{
+    const double MIN_DISTANCE = 1e-12;
+    get(function, demand);
+    Approximation& approx = cache[getKey(function, demand)];
+    std::vector<double>& touchs = approx.touchs;
+    if (value <= touchs.front() || value >= touchs.back()){
+        return false;
+    }
+    std::vector<double>::iterator it = std::lower_bound(touchs.begin(), touchs.end(), value);
+    if (std::abs(*it - value) < MIN_DISTANCE || std::abs(*(it-1) - value) < MIN_DISTANCE){
+        return false;
+    }
+    touchs.insert(it, value);
+    buildBreakpoints(approx);
+    return true;
+}
+
+/* Returns the value of a piecewise linear approximation at a given point. */
+double PwlCache::evaluate(const Approximation& approx, const double value) const
+{
+    const std::vector<double>& bp = approx.breakpoints;
+    const double LO = std::min(value, 1.0);
+    const double HI = std::max(value, 1.0);
+    double integral = 0.0;
+    for (unsigned int j = 0; j < approx.slopes.size(); j++){
+        const double START = (j == 0 ? -DBL_MAX : bp[j-1]);
+        const double END   = (j == bp.size() ? DBL_MAX : bp[j]);
+        const double LENGTH = std::min(END, HI) - std::max(START, LO);
+        if (LENGTH > 0.0){
+            integral += approx.slopes[j] * LENGTH;
+        }
+    }
+    return (value < 1.0 ? -integral : integral);
+}
+
+/* Returns the absolute error of the approximation of a function for a given demand at a given point. */
+double PwlCache::getError(const Function function, const int demand, const double value)
+{
+    if (value <= 0.0) return DBL_MAX;
+    return std::abs(evaluate(get(function, demand), value) - std::log(value));
+}
+
+/* Set up the vector u for approximating log(avail). */
+void PwlCache::buildAvailTouchs(const double sla, std::vector<double>& touchs) const
+{
+    const int NB_BREAKS  = data.getInput().getNbBreakpoints();
+    int       NB_TOUCHS  = NB_BREAKS;
+
+    // If approximation from above
+    if (data.getInput().getApproximationType() ==  Input::APPROXIMATION_TYPE_RELAXATION || data.getInput().getApproximationType() ==  Input::APPROXIMATION_TYPE_OUTER){
+        NB_TOUCHS = NB_BREAKS + 1;
+    }
+
+    // get upper and lower bounds for avail
+    const double LB = sla;
+    const double UB = 1.0;
+    touchs.clear();
+    for (int t = 1; t <= NB_TOUCHS; t++){
+        double exponent  = ((double) (NB_TOUCHS - t)) / (NB_TOUCHS - 1);
+        double touch_val = UB * std::pow((LB / UB), exponent);
+        touchs.push_back(touch_val);
+    }
+}
+
+/* Set up the vector u for approximating log(unavail). */
+void PwlCache::buildUnavailTouchs(const double sla, std::vector<double>& touchs) const
+{
+    const int NB_BREAKS  = data.getInput().getNbBreakpoints();
+    int       NB_TOUCHS  = NB_BREAKS;
+
+    // If approximation from above
+    if (data.getInput().getApproximationType() ==  Input::APPROXIMATION_TYPE_RELAXATION || data.getInput().getApproximationType() ==  Input::APPROXIMATION_TYPE_OUTER){
+        NB_TOUCHS = NB_BREAKS + 1;
+    }
+
+    const double minAvail = sla;
+    const double maxAvail = data.getParallelAvailability(data.getAvailNodeRank());
+    const double EPSILON_PRECISION = 1e-8;
+    double UB = std::min(1.0 - minAvail, 1.0 - EPSILON_PRECISION);
+    double LB = std::max(1.0 - maxAvail, EPSILON_PRECISION);
+
+    /** billionnet spacement of touchs **/
+    touchs.clear();
+    for (int k = 1; k <= NB_TOUCHS; k++){
+        double expo = ((double) (NB_TOUCHS - k)) / (NB_TOUCHS - 1);
+        double u = (UB) * std::pow((LB/UB), expo);
+        touchs.push_back(u);
+    }
+    touchs.push_back(1.0);
+}
+
+/* Set up the breakpoints and slopes from the touch points. */
+void PwlCache::buildBreakpoints(Approximation& approx) const
+{
+    const std::vector<double>& touchs = approx.touchs;
+    approx.breakpoints.clear();
+    approx.slopes.clear();
+
+    switch (data.getInput().getApproximationType()){
+        case Input::APPROXIMATION_TYPE_RESTRICTION:
+            approx.breakpoints = touchs;
+            approx.slopes.push_back(1.0/touchs[0]);
+            for (unsigned int i = 0; i+1 < touchs.size(); i++){
+                double delta_X = touchs[i+1] - touchs[i];
+                double delta_Y = std::log(touchs[i+1]) - std::log(touchs[i]);
+                approx.slopes.push_back(delta_Y/delta_X);
+            }
+            approx.slopes.push_back(0);
+            break;
+        case Input::APPROXIMATION_TYPE_RELAXATION:
+        case Input::APPROXIMATION_TYPE_OUTER:
+            for (unsigned int k = 1; k < touchs.size(); k++){
+                double log_u_k1 = std::log(touchs[k]);
+                double log_u_k = std::log(touchs[k-1]);
+                double inv_u_k1 = 1.0/touchs[k];
+                double inv_u_k = 1.0/touchs[k-1];
+                approx.breakpoints.push_back( (log_u_k1 - log_u_k) / (inv_u_k - inv_u_k1) );
+            }
+            for (unsigned int i = 0; i < touchs.size(); i++){
+                approx.slopes.push_back(1.0/touchs[i]);
+            }
+            break;
+        default:
+            throw std::runtime_error("ERROR: Unexpected availability approx !");
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef __pwl__hpp
+#define __pwl__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <tuple>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class stores the piecewise linear approximations of log(avail) and
+ * log(unavail) used in the availability constraints. An approximation only
+ * depends on the approximated function, the approximation type, the number of
+ * breakpoints and the SLA of the demand, so it is built once for each such key
+ * and shared by every section of every demand with the same SLA.
+ ************************************************************************************/
+class PwlCache {
+
+public:
+    /** The approximated function. **/
+    enum Function {
+        LOG_AVAIL   = 0,        /**< log(secAvail) **/
+        LOG_UNAVAIL = 1         /**< log(secUnavail) **/
+    };
+
+    /** A piecewise linear approximation given by its touch points, breakpoints and slopes, as expected by IloPiecewiseLinear. **/
+    struct Approximation {
+        std::vector<double> touchs;         /**< Points where the approximation touches the function. **/
+        std::vector<double> breakpoints;    /**< Points where the slope changes. **/
+        std::vector<double> slopes;         /**< The slope of each segment. **/
+    };
+
+    /** Identifies an approximation: (function, approximation type, number of breakpoints, SLA). **/
+    typedef std::tuple<int, int, int, double> Key;
+
+private:
+    const Data&                     data;       /**< Data read in data.hpp **/
+    std::map<Key, Approximation>    cache;      /**< The approximations already built. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param data_ The instance data. **/
+    PwlCache(const Data& data_) : data(data_) {}
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns the number of approximations built. **/
+    const int   getNbBuilt()    const { return (int)cache.size(); }
+
+    /** Returns the key identifying the approximation of a function for a given demand. @param function The approximated function. @param demand The demand id. **/
+    Key getKey(const Function function, const int demand) const;
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Returns the approximation of a function for a given demand, building it if it is not in the cache. @param function The approximated function. @param demand The demand id. **/
+    const Approximation& get(const Function function, const int demand);
+
+    /** Adds a touch point to the approximation of a function for a given demand and rebuilds its breakpoints and slopes. Returns false if the point lies outside the approximated interval or is too close to an existing touch point. @param function The approximated function. @param demand The demand id. @param value The new touch point. **/
+    bool addTouch(const Function function, const int demand, const double value);
+
+    /** Returns the value of a piecewise linear approximation at a given point. @note As in IloPiecewiseLinear, the approximation goes through point (1,0). @param approx The approximation. @param value The point to be evaluated. **/
+    double evaluate(const Approximation& approx, const double value) const;
+
+    /** Returns the absolute error of the approximation of a function for a given demand at a given point. **/
+    double getError(const Function function, const int demand, const double value);
+
+private:
+    /** Sets up the touch points for approximating log(avail). **/
+    void buildAvailTouchs   (const double sla, std::vector<double>& touchs) const;
+    /** Sets up the touch points for approximating log(unavail). **/
+    void buildUnavailTouchs (const double sla, std::vector<double>& touchs) const;
+    /** Sets up the breakpoints and slopes from the touch points. In relaxation mode, breakpoints are the intersections of consecutive tangents; otherwise they are the touch points themselves. **/
+    void buildBreakpoints   (Approximation& approx) const;
+};
+
+#endif
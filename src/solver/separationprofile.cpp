@@ -0,0 +1,139 @@
+#include "separationprofile.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. */
+SeparationProfile::SeparationProfile(const bool enabled_) : enabled(enabled_)
+{
+    if (enabled){
+        stats.resize(NB_ROUTINES * NB_DEPTHS, getEmpty());
+    }
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the name of a routine. */
+std::string SeparationProfile::getName(const Routine routine)
+{
+    switch (routine){
+        case ROUTINE_CUT_POOL:              return "checkCutPool";
+        case ROUTINE_GENERALIZED_COVER:     return "generalizedCoverSeparation";
+        case ROUTINE_CHAIN_COVER:           return "chainCoverSeparation";
+        case ROUTINE_HEURISTIC_AVAIL:       return "heuristicSeparationOfAvailibilityConstraints";
+        case ROUTINE_LAZY_AVAIL:            return "addLazyConstraints";
+        case ROUTINE_LIFTING:               return "lift";
+        case ROUTINE_HEURISTIC_PHASE_I:     return "runHeuristic_Phase_I";
+        case ROUTINE_HEURISTIC_PHASE_II:    return "runHeuristic_Phase_II";
+        default:                            return "unknown";
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Records a call. */
+void SeparationProfile::record(const Routine routine, const int depth, const long produced, const double time)
+{
+    const int DEPTH = std::min(std::max(depth, 0), NB_DEPTHS - 1);
+    int bin = 0;
+    for (double limit = 1e-5; bin < NB_TIME_BINS - 1 && time >= limit; limit *= 10.0){
+        bin++;
+    }
+    std::lock_guard<std::mutex> lock(flag);
+    Stats& current = stats[routine * NB_DEPTHS + DEPTH];
+    current.calls++;
+    current.successes += (produced > 0 ? 1 : 0);
+    current.produced += produced;
+    current.time += time;
+    current.histogram[bin]++;
+}
+
+/* Returns a set of measures with no call. */
+SeparationProfile::Stats SeparationProfile::getEmpty()
+{
+    Stats empty;
+    empty.calls = 0;
+    empty.successes = 0;
+    empty.produced = 0;
+    empty.time = 0.0;
+    for (int b = 0; b < NB_TIME_BINS; b++){
+        empty.histogram[b] = 0;
+    }
+    return empty;
+}
+
+/* Adds a set of measures to another. */
+void SeparationProfile::accumulate(Stats& total, const Stats& stats)
+{
+    total.calls += stats.calls;
+    total.successes += stats.successes;
+    total.produced += stats.produced;
+    total.time += stats.time;
+    for (int b = 0; b < NB_TIME_BINS; b++){
+        total.histogram[b] += stats.histogram[b];
+    }
+}
+
+/* Returns the JSON object of a set of measures. */
+std::string SeparationProfile::toJson(const Stats& stats)
+{
+    std::ostringstream json;
+    json << std::setprecision(12);
+    json << "{\"calls\":" << stats.calls << ",\"successes\":" << stats.successes
+         << ",\"success_rate\":" << (stats.calls > 0 ? (double)stats.successes / stats.calls : 0.0)
+         << ",\"produced\":" << stats.produced << ",\"time\":" << stats.time << ",\"histogram\":[";
+    for (int b = 0; b < NB_TIME_BINS; b++){
+        json << (b > 0 ? "," : "") << stats.histogram[b];
+    }
+    json << "]}";
+    return json.str();
+}
+
+/* Returns the profile as a JSON object. */
+std::string SeparationProfile::toJson()
+{
+    std::ostringstream json;
+    json << "{\"time_bins_upper_s\":[1e-05,0.0001,0.001,0.01,0.1,1,null],\"max_depth_class\":" << NB_DEPTHS - 1 << ",\"routines\":{";
+    std::lock_guard<std::mutex> lock(flag);
+    for (int r = 0; r < NB_ROUTINES && enabled; r++){
+        const Stats& root = stats[r * NB_DEPTHS];
+        Stats tree = getEmpty();
+        for (int d = 1; d < NB_DEPTHS; d++){
+            accumulate(tree, stats[r * NB_DEPTHS + d]);
+        }
+        Stats total = root;
+        accumulate(total, tree);
+
+        json << (r > 0 ? "," : "") << "\"" << getName((Routine)r) << "\":{\"total\":" << toJson(total)
+             << ",\"root\":" << toJson(root) << ",\"tree\":" << toJson(tree) << ",\"depth\":{";
+        bool first = true;
+        for (int d = 0; d < NB_DEPTHS; d++){
+            const Stats& current = stats[r * NB_DEPTHS + d];
+            if (current.calls == 0) continue;
+            json << (first ? "" : ",") << "\"" << d << (d == NB_DEPTHS - 1 ? "+" : "") << "\":" << toJson(current);
+            first = false;
+        }
+        json << "}}";
+    }
+    json << "}}";
+    return json.str();
+}
+
+/* Writes the profile to a JSON file. */
+bool SeparationProfile::write(const std::string& filename)
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write separation profile '" << filename << "'." << std::endl;
+        return false;
+    }
+    file << toJson() << std::endl;
+    file.close();
+    std::cout << "\t Separation profile written to " << filename << "." << std::endl;
+    return true;
+}
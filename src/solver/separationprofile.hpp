@@ -0,0 +1,128 @@
+#ifndef __separationprofile__hpp
+#define __separationprofile__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <mutex>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+
+/************************************************************************************
+ * This class records how much each callback routine costs and how often it pays
+ * off: number of calls, number of successful calls, number of cuts produced,
+ * total time and a histogram of the time per call. Measures are kept by branch
+ * and bound depth (the last depth class gathering every deeper node), from which
+ * root and tree totals are derived. A call is successful when the routine
+ * produces at least one cut, lifts at least one placement, or finds a feasible
+ * solution. The profile is exported as a JSON file.
+ ************************************************************************************/
+class SeparationProfile {
+
+public:
+    /** The instrumented routines. **/
+    enum Routine {
+        ROUTINE_CUT_POOL            = 0,    /**< Callback::checkCutPool. **/
+        ROUTINE_GENERALIZED_COVER   = 1,    /**< Callback::generalizedCoverSeparation. **/
+        ROUTINE_CHAIN_COVER         = 2,    /**< Callback::chainCoverSeparation. **/
+        ROUTINE_HEURISTIC_AVAIL     = 3,    /**< Callback::heuristicSeparationOfAvailibilityConstraints. **/
+        ROUTINE_LAZY_AVAIL          = 4,    /**< Callback::addLazyConstraints. **/
+        ROUTINE_LIFTING             = 5,    /**< Callback::lift. **/
+        ROUTINE_HEURISTIC_PHASE_I   = 6,    /**< Callback::runHeuristic_Phase_I, which always succeeds. **/
+        ROUTINE_HEURISTIC_PHASE_II  = 7,    /**< Callback::runHeuristic_Phase_II. **/
+        NB_ROUTINES                 = 8
+    };
+
+    static const int NB_DEPTHS      = 17;   /**< Number of depth classes: depths 0 to 15, then 16 and deeper. **/
+    static const int NB_TIME_BINS   = 7;    /**< Number of time classes: below 10us, 100us, 1ms, 10ms, 100ms, 1s, then 1s and longer. **/
+
+private:
+    /** The measures of a routine at a given depth. **/
+    struct Stats {
+        long    calls;                      /**< Number of calls. **/
+        long    successes;                  /**< Number of successful calls. **/
+        long    produced;                   /**< Number of cuts, lifted placements or solutions produced. **/
+        double  time;                       /**< Total time, in seconds. **/
+        long    histogram[NB_TIME_BINS];    /**< Number of calls in each time class. **/
+    };
+
+    const bool          enabled;    /**< True if routines are measured. **/
+    std::vector<Stats>  stats;      /**< The measures, routine r at depth d stored at r*NB_DEPTHS + d. **/
+    std::mutex          flag;       /**< Protects the measures against concurrent callback threads. **/
+
+public:
+    /** A scoped call of a routine: measures from its construction to its destruction. **/
+    class Scope {
+    private:
+        SeparationProfile*                      profile;    /**< The profile, or NULL if it is disabled. **/
+        Routine                                 routine;    /**< The routine called. **/
+        int                                     depth;      /**< The depth of the node being separated. **/
+        long                                    produced;   /**< Number of cuts, lifted placements or solutions produced by the call. **/
+        std::chrono::steady_clock::time_point   start;      /**< Time at the call start. **/
+
+    public:
+        /** Starts a call. @param depth_ The branch and bound depth of the node being separated. **/
+        Scope(SeparationProfile& profile_, const Routine routine_, const int depth_) : profile(NULL), produced(0) {
+            if (profile_.enabled){
+                profile = &profile_;
+                routine = routine_;
+                depth = depth_;
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        /** Ends the call and records it. **/
+        ~Scope() { if (profile != NULL) profile->record(routine, depth, produced, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()); }
+
+        /** Sets the number of cuts, lifted placements or solutions produced by the call. The call is successful if it is positive. **/
+        void setProduced(const long produced_) { produced = produced_; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param enabled_ True if routines are measured. **/
+    SeparationProfile(const bool enabled_);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns true if routines are measured. **/
+    bool isEnabled() const { return enabled; }
+
+    /** Returns the name of a routine. **/
+    static std::string getName(const Routine routine);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Records a call. @param routine The routine called. @param depth The depth of the node. @param produced Number of cuts, lifted placements or solutions produced. @param time Time spent, in seconds. **/
+    void record(const Routine routine, const int depth, const long produced, const double time);
+
+    /** Returns the profile as a JSON object. **/
+    std::string toJson();
+
+    /** Writes the profile to a JSON file. Returns false if the file cannot be written. **/
+    bool write(const std::string& filename);
+
+private:
+    /** Returns a set of measures with no call. **/
+    static Stats getEmpty();
+    /** Returns the JSON object of a set of measures. **/
+    static std::string toJson(const Stats& stats);
+    /** Adds a set of measures to another. **/
+    static void accumulate(Stats& total, const Stats& stats);
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include "batch.hpp"
+
+#include <glob.h>
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Reads the list of parameter files. */
+Batch::Batch(const std::string& source, const int nbWorkers_) : nbWorkers(std::max(1, nbWorkers_)), next(0), warned(false)
+{
+    if (source.find_first_of("*?[") != std::string::npos){
+        expandGlob(source);
+    }
+    else{
+        readManifest(source);
+    }
+    std::cout << "\t Batch of " << jobs.size() << " parameter files, " << nbWorkers << " concurrent jobs." << std::endl;
+}
+
+/* Reads the parameter files listed in a manifest. */
+void Batch::readManifest(const std::string& filename)
+{
+    std::ifstream manifest(filename.c_str());
+    if (!manifest){
+        std::cerr << "ERROR: Unable to open manifest file '" << filename << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string line;
+    while (std::getline(manifest, line)){
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') continue;
+        Job job;
+        job.parameterFile = line;
+        job.status = -1;
+        job.time = 0.0;
+        jobs.push_back(job);
+    }
+}
+
+/* Adds the parameter files matching a glob pattern. */
+void Batch::expandGlob(const std::string& pattern)
+{
+    glob_t matches;
+    if (glob(pattern.c_str(), 0, NULL, &matches) == 0){
+        for (size_t j = 0; j < matches.gl_pathc; j++){
+            Job job;
+            job.parameterFile = matches.gl_pathv[j];
+            job.status = -1;
+            job.time = 0.0;
+            jobs.push_back(job);
+        }
+    }
+    globfree(&matches);
+    if (jobs.empty()){
+        std::cerr << "WARNING: No parameter file matches '" << pattern << "'." << std::endl;
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Runs every job. */
+int Batch::run(const Solve& solve)
+{
+    std::vector<std::thread> workers;
+    for (int w = 1; w < nbWorkers; w++){
+        workers.push_back(std::thread(&Batch::runWorker, this, std::cref(solve)));
+    }
+    runWorker(solve);
+    for (unsigned int w = 0; w < workers.size(); w++){
+        workers[w].join();
+    }
+
+    for (unsigned int j = 0; j < jobs.size(); j++){
+        if (jobs[j].status != 0) return 1;
+    }
+    return 0;
+}
+
+/* Runs jobs until none is left. */
+void Batch::runWorker(const Solve& solve)
+{
+    for (int j = next++; j < (int)jobs.size(); j = next++){
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        try {
+            jobs[j].status = runJob(jobs[j], solve);
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl << "ERROR: Job '" << jobs[j].parameterFile << "' failed." << std::endl;
+            jobs[j].status = 1;
+        }
+        catch (...) {
+            std::cerr << "ERROR: Job '" << jobs[j].parameterFile << "' failed." << std::endl;
+            jobs[j].status = 1;
+        }
+        jobs[j].time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+/* Runs a job. */
+int Batch::runJob(const Job& job, const Solve& solve)
+{
+    Input params(job.parameterFile);
+    const unsigned int NB_CORES = std::thread::hardware_concurrency();
+    if (NB_CORES > 0 && (unsigned int)(nbWorkers * params.getThreads()) > NB_CORES && !warned.exchange(true)){
+        std::cout << "WARNING: " << nbWorkers << " jobs of " << params.getThreads() << " threads exceed the "
+                  << NB_CORES << " available cores." << std::endl;
+    }
+    std::shared_ptr<const Data> instance = getInstance(params);
+    Data data(params, *instance);
+    const int STATUS = solve(data);
+    data.getProfiler().print();
+    return STATUS;
+}
+
+/* Returns the instance read from the files of the given parameters. */
+std::shared_ptr<const Data> Batch::getInstance(const Input& params)
+{
+    const std::string KEY = params.getNodeFile() + ";" + params.getLinkFile() + ";" + params.getVnfFile() + ";" + params.getDemandFile();
+    std::promise< std::shared_ptr<const Data> > promise;
+    std::shared_future< std::shared_ptr<const Data> > instance;
+    bool owner = false;
+    cache_flag.lock();
+    std::map< std::string, std::shared_future< std::shared_ptr<const Data> > >::iterator it = instances.find(KEY);
+    if (it == instances.end()){
+        instance = promise.get_future().share();
+        instances[KEY] = instance;
+        owner = true;
+    }
+    else{
+        instance = it->second;
+    }
+    cache_flag.unlock();
+
+    /* The first job reading an instance parses it; the others wait for it. */
+    if (owner){
+        try {
+            promise.set_value(std::make_shared<const Data>(params.getParameterFile()));
+        }
+        catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+    return instance.get();
+}
+
+/* Displays the outcome of each job. */
+void Batch::printResult() const
+{
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                    Printing batch results.                    -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    for (unsigned int j = 0; j < jobs.size(); j++){
+        std::cout << "\t " << jobs[j].parameterFile << ": "
+                  << (jobs[j].status == 0 ? "done" : "failed") << " in " << jobs[j].time << "s." << std::endl;
+    }
+    std::cout << "\t Distinct instances read: " << instances.size() << std::endl << std::endl;
+}
@@ -0,0 +1,83 @@
+#ifndef __batch__hpp
+#define __batch__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <future>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <functional>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+
+
+/************************************************************************************
+ * This class runs the solver on many parameter files within a single process.
+ * The parameter files are given either by a manifest, listing one file per
+ * line, or by a glob pattern. Jobs are run concurrently by a pool of workers,
+ * each job using the number of threads given by its own parameter file. The
+ * node, link, vnf and demand files are parsed once per distinct instance and
+ * shared by every job reading them.
+ ************************************************************************************/
+class Batch {
+
+public:
+    /** The solver run on each job. Returns 0 on success. **/
+    typedef std::function<int(const Data&)> Solve;
+
+private:
+    /** A parameter file and the outcome of its run. **/
+    struct Job {
+        std::string parameterFile;  /**< The parameter file. **/
+        int         status;         /**< The value returned by the solver, or -1 if the job was not run. **/
+        double      time;           /**< Time spent by the job, including data construction. **/
+    };
+
+    std::vector<Job>                                                    jobs;           /**< The jobs, in manifest order. **/
+    const int                                                           nbWorkers;      /**< Number of jobs run concurrently. **/
+    std::atomic<int>                                                    next;           /**< The next job to be run. **/
+    std::mutex                                                          cache_flag;     /**< Protects the instance cache. **/
+    std::map< std::string, std::shared_future< std::shared_ptr<const Data> > > instances; /**< The parsed instances, by instance files. **/
+    std::atomic<bool>                                                   warned;         /**< True once the thread budget warning was displayed. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param source A manifest file, or a glob pattern if it contains a wildcard. @param nbWorkers_ The number of jobs run concurrently. **/
+    Batch(const std::string& source, const int nbWorkers_);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Runs every job. Returns 0 if every job succeeded, 1 otherwise. @param solve The solver run on each job. **/
+    int run(const Solve& solve);
+
+    /** Displays the outcome of each job. **/
+    void printResult() const;
+
+private:
+    /** Reads the parameter files listed in a manifest. Empty lines and lines starting with # are ignored. **/
+    void readManifest(const std::string& filename);
+    /** Adds the parameter files matching a glob pattern, in lexicographic order. **/
+    void expandGlob(const std::string& pattern);
+
+    /** Runs jobs until none is left. **/
+    void runWorker(const Solve& solve);
+    /** Runs a job. Returns the value returned by the solver. **/
+    int runJob(const Job& job, const Solve& solve);
+
+    /** Returns the instance read from the files of the given parameters, parsing it on first request. **/
+    std::shared_ptr<const Data> getInstance(const Input& params);
+};
+
+#endif
@@ -0,0 +1,397 @@
+#include "benchmark.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Reads the matrix and writes the parameter file of every run. */
+Benchmark::Benchmark(const std::string& matrixFile_) : matrixFile(matrixFile_)
+{
+    readMatrix();
+    if (tolerances.empty()){
+        /* Default thresholds: times below a second and a few hundred nodes are noise. */
+        const Tolerance DEFAULTS[] = { {"build_time", 0.25, 0.5}, {"time", 0.25, 1.0}, {"nodes", 0.5, 100.0},
+                                       {"gap", 0.0, 0.5}, {"objective", 0.0, 1e-6}, {"peak_rss_kb", 0.2, 4096.0} };
+        tolerances.assign(DEFAULTS, DEFAULTS + sizeof(DEFAULTS)/sizeof(Tolerance));
+    }
+    expand();
+    std::cout << "\t Benchmark " << matrixFile << ": " << runs.size() << " runs." << std::endl;
+}
+
+/* Reads the matrix file. */
+void Benchmark::readMatrix()
+{
+    std::ifstream matrix(matrixFile.c_str());
+    if (!matrix){
+        std::cerr << "ERROR: Unable to open benchmark matrix '" << matrixFile << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string line;
+    while (std::getline(matrix, line)){
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream tokens(line);
+        std::string word;
+        tokens >> word;
+        if (word == "axis"){
+            Axis axis;
+            tokens >> axis.name;
+            while (tokens >> word){
+                const std::size_t COLON = word.find(':');
+                axis.labels.push_back(word.substr(0, COLON));
+                std::vector< std::pair<std::string, std::string> > settings;
+                std::string assignments = (COLON == std::string::npos ? "" : word.substr(COLON + 1));
+                std::istringstream list(assignments);
+                std::string assignment;
+                while (std::getline(list, assignment, ',')){
+                    const std::size_t EQUAL = assignment.find('=');
+                    if (EQUAL == std::string::npos) continue;
+                    settings.push_back(std::make_pair(assignment.substr(0, EQUAL), assignment.substr(EQUAL + 1)));
+                }
+                axis.settings.push_back(settings);
+            }
+            if (axis.labels.empty()){
+                std::cerr << "WARNING: Benchmark axis '" << axis.name << "' has no value and is ignored." << std::endl;
+                continue;
+            }
+            axes.push_back(axis);
+        }
+        else if (word == "tolerance"){
+            Tolerance tolerance;
+            if (tokens >> tolerance.metric >> tolerance.relative >> tolerance.absolute){
+                tolerances.push_back(tolerance);
+            }
+            else{
+                std::cerr << "WARNING: Benchmark line '" << line << "' is not a valid tolerance and is ignored." << std::endl;
+            }
+        }
+        else{
+            const std::size_t EQUAL = line.find('=');
+            if (EQUAL == std::string::npos){
+                std::cerr << "WARNING: Benchmark line '" << line << "' is not understood and is ignored." << std::endl;
+                continue;
+            }
+            const std::string KEY = line.substr(0, EQUAL);
+            const std::string VALUE = line.substr(EQUAL + 1);
+            if (KEY == "base")              baseFile = VALUE;
+            else if (KEY == "runs")         runsDirectory = VALUE;
+            else if (KEY == "baseline")     baselineFile = VALUE;
+            else                            fixed.push_back(std::make_pair(KEY, VALUE));
+        }
+    }
+    if (baseFile.empty() || runsDirectory.empty() || getFixed("outputFile").empty()){
+        std::cerr << "ERROR: A benchmark matrix MUST declare base=, runs= and outputFile=." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Builds the runs as the product of the axes and writes their parameter files. */
+void Benchmark::expand()
+{
+    if (mkdir(runsDirectory.c_str(), 0755) != 0 && errno != EEXIST){
+        std::cerr << "ERROR: Unable to create benchmark directory '" << runsDirectory << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    /* The choice on each axis is a digit of a mixed radix counter. */
+    std::vector<unsigned int> choice(axes.size(), 0);
+    bool done = false;
+    while (!done){
+        std::map<std::string, std::string> labels;
+        Run run;
+        for (unsigned int a = 0; a < axes.size(); a++){
+            labels[axes[a].name] = axes[a].labels[choice[a]];
+            run.id += (a > 0 ? "-" : "") + axes[a].labels[choice[a]];
+        }
+        if (run.id.empty()){
+            run.id = "default";
+        }
+        run.parameterFile = runsDirectory + "/" + run.id + ".txt";
+        run.status = -1;
+
+        /* Axis settings take precedence over the fixed ones; results are always written as csv. */
+        std::vector< std::pair<std::string, std::string> > settings;
+        settings.push_back(std::make_pair(std::string("output_format"), std::string("1")));
+        for (int a = (int)axes.size() - 1; a >= 0; a--){
+            for (unsigned int s = 0; s < axes[a].settings[choice[a]].size(); s++){
+                settings.push_back(std::make_pair(axes[a].settings[choice[a]][s].first, substitute(axes[a].settings[choice[a]][s].second, labels)));
+            }
+        }
+        for (unsigned int s = 0; s < fixed.size(); s++){
+            settings.push_back(std::make_pair(fixed[s].first, substitute(fixed[s].second, labels)));
+        }
+        writeParameterFile(run, settings);
+        runs.push_back(run);
+
+        done = true;
+        for (int a = (int)axes.size() - 1; a >= 0 && done; a--){
+            if (++choice[a] < axes[a].labels.size()){
+                done = false;
+            }
+            else{
+                choice[a] = 0;
+            }
+        }
+    }
+}
+
+/* Writes the parameter file of a run. */
+void Benchmark::writeParameterFile(const Run& run, const std::vector< std::pair<std::string, std::string> >& settings) const
+{
+    std::ifstream base(baseFile.c_str());
+    if (!base){
+        std::cerr << "ERROR: Unable to open benchmark base parameter file '" << baseFile << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::ofstream file(run.parameterFile.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write parameter file '" << run.parameterFile << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    /* Parameters are looked up by their first occurrence: the first setting of a key wins, and base lines setting it are dropped. */
+    std::map<std::string, bool> written;
+    for (unsigned int s = 0; s < settings.size(); s++){
+        if (written[settings[s].first]) continue;
+        written[settings[s].first] = true;
+        file << settings[s].first << "=" << settings[s].second << std::endl;
+    }
+    std::string line;
+    while (std::getline(base, line)){
+        if (line.empty() || line[0] == '#') continue;
+        const std::size_t EQUAL = line.find('=');
+        if (EQUAL != std::string::npos && written.count(line.substr(0, EQUAL))) continue;
+        file << line << std::endl;
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Runs every configuration, each in its own process. */
+int Benchmark::run(const Batch::Solve& solve, const int nbJobs)
+{
+    const std::string RESULTS = getFixed("outputFile");
+    std::remove(RESULTS.c_str());
+
+    std::map<pid_t, unsigned int> running;
+    std::map<pid_t, std::chrono::steady_clock::time_point> started;
+    unsigned int next = 0;
+    unsigned int nbFinished = 0;
+    int nbFailed = 0;
+    while (next < runs.size() || !running.empty()){
+        while (next < runs.size() && (int)running.size() < std::max(1, nbJobs)){
+            std::cout.flush();
+            std::cerr.flush();
+            const pid_t PID = fork();
+            if (PID == 0){
+                /* The run writes its log apart and reports its outcome through its exit status. */
+                const std::string LOG = runsDirectory + "/" + runs[next].id + ".log";
+                if (freopen(LOG.c_str(), "w", stdout) != NULL){
+                    dup2(fileno(stdout), fileno(stderr));
+                }
+                int status = 1;
+                try {
+                    Data data(runs[next].parameterFile);
+                    data.print();
+                    status = solve(data);
+                    data.getProfiler().print();
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "ERROR: " << e.what() << std::endl;
+                }
+                catch (...) {
+                    std::cerr << "ERROR: Unknown exception caught!" << std::endl;
+                }
+                std::cout.flush();
+                std::cerr.flush();
+                _exit(status);
+            }
+            if (PID < 0){
+                std::cerr << "ERROR: Unable to start run '" << runs[next].id << "'." << std::endl;
+                nbFailed++;
+                next++;
+                continue;
+            }
+            running[PID] = next;
+            started[PID] = std::chrono::steady_clock::now();
+            next++;
+        }
+        if (running.empty()) continue;
+
+        int status = 0;
+        const pid_t PID = waitpid(-1, &status, 0);
+        if (PID < 0){
+            std::cerr << "ERROR: Lost track of the benchmark runs." << std::endl;
+            return nbFailed + (int)(runs.size() - next + running.size());
+        }
+        if (running.count(PID) == 0) continue;
+        Run& done = runs[running[PID]];
+        done.status = (WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        if (done.status != 0){
+            nbFailed++;
+        }
+        nbFinished++;
+        std::cout << "\t [" << nbFinished << "/" << runs.size() << "] " << done.id << ": " << (done.status == 0 ? "done" : "failed") << " in "
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - started[PID]).count() << "s." << std::endl;
+        running.erase(PID);
+        started.erase(PID);
+    }
+    std::cout << "\t Results written to " << RESULTS << ", logs and parameter files to " << runsDirectory << "." << std::endl;
+    return nbFailed;
+}
+
+/* Compares the results to the baseline and displays the comparison. */
+int Benchmark::compare() const
+{
+    const std::string RESULTS = getFixed("outputFile");
+	std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                 Comparing against the baseline.               -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::ifstream check(baselineFile.c_str());
+    if (baselineFile.empty() || !check){
+        std::cout << "\t No baseline was found. Copy " << RESULTS << " to "
+                  << (baselineFile.empty() ? "the file given by baseline=" : baselineFile)
+                  << " to keep these results as the reference." << std::endl;
+        return 0;
+    }
+    const Records BASELINE = readResults(baselineFile);
+    const Records CURRENT = readResults(RESULTS);
+
+    int nbRegressions = 0;
+    for (unsigned int r = 0; r < runs.size(); r++){
+        const std::string& ID = runs[r].id;
+        Records::const_iterator current = CURRENT.find(ID);
+        Records::const_iterator base = BASELINE.find(ID);
+        if (current == CURRENT.end()){
+            std::cout << "\t " << ID << ": MISSING (the run wrote no results)." << std::endl;
+            nbRegressions++;
+            continue;
+        }
+        if (base == BASELINE.end()){
+            std::cout << "\t " << ID << ": new run, not in the baseline." << std::endl;
+            continue;
+        }
+        std::map<std::string, std::string>::const_iterator version = base->second.find("schema_version");
+        if (version == base->second.end() || version->second != current->second.at("schema_version")){
+            std::cout << "\t " << ID << ": WARNING: the baseline was written with another results schema." << std::endl;
+        }
+
+        std::ostringstream report;
+        report << std::setprecision(6);
+        int nbRunRegressions = 0;
+        for (unsigned int t = 0; t < tolerances.size(); t++){
+            const Tolerance& tolerance = tolerances[t];
+            std::map<std::string, std::string>::const_iterator before = base->second.find(tolerance.metric);
+            std::map<std::string, std::string>::const_iterator after = current->second.find(tolerance.metric);
+            if (before == base->second.end() || after == current->second.end()) continue;
+            const double BEFORE = std::strtod(before->second.c_str(), NULL);
+            const double AFTER = std::strtod(after->second.c_str(), NULL);
+            if (!std::isfinite(BEFORE) || !std::isfinite(AFTER)) continue;
+            if (AFTER > BEFORE * (1.0 + tolerance.relative) + tolerance.absolute){
+                report << " " << tolerance.metric << " " << BEFORE << " -> " << AFTER << ";";
+                nbRunRegressions++;
+            }
+        }
+        if (nbRunRegressions > 0){
+            std::cout << "\t " << ID << ": REGRESSION:" << report.str() << std::endl;
+            nbRegressions += nbRunRegressions;
+        }
+        else{
+            std::cout << "\t " << ID << ": ok." << std::endl;
+        }
+    }
+    std::cout << "\t " << nbRegressions << " regressions against " << baselineFile << "." << std::endl << std::endl;
+    return nbRegressions;
+}
+
+/****************************************************************************************/
+/*										Auxiliary										*/
+/****************************************************************************************/
+
+/* Returns the value of a parameter set for every run. */
+std::string Benchmark::getFixed(const std::string& key) const
+{
+    for (unsigned int s = 0; s < fixed.size(); s++){
+        if (fixed[s].first == key) return fixed[s].second;
+    }
+    return "";
+}
+
+/* Returns the results file of a benchmark, keyed by run id. Later rows of a run replace earlier ones. */
+Benchmark::Records Benchmark::readResults(const std::string& filename) const
+{
+    Records records;
+    std::ifstream file(filename.c_str());
+    std::string line;
+    if (!std::getline(file, line)){
+        return records;
+    }
+    const std::vector<std::string> HEADER = splitCsv(line);
+    while (std::getline(file, line)){
+        const std::vector<std::string> FIELDS = splitCsv(line);
+        std::map<std::string, std::string> record;
+        for (unsigned int j = 0; j < HEADER.size() && j < FIELDS.size(); j++){
+            record[HEADER[j]] = FIELDS[j];
+        }
+        if (record.count("parameter_file")){
+            records[getRunId(record["parameter_file"])] = record;
+        }
+    }
+    return records;
+}
+
+/* Returns the id of the run of a given parameter file: its name without directory nor extension. */
+std::string Benchmark::getRunId(const std::string& parameterFile)
+{
+    std::string id = parameterFile.substr(parameterFile.find_last_of('/') + 1);
+    const std::size_t DOT = id.rfind(".txt");
+    return (DOT == std::string::npos ? id : id.substr(0, DOT));
+}
+
+/* Splits a csv line into its fields, unquoting quoted ones. */
+std::vector<std::string> Benchmark::splitCsv(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (unsigned int c = 0; c < line.size(); c++){
+        if (quoted){
+            if (line[c] == '"' && c + 1 < line.size() && line[c+1] == '"'){
+                fields.back() += '"';
+                c++;
+            }
+            else if (line[c] == '"'){
+                quoted = false;
+            }
+            else{
+                fields.back() += line[c];
+            }
+        }
+        else if (line[c] == '"')    quoted = true;
+        else if (line[c] == ',')    fields.push_back("");
+        else if (line[c] != '\r')   fields.back() += line[c];
+    }
+    return fields;
+}
+
+/* Replaces every {name} by the label chosen on axis name. */
+std::string Benchmark::substitute(const std::string& value, const std::map<std::string, std::string>& labels)
+{
+    std::string result = value;
+    for (std::map<std::string, std::string>::const_iterator it = labels.begin(); it != labels.end(); ++it){
+        const std::string PLACEHOLDER = "{" + it->first + "}";
+        for (std::size_t pos = result.find(PLACEHOLDER); pos != std::string::npos; pos = result.find(PLACEHOLDER, pos + it->second.size())){
+            result.replace(pos, PLACEHOLDER.size(), it->second);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,109 @@
+#ifndef __benchmark__hpp
+#define __benchmark__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+/*** Own Libraries ***/
+#include "batch.hpp"
+
+
+/************************************************************************************
+ * This class runs a fixed matrix of configurations and compares the outcome to
+ * a stored baseline. The matrix file holds:
+ *  - base=<file>: the parameter file every configuration starts from;
+ *  - runs=<directory>: where the parameter file and log of each run are written;
+ *  - baseline=<file>: the results file of a reference benchmark, if any;
+ *  - key=value: a parameter set for every run, such as outputFile= or timeLimit=;
+ *  - axis <name> <label>[:key=value,...] ...: one dimension of the matrix, each
+ *    label possibly setting parameters;
+ *  - tolerance <metric> <relative> <absolute>: the allowed growth of a metric.
+ * Every run is a combination of one label per axis and is identified by its
+ * labels. Values may refer to the label chosen on an axis as {name}. Each run is
+ * solved in its own process, so that its peak memory and a crash stay its own.
+ * A metric regresses when its value exceeds baseline * (1 + relative) + absolute;
+ * every compared metric is better when lower.
+ ************************************************************************************/
+class Benchmark {
+
+private:
+    /** A dimension of the matrix. **/
+    struct Axis {
+        std::string                                                     name;       /**< The axis name. **/
+        std::vector<std::string>                                        labels;     /**< The label of each value. **/
+        std::vector< std::vector< std::pair<std::string, std::string> > > settings; /**< The parameters set by each value. **/
+    };
+
+    /** The allowed growth of a metric. **/
+    struct Tolerance {
+        std::string metric;     /**< The results field. **/
+        double      relative;   /**< The allowed relative growth. **/
+        double      absolute;   /**< The allowed absolute growth, above the relative one. **/
+    };
+
+    /** A configuration of the matrix. **/
+    struct Run {
+        std::string id;             /**< The labels of the run, joined by '-'. **/
+        std::string parameterFile;  /**< The parameter file written for the run. **/
+        int         status;         /**< The value returned by the solver, or -1 if the run did not end normally. **/
+    };
+
+    /** The results of a benchmark, by run id and then by field. **/
+    typedef std::map< std::string, std::map<std::string, std::string> > Records;
+
+    std::string                                         matrixFile;     /**< The matrix file. **/
+    std::string                                         baseFile;       /**< The parameter file every run starts from. **/
+    std::string                                         runsDirectory;  /**< The directory of the run parameter files and logs. **/
+    std::string                                         baselineFile;   /**< The results file of the reference benchmark. **/
+    std::vector< std::pair<std::string, std::string> >  fixed;          /**< The parameters set for every run. **/
+    std::vector<Axis>                                   axes;           /**< The matrix dimensions. **/
+    std::vector<Tolerance>                              tolerances;     /**< The compared metrics. **/
+    std::vector<Run>                                    runs;           /**< The configurations. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Reads the matrix and writes the parameter file of every run. @param matrixFile_ The matrix file. **/
+    Benchmark(const std::string& matrixFile_);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Runs every configuration, each in its own process. Returns the number of failed runs. @param solve The solver run on each configuration. @param nbJobs The number of runs solved concurrently. **/
+    int run(const Batch::Solve& solve, const int nbJobs);
+
+    /** Compares the results to the baseline and displays the comparison. Returns the number of regressions and missing runs, or 0 if there is no baseline. **/
+    int compare() const;
+
+private:
+    /** Reads the matrix file. **/
+    void readMatrix();
+    /** Builds the runs as the product of the axes and writes their parameter files. **/
+    void expand();
+    /** Writes the parameter file of a run. @param run The run. @param settings The parameters set by the matrix, taking precedence over the base file. **/
+    void writeParameterFile(const Run& run, const std::vector< std::pair<std::string, std::string> >& settings) const;
+
+    /** Returns the value of a parameter set for every run, or an empty string. **/
+    std::string getFixed(const std::string& key) const;
+    /** Returns the results file of a benchmark, keyed by run id. @param filename A csv results file. **/
+    Records readResults(const std::string& filename) const;
+    /** Returns the id of the run of a given parameter file. **/
+    static std::string getRunId(const std::string& parameterFile);
+    /** Splits a csv line into its fields. **/
+    static std::vector<std::string> splitCsv(const std::string& line);
+    /** Replaces every {name} by the label chosen on axis name. **/
+    static std::string substitute(const std::string& value, const std::map<std::string, std::string>& labels);
+};
+
+#endif
@@ -0,0 +1,544 @@
+#include "generator.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <numeric>
+#include <algorithm>
+#include <sys/stat.h>
+
+#define CAPACITY_SLACK 2.0      // Ratio between the total node capacity and the load lower bound of the largest demand file
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Reads the specification. */
+Generator::Generator(const std::string& specFile_) : specFile(specFile_), output(""), seed(20102019),
+                        degree(4.0), waxmanBeta(0.1), gridColumns(0), nbRings(0), nbVnfs(8), chainMin(1), chainMax(6),
+                        nbDemandFiles(1)
+{
+    std::cout << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    std::cout << "-                 Generating synthetic instances.               -" << std::endl;
+    std::cout << "=================================================================" << std::endl;
+    readSpec();
+}
+
+/* Reads the specification file. */
+void Generator::readSpec()
+{
+    std::ifstream spec(specFile.c_str());
+    if (!spec){
+        std::cerr << "ERROR: Unable to open generator specification '" << specFile << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string line;
+    while (std::getline(spec, line)){
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') continue;
+
+        const std::size_t EQUAL = line.find('=');
+        if (EQUAL == std::string::npos){
+            std::cerr << "WARNING: Generator line '" << line << "' is not understood and is ignored." << std::endl;
+            continue;
+        }
+        const std::string KEY = line.substr(0, EQUAL);
+        const std::string VALUE = line.substr(EQUAL + 1);
+        if (KEY == "output")                output = VALUE;
+        else if (KEY == "seed")             seed = std::strtoull(VALUE.c_str(), NULL, 10);
+        else if (KEY == "degree")           degree = std::atof(VALUE.c_str());
+        else if (KEY == "waxman_beta")      waxmanBeta = std::atof(VALUE.c_str());
+        else if (KEY == "grid_columns")     gridColumns = std::atoi(VALUE.c_str());
+        else if (KEY == "rings")            nbRings = std::atoi(VALUE.c_str());
+        else if (KEY == "vnfs")             nbVnfs = std::atoi(VALUE.c_str());
+        else if (KEY == "chain_min")        chainMin = std::atoi(VALUE.c_str());
+        else if (KEY == "chain_max")        chainMax = std::atoi(VALUE.c_str());
+        else if (KEY == "demand_files")     nbDemandFiles = std::atoi(VALUE.c_str());
+        else if (KEY == "topology"){
+            std::vector<std::string> list = splitList(VALUE);
+            for (unsigned int j = 0; j < list.size(); j++){
+                if (list[j] == "waxman")            topologies.push_back(TOPOLOGY_WAXMAN);
+                else if (list[j] == "grid")         topologies.push_back(TOPOLOGY_GRID);
+                else if (list[j] == "ringofrings")  topologies.push_back(TOPOLOGY_RING_OF_RINGS);
+                else std::cerr << "WARNING: Unknown topology '" << list[j] << "' is ignored." << std::endl;
+            }
+        }
+        else if (KEY == "nodes" || KEY == "demands"){
+            std::vector<std::string> list = splitList(VALUE);
+            for (unsigned int j = 0; j < list.size(); j++){
+                (KEY == "nodes" ? sizes : demandCounts).push_back(std::atoi(list[j].c_str()));
+            }
+        }
+        else if (KEY == "sla_class"){
+            SlaClass sla;
+            char separator;
+            std::istringstream fields(VALUE);
+            if (fields >> sla.availability >> separator >> sla.maxLatency >> separator >> sla.bandwidth >> separator >> sla.weight
+                    && sla.availability > 0.0 && sla.availability < 1.0 && sla.weight > 0.0){
+                slaClasses.push_back(sla);
+            }
+            else{
+                std::cerr << "WARNING: Generator line '" << line << "' is not a valid sla class and is ignored." << std::endl;
+            }
+        }
+        else{
+            std::cerr << "WARNING: Generator parameter '" << KEY << "' is unknown and is ignored." << std::endl;
+        }
+    }
+
+    if (output.empty() || topologies.empty() || sizes.empty() || demandCounts.empty()){
+        std::cerr << "ERROR: A generator specification MUST declare output=, topology=, nodes= and demands=." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (*std::min_element(sizes.begin(), sizes.end()) < 2 || nbVnfs < 1 || chainMin < 1 || chainMax < chainMin || nbDemandFiles < 1){
+        std::cerr << "ERROR: A generator specification needs at least 2 nodes, 1 vnf, 1 demand file and 1 <= chain_min <= chain_max." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (chainMax > nbVnfs){
+        std::cerr << "WARNING: Chains are limited to the " << nbVnfs << " vnfs." << std::endl;
+        chainMax = nbVnfs;
+        chainMin = std::min(chainMin, chainMax);
+    }
+    /* The classes of the shipped instances, weighted by their frequency. */
+    if (slaClasses.empty()){
+        const SlaClass DEFAULT_CLASSES[] = { {0.999, 40000, 10, 52}, {0.999, 60000, 1, 50}, {0.9999, 10000, 10, 57},
+                                             {0.99999, 5000, 10, 38}, {0.99999, 30000, 10, 46}, {0.99999, 60000, 28, 17},
+                                             {0.99999, 60000, 61, 13}, {0.99999, 60000, 79, 18} };
+        slaClasses.assign(DEFAULT_CLASSES, DEFAULT_CLASSES + sizeof(DEFAULT_CLASSES) / sizeof(DEFAULT_CLASSES[0]));
+    }
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Returns the name of a topology model. */
+std::string Generator::getName(const Topology topology)
+{
+    switch (topology){
+        case TOPOLOGY_WAXMAN:           return "waxman";
+        case TOPOLOGY_GRID:             return "grid";
+        case TOPOLOGY_RING_OF_RINGS:    return "ringofrings";
+        default:                        return "unknown";
+    }
+}
+
+/* Writes every instance of the specification. */
+int Generator::run() const
+{
+    int nbFailed = 0;
+    for (unsigned int t = 0; t < topologies.size(); t++){
+        for (unsigned int n = 0; n < sizes.size(); n++){
+            if (!writeInstance(topologies[t], sizes[n])){
+                nbFailed++;
+            }
+        }
+    }
+    return nbFailed;
+}
+
+/* Writes the instance of a topology model and number of nodes. */
+bool Generator::writeInstance(const Topology topology, const int nbNodes) const
+{
+    std::string directory = output;
+    const std::string PLACEHOLDERS[] = { "{topology}", "{nodes}" };
+    const std::string VALUES[] = { getName(topology), std::to_string(nbNodes) };
+    for (int p = 0; p < 2; p++){
+        for (std::size_t pos = directory.find(PLACEHOLDERS[p]); pos != std::string::npos; pos = directory.find(PLACEHOLDERS[p], pos)){
+            directory.replace(pos, PLACEHOLDERS[p].size(), VALUES[p]);
+            pos += VALUES[p].size();
+        }
+    }
+    if (!makeDirectory(directory)){
+        std::cerr << "ERROR: Unable to create instance directory '" << directory << "'." << std::endl;
+        return false;
+    }
+    std::cout << "\t Writing " << getName(topology) << " instance with " << nbNodes << " nodes to " << directory << " ..." << std::endl;
+
+    const uint64_t KEY = getInstanceKey(topology, nbNodes);
+    std::vector<Point> points;
+    std::vector< std::pair<int, int> > edges;
+    Random topologyRandom(seed, STREAM_TOPOLOGY, KEY);
+    switch (topology){
+        case TOPOLOGY_WAXMAN:           buildWaxman(nbNodes, topologyRandom, points, edges); break;
+        case TOPOLOGY_GRID:             buildGrid(nbNodes, points, edges); break;
+        case TOPOLOGY_RING_OF_RINGS:    buildRingOfRings(nbNodes, points, edges); break;
+    }
+    connect(points, edges);
+
+    /* Demands are drawn first: node capacities are scaled to their load. */
+    Random vnfRandom(seed, STREAM_VNFS, KEY);
+    const std::vector<int> CONSUMPTIONS = drawVnfs(vnfRandom);
+    std::vector< std::vector<DemandDraw> > demandFiles;
+    std::vector<std::string> demandFilenames;
+    for (unsigned int d = 0; d < demandCounts.size(); d++){
+        for (int j = 0; j < nbDemandFiles; j++){
+            Random random(seed, STREAM_DEMANDS + j, getInstanceKey(topology, nbNodes, demandCounts[d]));
+            demandFiles.push_back(drawDemands(nbNodes, demandCounts[d], random));
+            demandFilenames.push_back(directory + "/" + std::to_string(demandCounts[d]) + "demand_" + std::to_string(j + 1) + ".csv");
+        }
+    }
+
+    bool written = true;
+    std::vector<bool> feasible(demandFiles.size(), true);
+    const char PROFILES[] = { 'C', 'R', 'U' };
+    for (int p = 0; p < 3; p++){
+        Random random(seed, STREAM_NODES + p, KEY);
+        std::vector<NodeDraw> nodes = drawNodes(nbNodes, PROFILES[p], random);
+        double totalCapacity = 0.0;
+        for (int v = 0; v < nbNodes; v++){
+            totalCapacity += nodes[v].capacity;
+        }
+        double maxLoad = 0.0;
+        for (unsigned int d = 0; d < demandFiles.size(); d++){
+            maxLoad = std::max(maxLoad, getLoadLowerBound(nodes, CONSUMPTIONS, demandFiles[d]));
+        }
+        const double SCALE = std::max(1.0, CAPACITY_SLACK * maxLoad / totalCapacity);
+        for (int v = 0; v < nbNodes; v++){
+            nodes[v].capacity = std::ceil(nodes[v].capacity * SCALE);
+        }
+        /* Scaling also makes more nodes able to host the heaviest sections. A demand file must be feasible with every node file. */
+        for (unsigned int d = 0; d < demandFiles.size(); d++){
+            if (getLoadLowerBound(nodes, CONSUMPTIONS, demandFiles[d]) < 0.0){
+                feasible[d] = false;
+            }
+        }
+        if (SCALE > 1.0){
+            std::cout << "\t Capacities of node_" << PROFILES[p] << " scaled by " << SCALE << " for a load lower bound of " << maxLoad << "." << std::endl;
+        }
+        written = writeNodeFile(directory + "/node_" + PROFILES[p] + ".csv", points, nodes) && written;
+    }
+    Random linkRandom(seed, STREAM_LINKS, KEY);
+    written = writeLinkFile(directory + "/link.csv", points, edges, linkRandom) && written;
+    written = writeVnfFile(directory + "/vnf.csv", CONSUMPTIONS) && written;
+    for (unsigned int d = 0; d < demandFiles.size(); d++){
+        if (!feasible[d]){
+            std::cerr << "ERROR: Some demand of '" << demandFilenames[d] << "' cannot reach its availability with every node file. It is not written." << std::endl;
+            written = false;
+            continue;
+        }
+        written = writeDemandFile(demandFilenames[d], demandFiles[d]) && written;
+    }
+    std::cout << "\t " << nbNodes << " nodes and " << 2*edges.size() << " links written." << std::endl;
+    return written;
+}
+
+/****************************************************************************************/
+/*										Topologies										*/
+/****************************************************************************************/
+
+/* Draws the points and edges of a Waxman topology: u and v are linked with probability alpha*exp(-d(u,v)/(beta*L)), L being the plane diagonal and alpha being set so that the expected average degree is the required one. */
+void Generator::buildWaxman(const int nbNodes, Random& random, std::vector<Point>& points, std::vector< std::pair<int, int> >& edges) const
+{
+    points.resize(nbNodes);
+    for (int v = 0; v < nbNodes; v++){
+        points[v].x = 1000.0 * random.uniform();
+        points[v].y = 1000.0 * random.uniform();
+    }
+    const double SCALE = waxmanBeta * 1000.0 * std::sqrt(2.0);
+    double sum = 0.0;
+    for (int u = 0; u < nbNodes; u++){
+        for (int v = u + 1; v < nbNodes; v++){
+            sum += std::exp(-getDistance(points[u], points[v]) / SCALE);
+        }
+    }
+    double alpha = (sum > 0.0 ? 0.5 * degree * nbNodes / sum : 1.0);
+    if (alpha > 1.0){
+        std::cerr << "WARNING: An average degree of " << degree << " cannot be reached with waxman_beta=" << waxmanBeta << "; raise waxman_beta." << std::endl;
+        alpha = 1.0;
+    }
+    for (int u = 0; u < nbNodes; u++){
+        for (int v = u + 1; v < nbNodes; v++){
+            if (random.uniform() < alpha * std::exp(-getDistance(points[u], points[v]) / SCALE)){
+                edges.push_back(std::make_pair(u, v));
+            }
+        }
+    }
+}
+
+/* Builds the points and edges of a grid topology, filled row by row. */
+void Generator::buildGrid(const int nbNodes, std::vector<Point>& points, std::vector< std::pair<int, int> >& edges) const
+{
+    const int COLUMNS = (gridColumns > 0 ? gridColumns : (int)std::ceil(std::sqrt((double)nbNodes)));
+    const int ROWS = (nbNodes + COLUMNS - 1) / COLUMNS;
+    const double SPACING = 1000.0 / std::max(std::max(COLUMNS, ROWS) - 1, 1);
+    points.resize(nbNodes);
+    for (int v = 0; v < nbNodes; v++){
+        points[v].x = SPACING * (v % COLUMNS);
+        points[v].y = SPACING * (v / COLUMNS);
+        if (v % COLUMNS > 0)    edges.push_back(std::make_pair(v - 1, v));
+        if (v >= COLUMNS)       edges.push_back(std::make_pair(v - COLUMNS, v));
+    }
+}
+
+/* Builds the points and edges of a ring of rings topology: the nodes are shared evenly among rings placed on a circle, and the first node of each ring belongs to the core ring. */
+void Generator::buildRingOfRings(const int nbNodes, std::vector<Point>& points, std::vector< std::pair<int, int> >& edges) const
+{
+    const int RINGS = std::min(nbNodes, (nbRings > 0 ? nbRings : std::max(1, (int)std::lround(std::sqrt((double)nbNodes)))));
+    const double PI = std::acos(-1.0);
+    const double CORE_RADIUS = (RINGS > 1 ? 400.0 : 0.0);
+    const double RING_RADIUS = (RINGS > 1 ? std::min(100.0, 0.8 * CORE_RADIUS * std::sin(PI / RINGS)) : 400.0);
+    std::vector<int> gateways;
+    points.resize(nbNodes);
+    int first = 0;
+    for (int r = 0; r < RINGS; r++){
+        const int SIZE = nbNodes / RINGS + (r < nbNodes % RINGS ? 1 : 0);
+        const double CENTER_X = 500.0 + CORE_RADIUS * std::cos(2.0 * PI * r / RINGS);
+        const double CENTER_Y = 500.0 + CORE_RADIUS * std::sin(2.0 * PI * r / RINGS);
+        for (int j = 0; j < SIZE; j++){
+            /* The ring starts on the side facing the core, where its gateway lies. */
+            const double ANGLE = 2.0 * PI * r / RINGS + PI + 2.0 * PI * j / SIZE;
+            points[first + j].x = CENTER_X + RING_RADIUS * std::cos(ANGLE);
+            points[first + j].y = CENTER_Y + RING_RADIUS * std::sin(ANGLE);
+            if (j > 0) edges.push_back(std::make_pair(first + j - 1, first + j));
+        }
+        if (SIZE > 2) edges.push_back(std::make_pair(first, first + SIZE - 1));
+        gateways.push_back(first);
+        first += SIZE;
+    }
+    for (int r = 0; r + 1 < RINGS; r++){
+        edges.push_back(std::make_pair(gateways[r], gateways[r + 1]));
+    }
+    if (RINGS > 2) edges.push_back(std::make_pair(gateways[0], gateways[RINGS - 1]));
+}
+
+/* Links every connected component to the nearest node of the components before it, so that every demand can be routed. */
+void Generator::connect(const std::vector<Point>& points, std::vector< std::pair<int, int> >& edges)
+{
+    const int NB_NODES = (int)points.size();
+    std::vector<int> parent(NB_NODES);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int v){
+        while (parent[v] != v){
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+    for (unsigned int e = 0; e < edges.size(); e++){
+        parent[find(edges[e].first)] = find(edges[e].second);
+    }
+    /* Nodes are visited in id order: the first node of each new component is linked to the nearest node already visited. */
+    std::vector<bool> seen(NB_NODES, false);
+    for (int v = 0; v < NB_NODES; v++){
+        const int ROOT = find(v);
+        if (seen[ROOT]) continue;
+        seen[ROOT] = true;
+        if (v == 0) continue;
+        int nearest = 0;
+        for (int u = 1; u < v; u++){
+            if (getDistance(points[u], points[v]) < getDistance(points[nearest], points[v])){
+                nearest = u;
+            }
+        }
+        edges.push_back(std::make_pair(nearest, v));
+        parent[ROOT] = find(nearest);
+    }
+}
+
+/****************************************************************************************/
+/*										Files											*/
+/****************************************************************************************/
+
+/* Draws the nodes of a node file. Availabilities are drawn in thousandths: constant for C, in [0.990, 0.999] for R and in [0.960, 0.999] for U. */
+std::vector<Generator::NodeDraw> Generator::drawNodes(const int nbNodes, const char profile, Random& random) const
+{
+    std::vector<NodeDraw> nodes(nbNodes);
+    for (int v = 0; v < nbNodes; v++){
+        nodes[v].capacity = getUniformInt(random, 6400, 32000);
+        nodes[v].thousandths = 990;
+        if (profile == 'R')         nodes[v].thousandths = getUniformInt(random, 990, 999);
+        else if (profile == 'U')    nodes[v].thousandths = getUniformInt(random, 960, 999);
+        nodes[v].cost = getUniformInt(random, 10, 100);
+    }
+    return nodes;
+}
+
+/* Returns a lower bound on the capacity used by the demands. */
+double Generator::getLoadLowerBound(const std::vector<NodeDraw>& nodes, const std::vector<int>& consumptions, const std::vector<DemandDraw>& demands) const
+{
+    /* Most available nodes first. */
+    std::vector<int> rank(nodes.size());
+    std::iota(rank.begin(), rank.end(), 0);
+    std::stable_sort(rank.begin(), rank.end(), [&nodes](int u, int v){ return nodes[u].thousandths > nodes[v].thousandths; });
+
+    double load = 0.0;
+    for (unsigned int k = 0; k < demands.size(); k++){
+        const SlaClass& SLA = slaClasses[demands[k].sla];
+        for (unsigned int i = 0; i < demands[k].chain.size(); i++){
+            /* The chain availability cannot exceed the availability of any of its sections. */
+            const double SECTION_LOAD = (double)SLA.bandwidth * consumptions[demands[k].chain[i]];
+            double failProb = 1.0;
+            int nb = 0;
+            for (unsigned int r = 0; r < rank.size() && 1.0 - failProb < SLA.availability; r++){
+                if (nodes[rank[r]].capacity < SECTION_LOAD) continue;
+                failProb *= 1.0 - nodes[rank[r]].thousandths / 1000.0;
+                nb++;
+            }
+            if (1.0 - failProb < SLA.availability){
+                return -1.0;
+            }
+            load += nb * SECTION_LOAD;
+        }
+    }
+    return load;
+}
+
+/* Writes a node file. */
+bool Generator::writeNodeFile(const std::string& filename, const std::vector<Point>& points, const std::vector<NodeDraw>& nodes) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write node file '" << filename << "'." << std::endl;
+        return false;
+    }
+    file << "name;lat;long;capacity;availability;cost;" << std::endl;
+    file << std::fixed;
+    for (unsigned int v = 0; v < points.size(); v++){
+        file << "N" << v + 1 << ";" << std::setprecision(2) << points[v].x << ";" << points[v].y << ";"
+             << std::setprecision(0) << nodes[v].capacity << ";" << std::setprecision(3) << nodes[v].thousandths / 1000.0 << ";" << nodes[v].cost << ";" << std::endl;
+    }
+    return true;
+}
+
+/* Writes the link file, with both directions of each edge. The delay is the distance between the end nodes. */
+bool Generator::writeLinkFile(const std::string& filename, const std::vector<Point>& points, const std::vector< std::pair<int, int> >& edges, Random& random) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write link file '" << filename << "'." << std::endl;
+        return false;
+    }
+    file << "name;source;target;delay;bandwidth;" << std::endl;
+    int id = 1;
+    for (unsigned int e = 0; e < edges.size(); e++){
+        const long DELAY = std::max(1L, std::lround(getDistance(points[edges[e].first], points[edges[e].second])));
+        for (int direction = 0; direction < 2; direction++){
+            const int SOURCE = (direction == 0 ? edges[e].first : edges[e].second);
+            const int TARGET = (direction == 0 ? edges[e].second : edges[e].first);
+            file << "L" << id++ << ";N" << SOURCE + 1 << ";N" << TARGET + 1 << ";" << DELAY << ";" << getUniformInt(random, 50, 200) << ";" << std::endl;
+        }
+    }
+    return true;
+}
+
+/* Draws the consumption of each vnf. */
+std::vector<int> Generator::drawVnfs(Random& random) const
+{
+    std::vector<int> consumptions(nbVnfs);
+    for (int f = 0; f < nbVnfs; f++){
+        consumptions[f] = getUniformInt(random, 30, 120);
+    }
+    return consumptions;
+}
+
+/* Writes the vnf file. */
+bool Generator::writeVnfFile(const std::string& filename, const std::vector<int>& consumptions) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write vnf file '" << filename << "'." << std::endl;
+        return false;
+    }
+    file << "name;consumption;" << std::endl;
+    for (int f = 0; f < nbVnfs; f++){
+        file << "vnf_" << f + 1 << ";" << consumptions[f] << ";" << std::endl;
+    }
+    return true;
+}
+
+/* Draws the demands of a demand file. Each demand draws its class, two distinct end nodes and a chain of distinct vnfs. */
+std::vector<Generator::DemandDraw> Generator::drawDemands(const int nbNodes, const int nbDemands, Random& random) const
+{
+    double totalWeight = 0.0;
+    for (unsigned int c = 0; c < slaClasses.size(); c++){
+        totalWeight += slaClasses[c].weight;
+    }
+    std::vector<DemandDraw> demands(nbDemands);
+    std::vector<int> vnfs(nbVnfs);
+    for (int k = 0; k < nbDemands; k++){
+        double draw = totalWeight * random.uniform();
+        unsigned int c = 0;
+        while (c + 1 < slaClasses.size() && draw >= slaClasses[c].weight){
+            draw -= slaClasses[c].weight;
+            c++;
+        }
+        demands[k].sla = c;
+        demands[k].source = getUniformInt(random, 0, nbNodes - 1);
+        demands[k].target = getUniformInt(random, 0, nbNodes - 2);
+        if (demands[k].target >= demands[k].source) demands[k].target++;
+
+        /* The chain is the prefix of a partial shuffle of the vnfs. */
+        const int LENGTH = getUniformInt(random, chainMin, chainMax);
+        std::iota(vnfs.begin(), vnfs.end(), 0);
+        for (int i = 0; i < LENGTH; i++){
+            std::swap(vnfs[i], vnfs[getUniformInt(random, i, nbVnfs - 1)]);
+            demands[k].chain.push_back(vnfs[i]);
+        }
+    }
+    return demands;
+}
+
+/* Writes a demand file. */
+bool Generator::writeDemandFile(const std::string& filename, const std::vector<DemandDraw>& demands) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file){
+        std::cerr << "ERROR: Unable to write demand file '" << filename << "'." << std::endl;
+        return false;
+    }
+    file << "name;source;target;max_latency;bandwidth;availability;vnf_list" << std::endl;
+    for (unsigned int k = 0; k < demands.size(); k++){
+        const SlaClass& SLA = slaClasses[demands[k].sla];
+        std::ostringstream chain;
+        for (unsigned int i = 0; i < demands[k].chain.size(); i++){
+            chain << (i > 0 ? "," : "") << "vnf_" << demands[k].chain[i] + 1;
+        }
+        file << "d_" << k + 1 << ";N" << demands[k].source + 1 << ";N" << demands[k].target + 1 << ";" << SLA.maxLatency << ";"
+             << SLA.bandwidth << ";" << std::setprecision(10) << SLA.availability << ";" << chain.str() << std::endl;
+    }
+    return true;
+}
+
+/****************************************************************************************/
+/*										Tools											*/
+/****************************************************************************************/
+
+/* Returns the key of the random streams of an instance: the topology, the number of demands and the number of nodes. */
+uint64_t Generator::getInstanceKey(const Topology topology, const int nbNodes, const int nbDemands)
+{
+    return ((uint64_t)topology << 56) | ((uint64_t)(nbDemands & 0xFFFFFF) << 32) | (uint64_t)(uint32_t)nbNodes;
+}
+
+/* Returns an integer drawn uniformly in [min, max]. */
+int Generator::getUniformInt(Random& random, const int min, const int max)
+{
+    return std::min(max, min + (int)(random.uniform() * (max - min + 1)));
+}
+
+/* Splits a comma-separated list. */
+std::vector<std::string> Generator::splitList(const std::string& list)
+{
+    std::vector<std::string> values;
+    std::istringstream stream(list);
+    std::string value;
+    while (std::getline(stream, value, ',')){
+        value.erase(0, value.find_first_not_of(" \t"));
+        value.erase(value.find_last_not_of(" \t") + 1);
+        if (!value.empty()) values.push_back(value);
+    }
+    return values;
+}
+
+/* Creates a directory and its parents. */
+bool Generator::makeDirectory(const std::string& path)
+{
+    for (std::size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)){
+        const std::string PREFIX = path.substr(0, pos);
+        if (!PREFIX.empty() && mkdir(PREFIX.c_str(), 0755) != 0 && errno != EEXIST){
+            return false;
+        }
+        if (pos == std::string::npos) return true;
+    }
+}
@@ -0,0 +1,177 @@
+#ifndef __generator__hpp
+#define __generator__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+/*** Own Libraries ***/
+#include "random.hpp"
+
+
+/************************************************************************************
+ * This class generates synthetic instances in the format read by Data. The
+ * specification file holds key=value lines:
+ *  - output=<directory>: where each instance is written, possibly using the
+ *    {topology} and {nodes} placeholders;
+ *  - seed=<n>: the seed every draw derives from;
+ *  - topology=<list>: the topology models among waxman, grid and ringofrings;
+ *  - nodes=<list>: the numbers of nodes;
+ *  - degree=, waxman_beta=: the Waxman average degree and distance decay;
+ *  - grid_columns=, rings=: the grid width and the number of rings (0 for the
+ *    square root of the number of nodes);
+ *  - vnfs=, chain_min=, chain_max=: the number of vnfs and the chain lengths;
+ *  - demands=<list>, demand_files=<n>: the number of demands of each demand file
+ *    and the number of files of each size;
+ *  - sla_class=<availability>;<max latency>;<bandwidth>;<weight>: a demand class,
+ *    possibly repeated. The classes of the shipped instances are used by default.
+ * An instance is generated for each topology and number of nodes. It holds the
+ * node_C (every node at 0.99), node_R (0.990 to 0.999) and node_U (0.960 to
+ * 0.999) node files over the same topology, a link file with both directions
+ * of each edge, a vnf file and the <n>demand_<j> demand files. Each file is
+ * drawn from its own random stream, keyed by the topology and number of
+ * nodes, so that an instance does not depend on the other instances listed.
+ * Node capacities are drawn in [6400, 32000], then scaled so that the total
+ * capacity of each node file is at least CAPACITY_SLACK times the load lower
+ * bound of the largest demand file of the instance: every section needs
+ * the smallest number of nodes reaching the SLA on its own. A demand file
+ * that is still infeasible under this bound with some node file is not
+ * written.
+ ************************************************************************************/
+class Generator {
+
+public:
+    /** The topology models. **/
+    enum Topology {
+        TOPOLOGY_WAXMAN         = 0,    /**< Random points, linked with a probability decreasing with their distance. **/
+        TOPOLOGY_GRID           = 1,    /**< Points on a grid, linked to their horizontal and vertical neighbours. **/
+        TOPOLOGY_RING_OF_RINGS  = 2     /**< Rings of points, whose first points are linked by a core ring. **/
+    };
+
+private:
+    /** A demand class. **/
+    struct SlaClass {
+        double  availability;   /**< The required availability. **/
+        int     maxLatency;     /**< The maximum latency. **/
+        int     bandwidth;      /**< The bandwidth. **/
+        double  weight;         /**< The relative frequency of the class. **/
+    };
+
+    /** A demand, before it is written. **/
+    struct DemandDraw {
+        int                 source;     /**< The source node. **/
+        int                 target;     /**< The target node. **/
+        int                 sla;        /**< The demand class. **/
+        std::vector<int>    chain;      /**< The vnfs of the chain. **/
+    };
+
+    /** A node, before it is written. **/
+    struct NodeDraw {
+        double  capacity;       /**< The capacity, before scaling. **/
+        int     thousandths;    /**< The availability, in thousandths. **/
+        int     cost;           /**< The cost. **/
+    };
+
+    /** A node location. **/
+    struct Point {
+        double x;   /**< The abscissa, in [0,1000]. **/
+        double y;   /**< The ordinate, in [0,1000]. **/
+    };
+
+    /** The random streams: each file of an instance is drawn from its own. **/
+    enum Stream {
+        STREAM_TOPOLOGY = 0,
+        STREAM_NODES    = 1,    /**< One stream per node file, from STREAM_NODES. **/
+        STREAM_LINKS    = 4,
+        STREAM_VNFS     = 5,
+        STREAM_DEMANDS  = 6     /**< One stream per demand file of each size, from STREAM_DEMANDS. **/
+    };
+
+    std::string                 specFile;       /**< The specification file. **/
+    std::string                 output;         /**< The directory of each instance. **/
+    uint64_t                    seed;           /**< The seed. **/
+    std::vector<Topology>       topologies;     /**< The topology models. **/
+    std::vector<int>            sizes;          /**< The numbers of nodes. **/
+    double                      degree;         /**< The Waxman average degree. **/
+    double                      waxmanBeta;     /**< The Waxman distance decay, relative to the plane diagonal. **/
+    int                         gridColumns;    /**< The number of grid columns, or 0. **/
+    int                         nbRings;        /**< The number of rings, or 0. **/
+    int                         nbVnfs;         /**< The number of vnfs. **/
+    int                         chainMin;       /**< The minimum chain length. **/
+    int                         chainMax;       /**< The maximum chain length. **/
+    std::vector<int>            demandCounts;   /**< The number of demands of each demand file. **/
+    int                         nbDemandFiles;  /**< The number of demand files of each size. **/
+    std::vector<SlaClass>       slaClasses;     /**< The demand classes. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Reads the specification. @param specFile_ The specification file. **/
+    Generator(const std::string& specFile_);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Writes every instance of the specification. Returns the number of instances that could not be written. **/
+    int run() const;
+
+    /** Returns the name of a topology model. **/
+    static std::string getName(const Topology topology);
+
+private:
+    /** Reads the specification file. **/
+    void readSpec();
+    /** Writes the instance of a topology model and number of nodes. Returns false if a file cannot be written. **/
+    bool writeInstance(const Topology topology, const int nbNodes) const;
+
+    /** Draws the points and edges of a Waxman topology, calibrated to the average degree. **/
+    void buildWaxman(const int nbNodes, Random& random, std::vector<Point>& points, std::vector< std::pair<int, int> >& edges) const;
+    /** Builds the points and edges of a grid topology. **/
+    void buildGrid(const int nbNodes, std::vector<Point>& points, std::vector< std::pair<int, int> >& edges) const;
+    /** Builds the points and edges of a ring of rings topology. **/
+    void buildRingOfRings(const int nbNodes, std::vector<Point>& points, std::vector< std::pair<int, int> >& edges) const;
+    /** Links every connected component to the nearest node of the components before it. **/
+    static void connect(const std::vector<Point>& points, std::vector< std::pair<int, int> >& edges);
+
+    /** Draws the nodes of a node file. @param profile The availability profile: 'C', 'R' or 'U'. **/
+    std::vector<NodeDraw> drawNodes(const int nbNodes, const char profile, Random& random) const;
+    /** Draws the consumption of each vnf. **/
+    std::vector<int> drawVnfs(Random& random) const;
+    /** Draws the demands of a demand file. **/
+    std::vector<DemandDraw> drawDemands(const int nbNodes, const int nbDemands, Random& random) const;
+    /** Returns a lower bound on the capacity used by the demands: each section is assigned to the fewest nodes able to host it whose availability reaches the SLA, or returns -1 if some section cannot reach it. **/
+    double getLoadLowerBound(const std::vector<NodeDraw>& nodes, const std::vector<int>& consumptions, const std::vector<DemandDraw>& demands) const;
+
+    /** Writes a node file. **/
+    bool writeNodeFile(const std::string& filename, const std::vector<Point>& points, const std::vector<NodeDraw>& nodes) const;
+    /** Writes the link file, with both directions of each edge. **/
+    bool writeLinkFile(const std::string& filename, const std::vector<Point>& points, const std::vector< std::pair<int, int> >& edges, Random& random) const;
+    /** Writes the vnf file. **/
+    bool writeVnfFile(const std::string& filename, const std::vector<int>& consumptions) const;
+    /** Writes a demand file. **/
+    bool writeDemandFile(const std::string& filename, const std::vector<DemandDraw>& demands) const;
+
+    /** Returns the key of the random streams of an instance. **/
+    static uint64_t getInstanceKey(const Topology topology, const int nbNodes, const int nbDemands = 0);
+    /** Returns an integer drawn uniformly in [min, max]. **/
+    static int getUniformInt(Random& random, const int min, const int max);
+    /** Returns the Euclidean distance between two points. **/
+    static double getDistance(const Point& a, const Point& b) { return std::hypot(a.x - b.x, a.y - b.y); }
+    /** Splits a comma-separated list. **/
+    static std::vector<std::string> splitList(const std::string& list);
+    /** Creates a directory and its parents. Returns false on failure. **/
+    static bool makeDirectory(const std::string& path);
+};
+
+#endif
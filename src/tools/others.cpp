@@ -1,4 +1,11 @@
 #include "others.hpp"
+
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
 /* Writes a greeting message. */
 void greetingMessage(){
     std::cout << "=================================================================" << std::endl;
@@ -10,7 +17,10 @@ void greetingMessage(){
 std::string getParameter(int argc, char *argv[]){
     std::string param;
     if (argc != 2){
-		std::cerr << "A parameter file is required in the arguments. Please run the program in the following way: \n ./exec parameterFile.txt\n";
+		std::cerr << "A parameter file is required in the arguments. Please run the program in the following way: \n ./exec parameterFile.txt\n"
+		          << "or, for solving many parameter files: \n ./exec --batch <manifest file or glob pattern> [number of concurrent jobs]\n"
+		          << "or, for running a benchmark matrix against its baseline: \n ./exec --benchmark <matrix file> [number of concurrent runs]\n"
+		          << "or, for generating synthetic instances: \n ./exec --generate <specification file>\n";
 		throw std::invalid_argument( "@racolares: An argument is missing." );
 	}
 	else{
@@ -20,6 +30,34 @@ std::string getParameter(int argc, char *argv[]){
     return param;
 }
 
+/* Appends a text to a file in a single write. */
+bool appendToFile(const std::string& filename, const std::string& text, const std::string& header){
+    /* O_APPEND makes each write atomic with respect to other processes; the locks cover short writes and the header check. */
+    static std::mutex append_flag;
+    std::lock_guard<std::mutex> lock(append_flag);
+    const int fd = open(filename.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0){
+        return false;
+    }
+    flock(fd, LOCK_EX);
+    std::string record = text;
+    struct stat status;
+    if (!header.empty() && fstat(fd, &status) == 0 && status.st_size == 0){
+        record = header + text;
+    }
+    size_t written = 0;
+    while (written < record.size()){
+        const ssize_t n = write(fd, record.data() + written, record.size() - written);
+        if (n < 0){
+            close(fd);
+            return false;
+        }
+        written += (size_t)n;
+    }
+    /* Closing the file releases the lock. */
+    return (close(fd) == 0);
+}
+
 std::vector<int> getSortedIndexes_Asc(const std::vector<double> &vec){
     std::vector<int> sorted(vec.size());
     std::iota(sorted.begin(), sorted.end(), 0);
@@ -19,6 +19,9 @@ void        endingMessage();
 /** Returns the path to parameter file. **/
 std::string getParameter(int argc, char *argv[]);
 
+/** Appends a text to a file in a single write, so that concurrent runs never interleave their rows. Returns false if the file cannot be written. @param filename The file to append to, created if missing. @param text The text to append. @param header A text written before, only if the file is empty. **/
+bool        appendToFile(const std::string& filename, const std::string& text, const std::string& header = "");
+
 /** Returns the indexes of a given vector sorted in ascending order of the vector values. @param vec The vector to be sorted. @note Ex.: [7,3,5] => [1,2,0] **/
 std::vector<int> getSortedIndexes_Asc(const std::vector<double> &vec);
 
@@ -0,0 +1,148 @@
+#include "profiler.hpp"
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+/****************************************************************************************/
+/*										Phases											*/
+/****************************************************************************************/
+
+/* Registers the phase and samples its start. */
+void Profiler::Phase::begin(Profiler& profiler_, const char* name, const bool concurrent_)
+{
+    profiler = &profiler_;
+    concurrent = concurrent_;
+    rssStart = (concurrent ? 0 : getCurrentRss());
+
+    std::lock_guard<std::mutex> lock(profiler->flag);
+    std::map<std::string, int>::iterator it = profiler->index.find(name);
+    if (it == profiler->index.end()){
+        Record record;
+        record.name = name;
+        record.depth = profiler->depth;
+        record.calls = 0;
+        record.time = 0.0;
+        record.rssDelta = 0;
+        record.rss = 0;
+        id = (int)profiler->records.size();
+        profiler->index[name] = id;
+        profiler->records.push_back(record);
+    }
+    else{
+        id = it->second;
+    }
+    if (!concurrent){
+        profiler->depth++;
+    }
+    start = std::chrono::steady_clock::now();
+}
+
+/* Samples the phase end and accumulates its measures. */
+void Profiler::Phase::end()
+{
+    const double TIME = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const long RSS = (concurrent ? 0 : getCurrentRss());
+
+    std::lock_guard<std::mutex> lock(profiler->flag);
+    Record& record = profiler->records[id];
+    record.calls++;
+    record.time += TIME;
+    if (!concurrent){
+        record.rssDelta += RSS - rssStart;
+        record.rss = RSS;
+        profiler->depth--;
+    }
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the total time of each phase. */
+std::map<std::string, double> Profiler::getTimes()
+{
+    std::lock_guard<std::mutex> lock(flag);
+    std::map<std::string, double> times;
+    for (unsigned int j = 0; j < records.size(); j++){
+        times[records[j].name] = records[j].time;
+    }
+    return times;
+}
+
+/* Returns the total resident set size growth of each sequential phase. */
+std::map<std::string, double> Profiler::getRssDeltas()
+{
+    std::lock_guard<std::mutex> lock(flag);
+    std::map<std::string, double> deltas;
+    for (unsigned int j = 0; j < records.size(); j++){
+        if (records[j].rss > 0){
+            deltas[records[j].name] = (double)records[j].rssDelta;
+        }
+    }
+    return deltas;
+}
+
+/* Returns the current resident set size of the process, read from /proc/self/statm. */
+long Profiler::getCurrentRss()
+{
+    long pages = 0;
+    long resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm == NULL){
+        return 0;
+    }
+    if (fscanf(statm, "%ld %ld", &pages, &resident) != 2){
+        resident = 0;
+    }
+    fclose(statm);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Appends the records of another profiler. */
+void Profiler::merge(Profiler& other)
+{
+    if (!enabled) return;
+    std::lock(flag, other.flag);
+    std::lock_guard<std::mutex> lock(flag, std::adopt_lock);
+    std::lock_guard<std::mutex> otherLock(other.flag, std::adopt_lock);
+    for (unsigned int j = 0; j < other.records.size(); j++){
+        if (index.find(other.records[j].name) != index.end()) continue;
+        index[other.records[j].name] = (int)records.size();
+        records.push_back(other.records[j]);
+    }
+}
+
+/* Displays the phase table. The table is formatted apart, so that concurrent batch jobs do not share stream flags. */
+void Profiler::print()
+{
+    if (!enabled) return;
+    std::ostringstream table;
+    table << std::endl;
+    table << "=================================================================" << std::endl;
+    table << "-                    Printing phase profile.                    -" << std::endl;
+    table << "=================================================================" << std::endl;
+    table << "\t " << std::left << std::setw(40) << "Phase" << std::right
+          << std::setw(10) << "Calls" << std::setw(12) << "Time (s)"
+          << std::setw(14) << "dRSS (kB)" << std::setw(12) << "RSS (kB)" << std::endl;
+    table << std::fixed << std::setprecision(4);
+    flag.lock();
+    for (unsigned int j = 0; j < records.size(); j++){
+        const Record& record = records[j];
+        table << "\t " << std::left << std::setw(40) << (std::string(2*record.depth, ' ') + record.name) << std::right
+              << std::setw(10) << record.calls << std::setw(12) << record.time;
+        if (record.rss > 0){
+            table << std::setw(14) << record.rssDelta << std::setw(12) << record.rss << std::endl;
+        }
+        else{
+            table << std::setw(14) << "-" << std::setw(12) << "-" << std::endl;
+        }
+    }
+    flag.unlock();
+    std::cout << table.str() << std::endl;
+}
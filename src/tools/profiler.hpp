@@ -0,0 +1,106 @@
+#ifndef __profiler__hpp
+#define __profiler__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+
+/************************************************************************************
+ * This class records the time and memory spent by the phases of a run: reading
+ * the instance, building the graph, setting each family of variables and
+ * constraints, solving, separating. A phase is timed by a scoped Phase object;
+ * phases nested in one another are displayed indented. Sequential phases also
+ * sample the resident set size at their start and end. Concurrent phases, such
+ * as callback invocations, are only timed and counted. When profiling is
+ * disabled (profile=0), a Phase costs a single test.
+ ************************************************************************************/
+class Profiler {
+
+private:
+    /** The accumulated measures of a phase. **/
+    struct Record {
+        std::string name;       /**< The phase name. **/
+        int         depth;      /**< The nesting depth of the phase when first entered. **/
+        long        calls;      /**< Number of times the phase was entered. **/
+        double      time;       /**< Total time spent in the phase, in seconds. **/
+        long        rssDelta;   /**< Total growth of the resident set size within the phase, in kilobytes. **/
+        long        rss;        /**< Resident set size at the last exit of the phase, in kilobytes. **/
+    };
+
+    const bool              enabled;    /**< True if phases are recorded. **/
+    std::vector<Record>     records;    /**< The phases, in order of first entry. **/
+    std::map<std::string, int> index;   /**< The position of each phase in records. **/
+    int                     depth;      /**< Number of sequential phases currently entered. **/
+    std::mutex              flag;       /**< Protects the records against concurrent phases. **/
+
+public:
+    /** A scoped phase: measures from its construction to its destruction. **/
+    class Phase {
+    private:
+        Profiler*                               profiler;   /**< The profiler, or NULL if profiling is disabled. **/
+        int                                     id;         /**< The position of the phase in the records. **/
+        bool                                    concurrent; /**< True if the phase may run on several threads at once. **/
+        long                                    rssStart;   /**< Resident set size at the phase start. **/
+        std::chrono::steady_clock::time_point   start;      /**< Time at the phase start. **/
+
+    public:
+        /** Starts a phase. @param concurrent True if the phase may run on several threads at once; it is then neither nested nor memory sampled. **/
+        Phase(Profiler& profiler_, const char* name, const bool concurrent_ = false) : profiler(NULL) {
+            if (profiler_.enabled) begin(profiler_, name, concurrent_);
+        }
+        /** Ends the phase. **/
+        ~Phase() { if (profiler != NULL) end(); }
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        /** Registers the phase and samples its start. **/
+        void begin(Profiler& profiler_, const char* name, const bool concurrent_);
+        /** Samples the phase end and accumulates its measures. **/
+        void end();
+    };
+
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param enabled_ True if phases are recorded. **/
+    Profiler(const bool enabled_) : enabled(enabled_), depth(0) {}
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+    /** Returns true if phases are recorded. **/
+    bool isEnabled() const { return enabled; }
+
+    /** Returns the total time of each phase, in seconds. **/
+    std::map<std::string, double> getTimes();
+    /** Returns the total resident set size growth of each sequential phase, in kilobytes. **/
+    std::map<std::string, double> getRssDeltas();
+
+    /** Returns the current resident set size of the process, in kilobytes. **/
+    static long getCurrentRss();
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Appends the records of another profiler, such as the parsing of a shared instance. **/
+    void merge(Profiler& other);
+
+    /** Displays the phase table. Does nothing if profiling is disabled. **/
+    void print();
+};
+
+#endif
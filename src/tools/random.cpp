@@ -0,0 +1,60 @@
+#include "random.hpp"
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+/* Constructor. */
+Random::Random(const uint64_t seed, const uint32_t call, const uint64_t node) : position(4)
+{
+    key[0]      = (uint32_t)(seed);
+    key[1]      = (uint32_t)(seed >> 32);
+    counter[0]  = 0;
+    counter[1]  = call;
+    counter[2]  = (uint32_t)(node);
+    counter[3]  = (uint32_t)(node >> 32);
+}
+
+/* Generates the block of the current counter and increments it. */
+void Random::nextBlock()
+{
+    uint32_t ctr[4] = {counter[0], counter[1], counter[2], counter[3]};
+    uint32_t k[2]   = {key[0], key[1]};
+    for (int r = 0; r < PHILOX_ROUNDS; r++){
+        const uint64_t P0 = (uint64_t)PHILOX_M0 * ctr[0];
+        const uint64_t P1 = (uint64_t)PHILOX_M1 * ctr[2];
+        const uint32_t NEXT[4] = {(uint32_t)(P1 >> 32) ^ ctr[1] ^ k[0], (uint32_t)P1,
+                                  (uint32_t)(P0 >> 32) ^ ctr[3] ^ k[1], (uint32_t)P0};
+        ctr[0] = NEXT[0]; ctr[1] = NEXT[1]; ctr[2] = NEXT[2]; ctr[3] = NEXT[3];
+        k[0] += PHILOX_W0;
+        k[1] += PHILOX_W1;
+    }
+    block[0] = ctr[0]; block[1] = ctr[1]; block[2] = ctr[2]; block[3] = ctr[3];
+    counter[0]++;
+    position = 0;
+}
+
+/* Fills a vector with random values uniformly distributed in [0,1). */
+void Random::uniform(std::vector<double>& values)
+{
+    const double SCALE = 1.0 / 4294967296.0;
+    unsigned int j = 0;
+    /* Use what remains of the current block first. */
+    while (j < values.size() && position < 4){
+        values[j++] = block[position++] * SCALE;
+    }
+    while (j + 4 <= values.size()){
+        nextBlock();
+        values[j]   = block[0] * SCALE;
+        values[j+1] = block[1] * SCALE;
+        values[j+2] = block[2] * SCALE;
+        values[j+3] = block[3] * SCALE;
+        position = 4;
+        j += 4;
+    }
+    while (j < values.size()){
+        values[j++] = uniform();
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef __random__hpp
+#define __random__hpp
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/************************************************************************************
+ * This class implements the Philox4x32-10 counter-based random number generator.
+ * A stream is identified by a seed (the key) and by two stream indexes (the
+ * upper words of the counter), e.g., a call number and a node id, so that no
+ * state needs to be shared between threads.
+ * It satisfies the UniformRandomBitGenerator requirements.
+ ************************************************************************************/
+class Random {
+
+public:
+    typedef uint32_t result_type;
+
+private:
+    uint32_t key[2];        /**< The key, built from the seed. **/
+    uint32_t counter[4];    /**< The counter: block index, call number and node id. **/
+    uint32_t block[4];      /**< The last generated block of 4 values. **/
+    int      position;      /**< The position of the next value to be returned in block. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. @param seed The run seed. @param call The call number, or any other stream index such as a worker id. @param node The node id. **/
+    Random(const uint64_t seed, const uint32_t call = 0, const uint64_t node = 0);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Returns the smallest value that can be generated. **/
+    static constexpr result_type min() { return 0; }
+    /** Returns the largest value that can be generated. **/
+    static constexpr result_type max() { return std::numeric_limits<uint32_t>::max(); }
+
+    /** Returns the next 32-bit random value. **/
+    result_type operator()() {
+        if (position == 4) nextBlock();
+        return block[position++];
+    }
+
+    /** Returns a random value uniformly distributed in [0,1). **/
+    double uniform() { return (*this)() * (1.0 / 4294967296.0); }
+
+    /** Fills a vector with random values uniformly distributed in [0,1). Values are generated 4 at a time. @param values The vector to be filled. **/
+    void uniform(std::vector<double>& values);
+
+private:
+    /** Generates the block of the current counter and increments it. **/
+    void nextBlock();
+};
+
+#endif
@@ -15,8 +15,7 @@ std::vector<std::vector<std::string> > Reader::getData()
 		file.close();
 	}
 	else {
-		std::cerr << "ERROR: Unable to open file " << filename << "." << std::endl;
-		exit(EXIT_FAILURE);
+		throw std::runtime_error("ERROR: Unable to open file " + filename + ".");
 	}
 	return dataList;
 }
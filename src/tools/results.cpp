@@ -0,0 +1,285 @@
+#include "results.hpp"
+
+#include <sys/resource.h>
+
+#define PRECISION_DIGITS 12     // Significant digits of real values in csv and jsonl records
+
+/* Returns a JSON string, escaping quotes, backslashes and control characters. */
+static std::string toJsonString(const std::string& text)
+{
+    std::string escaped = "\"";
+    for (unsigned int c = 0; c < text.size(); c++){
+        const char CHAR = text[c];
+        if (CHAR == '"' || CHAR == '\\'){
+            escaped += '\\';
+            escaped += CHAR;
+        }
+        else if ((unsigned char)CHAR < 0x20){
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", CHAR);
+            escaped += code;
+        }
+        else{
+            escaped += CHAR;
+        }
+    }
+    return escaped + "\"";
+}
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+/* Constructor. Adds the schema version, the time stamp, the method and the instance files. */
+Results::Results(const Data& data_, const std::string& method) : data(data_)
+{
+    char stamp[32];
+    const std::time_t NOW = std::time(NULL);
+    std::tm utc;
+    gmtime_r(&NOW, &utc);
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+    add("schema_version", SCHEMA_VERSION);
+    add("timestamp", std::string(stamp));
+    add("parameter_file", data.getInput().getParameterFile());
+    add("method", method);
+    add("link_file", data.getInput().getLinkFile(), true);
+    add("node_file", data.getInput().getNodeFile(), true);
+    add("demand_file", data.getInput().getDemandFile(), true);
+    add("vnf_file", data.getInput().getVnfFile(), true);
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Adds a text field. */
+void Results::add(const std::string& key, const std::string& value, const bool legacy)
+{
+    Field field;
+    field.key = key;
+    field.type = TYPE_TEXT;
+    field.text = value;
+    field.legacy = legacy;
+    fields.push_back(field);
+}
+
+/* Adds an integer field. */
+void Results::add(const std::string& key, const long value, const bool legacy)
+{
+    Field field;
+    field.key = key;
+    field.type = TYPE_INT;
+    field.integer = value;
+    field.legacy = legacy;
+    fields.push_back(field);
+}
+
+/* Adds a real field. */
+void Results::add(const std::string& key, const double value, const bool legacy)
+{
+    Field field;
+    field.key = key;
+    field.type = TYPE_REAL;
+    field.real = value;
+    field.legacy = legacy;
+    fields.push_back(field);
+}
+
+/* Adds a counts field. */
+void Results::add(const std::string& key, const std::map<std::string, int>& value)
+{
+    Field field;
+    field.key = key;
+    field.type = TYPE_COUNTS;
+    field.counts = value;
+    field.legacy = false;
+    fields.push_back(field);
+}
+
+/* Adds a reals field. */
+void Results::add(const std::string& key, const std::map<std::string, double>& value)
+{
+    Field field;
+    field.key = key;
+    field.type = TYPE_REALS;
+    field.reals = value;
+    field.legacy = false;
+    fields.push_back(field);
+}
+
+/* Adds the thread count, the peak memory, the phase profile and the parameter toggles. */
+void Results::addRunInformation()
+{
+    const Input& input = data.getInput();
+    add("threads", input.getThreads());
+    add("peak_rss_kb", getPeakRss());
+    add("phase_time", data.getProfiler().getTimes());
+    add("phase_rss_kb", data.getProfiler().getRssDeltas());
+    add("time_limit", input.getTimeLimit());
+    add("random_seed", input.getRandomSeed());
+    add("disaggregated_vnf_placement", (int)input.getDisaggregatedVnfPlacement());
+    add("strong_node_capacity", (int)input.getStrongNodeCapacity());
+    add("lazy", (int)input.getLazy());
+    add("heuristic", (int)input.getHeuristic());
+    add("availability_cuts", (int)input.getAvailabilityUsercuts());
+    add("node_cover", (int)input.getNodeCover());
+    add("chain_cover", (int)input.getChainCover());
+    add("vnf_lower_bound", (int)input.getVnfLowerBoundCuts());
+    add("section_failure", (int)input.getSectionFailureCuts());
+    add("routing", (int)input.getRoutingActivation());
+    add("availability_approx", (int)input.getApproximationType());
+    add("nb_breakpoints", input.getNbBreakpoints());
+    add("pwl_encoding", (int)input.getPwlEncoding());
+    add("lifting_variants", input.getNbLiftingVariants());
+    add("exact_check", (int)input.isExactCheck());
+    add("greedy_start", (int)input.isGreedyStart());
+    add("symmetry_breaking", (int)input.getSymmetryBreaking());
+    add("presolve", (int)input.isPresolve());
+    add("benders", (int)input.isBenders());
+    add("backend", input.getBackend());
+}
+
+/* Appends the record to the output file. */
+void Results::write()
+{
+    std::cout << "Writting results to file..." << std::endl;
+    const std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        std::cout << "Warning: There is no output file." << std::endl;
+        return;
+    }
+    addRunInformation();
+
+    bool written = false;
+    switch (data.getInput().getOutputFormat()){
+        case Input::OUTPUT_FORMAT_CSV:      written = appendToFile(output_file, toCsv(), toCsvHeader());    break;
+        case Input::OUTPUT_FORMAT_JSONL:    written = appendToFile(output_file, toJson());                  break;
+        default:                            written = appendToFile(output_file, toLegacy());                break;
+    }
+    if (!written){
+        throw std::runtime_error("ERROR: Unable to access output file '" + output_file + "'.");
+    }
+}
+
+/* Returns the peak resident set size of the process, in kilobytes. */
+long Results::getPeakRss()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0){
+        return 0;
+    }
+    return (long)usage.ru_maxrss;
+}
+
+/****************************************************************************************/
+/*										Formats											*/
+/****************************************************************************************/
+
+/* Returns the legacy semicolon row. */
+std::string Results::toLegacy() const
+{
+    std::string row;
+    for (unsigned int j = 0; j < fields.size(); j++){
+        if (!fields[j].legacy) continue;
+        row += getValue(fields[j], 6) + ";";
+    }
+    return row + "\n";
+}
+
+/* Returns the csv header. */
+std::string Results::toCsvHeader() const
+{
+    std::string header;
+    for (unsigned int j = 0; j < fields.size(); j++){
+        header += (j > 0 ? "," : "") + fields[j].key;
+    }
+    return header + "\n";
+}
+
+/* Returns the csv row. Text values holding a separator or a quote are quoted. */
+std::string Results::toCsv() const
+{
+    std::string row;
+    for (unsigned int j = 0; j < fields.size(); j++){
+        std::string value = getValue(fields[j], PRECISION_DIGITS);
+        if (value.find_first_of(",\"\n") != std::string::npos){
+            std::string quoted = "\"";
+            for (unsigned int c = 0; c < value.size(); c++){
+                quoted += (value[c] == '"' ? "\"\"" : std::string(1, value[c]));
+            }
+            value = quoted + "\"";
+        }
+        row += (j > 0 ? "," : "") + value;
+    }
+    return row + "\n";
+}
+
+/* Returns the JSON object. */
+std::string Results::toJson() const
+{
+    std::string object = "{";
+    for (unsigned int j = 0; j < fields.size(); j++){
+        const Field& field = fields[j];
+        object += (j > 0 ? "," : "") + toJsonString(field.key) + ":";
+        switch (field.type){
+            case TYPE_TEXT:
+                object += toJsonString(field.text);
+                break;
+            case TYPE_COUNTS: {
+                object += "{";
+                for (std::map<std::string, int>::const_iterator it = field.counts.begin(); it != field.counts.end(); ++it){
+                    object += (it != field.counts.begin() ? "," : "") + toJsonString(it->first) + ":" + std::to_string(it->second);
+                }
+                object += "}";
+                break;
+            }
+            case TYPE_REALS: {
+                object += "{";
+                for (std::map<std::string, double>::const_iterator it = field.reals.begin(); it != field.reals.end(); ++it){
+                    std::ostringstream value;
+                    value << std::setprecision(PRECISION_DIGITS) << it->second;
+                    object += (it != field.reals.begin() ? "," : "") + toJsonString(it->first) + ":" + (std::isfinite(it->second) ? value.str() : "null");
+                }
+                object += "}";
+                break;
+            }
+            case TYPE_REAL:
+                /* JSON has no infinity nor NaN. */
+                object += (std::isfinite(field.real) ? getValue(field, PRECISION_DIGITS) : "null");
+                break;
+            default:
+                object += getValue(field, PRECISION_DIGITS);
+                break;
+        }
+    }
+    return object + "}\n";
+}
+
+/* Returns the value of a field, as written in a csv or legacy row. */
+std::string Results::getValue(const Field& field, const int precision) const
+{
+    std::ostringstream value;
+    switch (field.type){
+        case TYPE_TEXT:
+            value << field.text;
+            break;
+        case TYPE_INT:
+            value << field.integer;
+            break;
+        case TYPE_REAL:
+            value << std::setprecision(precision) << field.real;
+            break;
+        case TYPE_COUNTS:
+            for (std::map<std::string, int>::const_iterator it = field.counts.begin(); it != field.counts.end(); ++it){
+                value << (it != field.counts.begin() ? "|" : "") << it->first << "=" << it->second;
+            }
+            break;
+        case TYPE_REALS:
+            for (std::map<std::string, double>::const_iterator it = field.reals.begin(); it != field.reals.end(); ++it){
+                value << (it != field.reals.begin() ? "|" : "") << it->first << "=" << std::setprecision(precision) << it->second;
+            }
+            break;
+    }
+    return value.str();
+}
@@ -0,0 +1,106 @@
+#ifndef __results__hpp
+#define __results__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <ctime>
+#include <sstream>
+#include <iomanip>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+#include "others.hpp"
+
+
+/************************************************************************************
+ * This class writes the outcome of a run to the output file. A record is an
+ * ordered list of named fields, written in the format given by output_format=:
+ *  - legacy: the historical semicolon row, restricted to the legacy fields;
+ *  - csv: every field, with a header written when the file is created;
+ *  - jsonl: every field, one JSON object per line.
+ * Records carry the schema version, the run metadata (parameter file, time
+ * stamp, threads, peak memory, phase profile) and the parameter toggles, so that runs from
+ * different sweeps can be compared. Each record is appended by a single write.
+ ************************************************************************************/
+class Results {
+
+public:
+    /** Version of the field list. Increase it whenever fields are added, removed or renamed. **/
+    static const int SCHEMA_VERSION = 3;
+
+private:
+    /** The type of a field. **/
+    enum Type {
+        TYPE_TEXT   = 0,
+        TYPE_INT    = 1,
+        TYPE_REAL   = 2,
+        TYPE_COUNTS = 3,    /**< Counts by name, such as cuts per family. **/
+        TYPE_REALS  = 4     /**< Reals by name, such as time per phase. **/
+    };
+
+    /** A named value. **/
+    struct Field {
+        std::string                 key;        /**< The field name. **/
+        Type                        type;       /**< The field type. **/
+        std::string                 text;       /**< The value of a text field. **/
+        long                        integer;    /**< The value of an integer field. **/
+        double                      real;       /**< The value of a real field. **/
+        std::map<std::string, int>  counts;     /**< The value of a counts field. **/
+        std::map<std::string, double> reals;    /**< The value of a reals field. **/
+        bool                        legacy;     /**< True if the field belongs to the legacy row. **/
+    };
+
+    const Data&         data;       /**< Data read in data.hpp **/
+    std::vector<Field>  fields;     /**< The fields, in output order. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+    /** Constructor. Adds the schema version, the time stamp, the method and the instance files. @param data_ The instance data. @param method The method which produced the results (mip, colgen, ...). **/
+    Results(const Data& data_, const std::string& method);
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+    /** Adds a text field. @param legacy True if the field belongs to the legacy row. **/
+    void add(const std::string& key, const std::string& value, const bool legacy = false);
+    /** Adds an integer field. @param legacy True if the field belongs to the legacy row. **/
+    void add(const std::string& key, const long value, const bool legacy = false);
+    /** Adds an integer field. @param legacy True if the field belongs to the legacy row. **/
+    void add(const std::string& key, const int value, const bool legacy = false) { add(key, (long)value, legacy); }
+    /** Adds a real field. @param legacy True if the field belongs to the legacy row. **/
+    void add(const std::string& key, const double value, const bool legacy = false);
+    /** Adds a counts field, written as name=count pairs in csv and as an object in jsonl. **/
+    void add(const std::string& key, const std::map<std::string, int>& value);
+    /** Adds a reals field, written as name=value pairs in csv and as an object in jsonl. **/
+    void add(const std::string& key, const std::map<std::string, double>& value);
+
+    /** Adds the run metadata and toggles and appends the record to the output file. Throws a std::runtime_error if the file cannot be written. **/
+    void write();
+
+    /** Returns the peak resident set size of the process, in kilobytes. **/
+    static long getPeakRss();
+
+private:
+    /** Adds the thread count, the peak memory, the phase profile and the parameter toggles. **/
+    void addRunInformation();
+
+    /** Returns the legacy semicolon row. **/
+    std::string toLegacy() const;
+    /** Returns the csv header. **/
+    std::string toCsvHeader() const;
+    /** Returns the csv row. **/
+    std::string toCsv() const;
+    /** Returns the JSON object. **/
+    std::string toJson() const;
+
+    /** Returns the value of a field, as written in a csv or legacy row. **/
+    std::string getValue(const Field& field, const int precision) const;
+};
+
+#endif